@@ -444,6 +444,14 @@ typedef struct
   RexxArrayObject  additional;       // additional information
 } RexxCondition;
 
+
+typedef struct
+{
+  CSTRING          name;             // the element tail name
+  size_t           nameLength;       // length of the tail name
+  RexxObjectPtr    value;            // the element value
+} RexxStemElement;
+
 #define INSTANCE_INTERFACE_VERSION 100
 
 typedef struct
@@ -460,7 +468,10 @@ typedef struct
 
 #define THREAD_INTERFACE_VERSION_4_0_0 100
 #define THREAD_INTERFACE_VERSION_4_1_1 101
-#define THREAD_INTERFACE_VERSION 102
+#define THREAD_INTERFACE_VERSION_5_0_0 102
+#define THREAD_INTERFACE_VERSION_5_1_0 103     // bulk stem and array transfer
+#define THREAD_INTERFACE_VERSION_5_1_1 104     // object serialization
+#define THREAD_INTERFACE_VERSION 104
 
 BEGIN_EXTERN_C()
 
@@ -622,6 +633,20 @@ typedef struct
     size_t           (RexxEntry *MutableBufferCapacity)(RexxThreadContext *, RexxMutableBufferObject);
     POINTER          (RexxEntry *SetMutableBufferCapacity)(RexxThreadContext *, RexxMutableBufferObject, size_t);
 
+    void             (RexxEntry *SetStemElements)(RexxThreadContext *, RexxStemObject, CSTRING *, RexxObjectPtr *, size_t);
+    size_t           (RexxEntry *GetStemElements)(RexxThreadContext *, RexxStemObject, CSTRING *, RexxObjectPtr *, size_t);
+    void             (RexxEntry *SetStemArrayElements)(RexxThreadContext *, RexxStemObject, size_t, RexxObjectPtr *, size_t);
+    size_t           (RexxEntry *GetStemArrayElements)(RexxThreadContext *, RexxStemObject, size_t, RexxObjectPtr *, size_t);
+    size_t           (RexxEntry *GetStemElementSnapshot)(RexxThreadContext *, RexxStemObject, RexxStemElement *, size_t);
+    void             (RexxEntry *ArrayPutRange)(RexxThreadContext *, RexxArrayObject, size_t, RexxObjectPtr *, size_t);
+    size_t           (RexxEntry *ArrayAtRange)(RexxThreadContext *, RexxArrayObject, size_t, RexxObjectPtr *, size_t);
+    RexxArrayObject  (RexxEntry *NewStringArray)(RexxThreadContext *, CSTRING, const size_t *, size_t);
+
+    RexxBufferObject (RexxEntry *SerializeObject)(RexxThreadContext *, RexxObjectPtr);
+    RexxObjectPtr    (RexxEntry *DeserializeObject)(RexxThreadContext *, RexxPackageObject, CSTRING, size_t);
+    logical_t        (RexxEntry *SerializeObjectToFile)(RexxThreadContext *, RexxObjectPtr, CSTRING);
+    RexxObjectPtr    (RexxEntry *DeserializeObjectFromFile)(RexxThreadContext *, RexxPackageObject, CSTRING);
+
 } RexxThreadInterface;
 
 
@@ -1283,6 +1308,66 @@ struct RexxThreadContext_
         return functions->SetMutableBufferCapacity(this, bo, l);
     }
 
+    void SetStemElements(RexxStemObject so, CSTRING *t, RexxObjectPtr *o, size_t n)
+    {
+        functions->SetStemElements(this, so, t, o, n);
+    }
+
+    size_t GetStemElements(RexxStemObject so, CSTRING *t, RexxObjectPtr *o, size_t n)
+    {
+        return functions->GetStemElements(this, so, t, o, n);
+    }
+
+    void SetStemArrayElements(RexxStemObject so, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        functions->SetStemArrayElements(this, so, s, o, n);
+    }
+
+    size_t GetStemArrayElements(RexxStemObject so, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        return functions->GetStemArrayElements(this, so, s, o, n);
+    }
+
+    size_t GetStemElementSnapshot(RexxStemObject so, RexxStemElement *e, size_t n)
+    {
+        return functions->GetStemElementSnapshot(this, so, e, n);
+    }
+
+    void ArrayPutRange(RexxArrayObject ao, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        functions->ArrayPutRange(this, ao, s, o, n);
+    }
+
+    size_t ArrayAtRange(RexxArrayObject ao, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        return functions->ArrayAtRange(this, ao, s, o, n);
+    }
+
+    RexxArrayObject NewStringArray(CSTRING b, const size_t *offsets, size_t n)
+    {
+        return functions->NewStringArray(this, b, offsets, n);
+    }
+
+    RexxBufferObject SerializeObject(RexxObjectPtr o)
+    {
+        return functions->SerializeObject(this, o);
+    }
+
+    RexxObjectPtr DeserializeObject(RexxPackageObject p, CSTRING d, size_t l)
+    {
+        return functions->DeserializeObject(this, p, d, l);
+    }
+
+    logical_t SerializeObjectToFile(RexxObjectPtr o, CSTRING n)
+    {
+        return functions->SerializeObjectToFile(this, o, n);
+    }
+
+    RexxObjectPtr DeserializeObjectFromFile(RexxPackageObject p, CSTRING n)
+    {
+        return functions->DeserializeObjectFromFile(this, p, n);
+    }
+
     POINTER PointerValue(RexxPointerObject po)
     {
         return functions->PointerValue(this, po);
@@ -1971,6 +2056,66 @@ struct RexxMethodContext_
         return threadContext->SetMutableBufferCapacity(bo, l);
     }
 
+    void SetStemElements(RexxStemObject so, CSTRING *t, RexxObjectPtr *o, size_t n)
+    {
+        threadContext->SetStemElements(so, t, o, n);
+    }
+
+    size_t GetStemElements(RexxStemObject so, CSTRING *t, RexxObjectPtr *o, size_t n)
+    {
+        return threadContext->GetStemElements(so, t, o, n);
+    }
+
+    void SetStemArrayElements(RexxStemObject so, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        threadContext->SetStemArrayElements(so, s, o, n);
+    }
+
+    size_t GetStemArrayElements(RexxStemObject so, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        return threadContext->GetStemArrayElements(so, s, o, n);
+    }
+
+    size_t GetStemElementSnapshot(RexxStemObject so, RexxStemElement *e, size_t n)
+    {
+        return threadContext->GetStemElementSnapshot(so, e, n);
+    }
+
+    void ArrayPutRange(RexxArrayObject ao, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        threadContext->ArrayPutRange(ao, s, o, n);
+    }
+
+    size_t ArrayAtRange(RexxArrayObject ao, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        return threadContext->ArrayAtRange(ao, s, o, n);
+    }
+
+    RexxArrayObject NewStringArray(CSTRING b, const size_t *offsets, size_t n)
+    {
+        return threadContext->NewStringArray(b, offsets, n);
+    }
+
+    RexxBufferObject SerializeObject(RexxObjectPtr o)
+    {
+        return threadContext->SerializeObject(o);
+    }
+
+    RexxObjectPtr DeserializeObject(RexxPackageObject p, CSTRING d, size_t l)
+    {
+        return threadContext->DeserializeObject(p, d, l);
+    }
+
+    logical_t SerializeObjectToFile(RexxObjectPtr o, CSTRING n)
+    {
+        return threadContext->SerializeObjectToFile(o, n);
+    }
+
+    RexxObjectPtr DeserializeObjectFromFile(RexxPackageObject p, CSTRING n)
+    {
+        return threadContext->DeserializeObjectFromFile(p, n);
+    }
+
     POINTER PointerValue(RexxPointerObject po)
     {
         return threadContext->PointerValue(po);
@@ -2733,6 +2878,66 @@ struct RexxCallContext_
         return threadContext->SetMutableBufferCapacity(bo, l);
     }
 
+    void SetStemElements(RexxStemObject so, CSTRING *t, RexxObjectPtr *o, size_t n)
+    {
+        threadContext->SetStemElements(so, t, o, n);
+    }
+
+    size_t GetStemElements(RexxStemObject so, CSTRING *t, RexxObjectPtr *o, size_t n)
+    {
+        return threadContext->GetStemElements(so, t, o, n);
+    }
+
+    void SetStemArrayElements(RexxStemObject so, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        threadContext->SetStemArrayElements(so, s, o, n);
+    }
+
+    size_t GetStemArrayElements(RexxStemObject so, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        return threadContext->GetStemArrayElements(so, s, o, n);
+    }
+
+    size_t GetStemElementSnapshot(RexxStemObject so, RexxStemElement *e, size_t n)
+    {
+        return threadContext->GetStemElementSnapshot(so, e, n);
+    }
+
+    void ArrayPutRange(RexxArrayObject ao, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        threadContext->ArrayPutRange(ao, s, o, n);
+    }
+
+    size_t ArrayAtRange(RexxArrayObject ao, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        return threadContext->ArrayAtRange(ao, s, o, n);
+    }
+
+    RexxArrayObject NewStringArray(CSTRING b, const size_t *offsets, size_t n)
+    {
+        return threadContext->NewStringArray(b, offsets, n);
+    }
+
+    RexxBufferObject SerializeObject(RexxObjectPtr o)
+    {
+        return threadContext->SerializeObject(o);
+    }
+
+    RexxObjectPtr DeserializeObject(RexxPackageObject p, CSTRING d, size_t l)
+    {
+        return threadContext->DeserializeObject(p, d, l);
+    }
+
+    logical_t SerializeObjectToFile(RexxObjectPtr o, CSTRING n)
+    {
+        return threadContext->SerializeObjectToFile(o, n);
+    }
+
+    RexxObjectPtr DeserializeObjectFromFile(RexxPackageObject p, CSTRING n)
+    {
+        return threadContext->DeserializeObjectFromFile(p, n);
+    }
+
     POINTER PointerValue(RexxPointerObject po)
     {
         return threadContext->PointerValue(po);
@@ -3485,6 +3690,66 @@ struct RexxExitContext_
         return threadContext->SetMutableBufferCapacity(bo, l);
     }
 
+    void SetStemElements(RexxStemObject so, CSTRING *t, RexxObjectPtr *o, size_t n)
+    {
+        threadContext->SetStemElements(so, t, o, n);
+    }
+
+    size_t GetStemElements(RexxStemObject so, CSTRING *t, RexxObjectPtr *o, size_t n)
+    {
+        return threadContext->GetStemElements(so, t, o, n);
+    }
+
+    void SetStemArrayElements(RexxStemObject so, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        threadContext->SetStemArrayElements(so, s, o, n);
+    }
+
+    size_t GetStemArrayElements(RexxStemObject so, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        return threadContext->GetStemArrayElements(so, s, o, n);
+    }
+
+    size_t GetStemElementSnapshot(RexxStemObject so, RexxStemElement *e, size_t n)
+    {
+        return threadContext->GetStemElementSnapshot(so, e, n);
+    }
+
+    void ArrayPutRange(RexxArrayObject ao, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        threadContext->ArrayPutRange(ao, s, o, n);
+    }
+
+    size_t ArrayAtRange(RexxArrayObject ao, size_t s, RexxObjectPtr *o, size_t n)
+    {
+        return threadContext->ArrayAtRange(ao, s, o, n);
+    }
+
+    RexxArrayObject NewStringArray(CSTRING b, const size_t *offsets, size_t n)
+    {
+        return threadContext->NewStringArray(b, offsets, n);
+    }
+
+    RexxBufferObject SerializeObject(RexxObjectPtr o)
+    {
+        return threadContext->SerializeObject(o);
+    }
+
+    RexxObjectPtr DeserializeObject(RexxPackageObject p, CSTRING d, size_t l)
+    {
+        return threadContext->DeserializeObject(p, d, l);
+    }
+
+    logical_t SerializeObjectToFile(RexxObjectPtr o, CSTRING n)
+    {
+        return threadContext->SerializeObjectToFile(o, n);
+    }
+
+    RexxObjectPtr DeserializeObjectFromFile(RexxPackageObject p, CSTRING n)
+    {
+        return threadContext->DeserializeObjectFromFile(p, n);
+    }
+
     POINTER PointerValue(RexxPointerObject po)
     {
         return threadContext->PointerValue(po);
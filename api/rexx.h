@@ -311,6 +311,17 @@ typedef RexxReturnCode (REXXENTRY *PFNREXXTRANSLATEPROGRAM)(CONSTANT_STRING, CON
 #define REXXTRANSLATEPROGRAM RexxTranslateProgram
 
 
+RexxReturnCode REXXENTRY RexxTranslateBundledProgram(
+    CONSTANT_STRING,                    // input program name
+    CONSTANT_STRING,                    // output file name
+    PRXSYSEXIT);                        // system exits to use during translation
+
+
+typedef RexxReturnCode (REXXENTRY *PFNREXXTRANSLATEBUNDLEDPROGRAM)(CONSTANT_STRING, CONSTANT_STRING, PRXSYSEXIT);
+
+#define REXXTRANSLATEBUNDLEDPROGRAM RexxTranslateBundledProgram
+
+
 RexxReturnCode REXXENTRY RexxTranslateInstoreProgram(
     CONSTANT_STRING,                    // input program name
     CONSTANT_RXSTRING *,                // program source
@@ -833,6 +844,23 @@ RexxReturnCode REXXENTRY RexxPullFromQueue (
 typedef RexxReturnCode (REXXENTRY *PFNREXXPULLFROMQUEUE)(CONSTANT_STRING, PRXSTRING, RexxQueueTime *,
                                            size_t);
 
+/***    RexxAddQueueLines - Add a batch of entries to an External Data Queue */
+
+RexxReturnCode REXXENTRY RexxAddQueueLines (
+        CONSTANT_STRING,                       /* Name of queue to add to     */
+        PCONSTRXSTRING,                        /* Array of strings to add     */
+        size_t,                                /* Count of strings            */
+        size_t);                               /* Queue type (FIFO|LIFO)      */
+typedef RexxReturnCode (REXXENTRY *PFNREXXADDQUEUELINES)(CONSTANT_STRING, PCONSTRXSTRING, size_t, size_t);
+
+/***    RexxPullQueueLines - Retrieve a block of entries from an External Data Queue */
+RexxReturnCode REXXENTRY RexxPullQueueLines (
+        CONSTANT_STRING,                       /* Name of queue to read from  */
+        PRXSTRING,                             /* Array to receive the data   */
+        size_t,                                /* Size of the array           */
+        size_t *);                             /* Count of entries returned   */
+typedef RexxReturnCode (REXXENTRY *PFNREXXPULLQUEUELINES)(CONSTANT_STRING, PRXSTRING, size_t, size_t *);
+
 /***    RexxClearQueue - Clear all lines in a queue */
 
 RexxReturnCode REXXENTRY RexxClearQueue (
@@ -100,6 +100,7 @@ SysFile::SysFile()
     filePointer = 0;
     ungetchar = -1;
     writeBuffered = false;     // no pending write operations
+    writer = NULL;
 }
 
 /**
@@ -204,6 +205,7 @@ void SysFile::reset()
 {
     // make sure we flush anything pending.
     flush();
+    stopWriter();
     if (buffer != NULL)
     {
         free(buffer);
@@ -248,6 +250,78 @@ void SysFile::setBuffering(bool buffering, size_t length)
 }
 
 
+/**
+ * Turn write-behind mode on or off.  In write-behind mode, full
+ * output buffers are handed to a background thread, so writing
+ * to a slow device does not hold up the caller.  A flush or
+ * close waits for all of the pending data to be written.
+ *
+ * @param writeBehind
+ *               True to enable write-behind, false to go back to
+ *               synchronous writes.
+ *
+ * @return true if the requested mode is in effect.  Unbuffered
+ *         streams cannot use write-behind.
+ */
+bool SysFile::setWriteBehind(bool writeBehind)
+{
+    // make sure anything already buffered goes out in the current mode
+    flush();
+    stopWriter();
+
+    if (!writeBehind)
+    {
+        return true;
+    }
+
+    // this needs a buffer to collect the data in
+    if (!buffered || fileHandle == -1)
+    {
+        return false;
+    }
+
+    // switch to a buffer the same size as the writer buffers, keeping
+    // the current position
+    int64_t position = 0;
+    getPosition(position);
+    setBuffering(false, 0);
+    setBuffering(true, WRITE_BEHIND_BUFFER_SIZE);
+    if (!buffered)
+    {
+        return false;
+    }
+    bufferSize = WRITE_BEHIND_BUFFER_SIZE;
+    if (!transient)
+    {
+        lseek64(fileHandle, position, SEEK_SET);
+    }
+    filePointer = position;
+
+    writer = new SysFileWriter(fileHandle, WRITE_BEHIND_BUFFER_SIZE);
+    if (!writer->start())
+    {
+        delete writer;
+        writer = NULL;
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * Shut down the write-behind thread, if there is one.
+ */
+void SysFile::stopWriter()
+{
+    if (writer != NULL)
+    {
+        writer->stop();
+        delete writer;
+        writer = NULL;
+    }
+}
+
+
 /**
  * Close the stream, and free all associated resources.
  *
@@ -261,11 +335,16 @@ bool SysFile::close()
         return true;
     }
 
-    // if we're buffering, make sure the buffers are flushed
+    // if we're buffering, make sure the buffers are flushed.  For a
+    // write-behind stream this waits for the writer to finish, which is
+    // the last chance to report a write error.
+    bool flushed = true;
     if (buffered)
     {
-        flush();
+        flushed = flush();
     }
+    int flushError = errInfo;
+    stopWriter();
     // free out storage areas first
     if (filename != NULL)
     {
@@ -292,6 +371,11 @@ bool SysFile::close()
     // always clear this on a close
     fileHandle = -1;
 
+    if (!flushed)
+    {
+        errInfo = flushError;
+        return false;
+    }
     return true;
 }
 
@@ -305,7 +389,45 @@ bool SysFile::flush()
     if (buffered)
     {
         // do we have data in a write buffer?
-        if (writeBuffered && bufferPosition > 0)
+        if (!writeBuffer())
+        {
+            return false;
+        }
+        // for write-behind, wait for everything queued to be written
+        if (writer != NULL && !writer->drain())
+        {
+            errInfo = writer->getError();
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * Write out any data in the output buffer.  For a write-behind
+ * stream, the data is queued for the writer thread rather than
+ * written directly.
+ *
+ * @return True if this worked without error, false otherwise.
+ */
+bool SysFile::writeBuffer()
+{
+    // do we have data in a write buffer?
+    if (writeBuffered && bufferPosition > 0)
+    {
+        if (writer != NULL)
+        {
+            // this will fail if an earlier queued write failed
+            if (!writer->queue(buffer, bufferPosition))
+            {
+                errInfo = writer->getError();
+                return false;
+            }
+            // the data is as good as written as far as positioning goes
+            filePointer += bufferPosition;
+        }
+        else
         {
             // write this out...but if it fails, we need to bail
             int written = ::write(fileHandle, buffer, (unsigned int)bufferPosition);
@@ -317,10 +439,10 @@ bool SysFile::flush()
             }
             // update the real output position
             filePointer += written;
-            // and invalidate the buffer
-            bufferPosition = 0;
-            bufferedInput = 0;
         }
+        // and invalidate the buffer
+        bufferPosition = 0;
+        bufferedInput = 0;
     }
     return true;
 }
@@ -469,22 +591,40 @@ bool SysFile::write(const char *data, size_t len, size_t &bytesWritten)
     // are we buffering?
     if (buffered)
     {
+        // a write-behind failure fails every later write until the stream
+        // is closed or write-behind is turned off
+        if (writer != NULL && writer->error())
+        {
+            errInfo = writer->getError();
+            return false;
+        }
+
         // using the buffer for input at the moment?
         if (!writeBuffered)
         {
             // We need to position the file write pointer to the postion of our
             // last virtual read.
             int64_t offset = filePointer - bufferedInput + bufferPosition;
-            // set the absolute position
-            lseek64(fileHandle, offset, SEEK_SET);
+            // the writer thread does the real writes for write-behind, so
+            // we need to keep track of the position ourselves.
+            if (writer != NULL)
+            {
+                filePointer = lseek64(fileHandle, (flags & RX_O_APPEND) != 0 ? 0 : offset, (flags & RX_O_APPEND) != 0 ? SEEK_END : SEEK_SET);
+            }
+            else
+            {
+                // set the absolute position
+                lseek64(fileHandle, offset, SEEK_SET);
+            }
             bufferedInput = 0;
             bufferPosition = 0;
             // we're switching modes.
             writeBuffered = true;
         }
 
-        // is this too large to bother copying into the buffer?
-        if (len > bufferSize)
+        // is this too large to bother copying into the buffer?  Write-behind
+        // streams always go through the buffer.
+        if (len > bufferSize && writer == NULL)
         {
             // flush an existing data from the buffer
             flush();
@@ -511,8 +651,11 @@ bool SysFile::write(const char *data, size_t len, size_t &bytesWritten)
             // is the buffer full?
             if (bufferPosition == bufferSize)
             {
-                // flush the buffer now
-                flush();
+                // write the buffer now
+                if (!writeBuffer())
+                {
+                    return false;
+                }
             }
 
             // append to the buffer
@@ -951,8 +1094,9 @@ bool SysFile::seek(int64_t offset, int direction, int64_t &position)
 bool SysFile::getPosition(int64_t &position)
 {
     // we need special processing if we have anything in the
-    // buffer right now
-    if (buffered && !(writeBuffered && bufferPosition == 0))
+    // buffer right now.  A write-behind stream always knows its
+    // position, since the file handle may be behind.
+    if (buffered && (writer != NULL || !(writeBuffered && bufferPosition == 0)))
     {
         // just return the current buffer position
         position = filePointer - bufferedInput + bufferPosition;
@@ -1220,3 +1364,243 @@ bool SysFile::hasData()
     // actual stream.
     return !atEof();
 }
+
+
+/**
+ * Create a write-behind writer for a file handle.
+ *
+ * @param handle The handle the data is written to.
+ * @param size   The size of each of the ring buffers.
+ */
+SysFileWriter::SysFileWriter(int handle, size_t size)
+{
+    fileHandle = handle;
+    bufferSize = size;
+    head = 0;
+    tail = 0;
+    count = 0;
+    stopping = false;
+    errInfo = 0;
+    for (size_t i = 0; i < WRITE_BEHIND_BUFFERS; i++)
+    {
+        buffers[i] = NULL;
+        lengths[i] = 0;
+    }
+}
+
+
+/**
+ * Allocate the ring buffers and start the writer thread.
+ *
+ * @return true if the writer is running, false if the buffers
+ *         or the thread could not be created.
+ */
+bool SysFileWriter::start()
+{
+    for (size_t i = 0; i < WRITE_BEHIND_BUFFERS; i++)
+    {
+        buffers[i] = (char *)malloc(bufferSize);
+        if (buffers[i] == NULL)
+        {
+            stop();
+            return false;
+        }
+    }
+
+    ringLock.create();
+    dataAvailable.create();
+    spaceAvailable.create();
+
+    createThread();
+    if (_threadID == 0)
+    {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * Wait for everything queued to be written, then shut down the
+ * thread and release the buffers.
+ */
+void SysFileWriter::stop()
+{
+    if (_threadID != 0)
+    {
+        ringLock.request();
+        stopping = true;
+        dataAvailable.post();
+        ringLock.release();
+        waitForTermination();
+
+        ringLock.close();
+        dataAvailable.close();
+        spaceAvailable.close();
+    }
+
+    for (size_t i = 0; i < WRITE_BEHIND_BUFFERS; i++)
+    {
+        free(buffers[i]);
+        buffers[i] = NULL;
+    }
+}
+
+
+/**
+ * Wait for one of the ring semaphores to be posted.  This must
+ * be called with the ring lock held, and returns with it held
+ * again.  The semaphore is reset while we still hold the lock,
+ * so a post made after we release it is not lost.
+ *
+ * @param sem    The semaphore to wait on.
+ */
+void SysFileWriter::waitFor(SysSemaphore &sem)
+{
+    sem.reset();
+    ringLock.release();
+    sem.wait();
+    ringLock.request();
+}
+
+
+/**
+ * Queue a buffer of data for the writer thread.  If all of the
+ * ring buffers are waiting to be written, this blocks until
+ * one is free.
+ *
+ * @param data   The data to write.
+ * @param length The data length (no larger than the buffer size).
+ *
+ * @return false if an earlier write has failed.  Nothing more is
+ *         written once there has been an error.
+ */
+bool SysFileWriter::queue(const char *data, size_t length)
+{
+    ringLock.request();
+    while (count == WRITE_BEHIND_BUFFERS && errInfo == 0)
+    {
+        waitFor(spaceAvailable);
+    }
+    if (errInfo != 0)
+    {
+        ringLock.release();
+        return false;
+    }
+    // the writer never touches the buffer at the tail, so we can fill
+    // this without holding the lock
+    size_t slot = tail;
+    ringLock.release();
+
+    memcpy(buffers[slot], data, length);
+    lengths[slot] = length;
+
+    ringLock.request();
+    tail = (tail + 1) % WRITE_BEHIND_BUFFERS;
+    count++;
+    dataAvailable.post();
+    ringLock.release();
+    return true;
+}
+
+
+/**
+ * Wait until all of the queued data has been written.
+ *
+ * @return true if everything was written, false if there was a
+ *         write error.
+ */
+bool SysFileWriter::drain()
+{
+    ringLock.request();
+    while (count > 0)
+    {
+        waitFor(spaceAvailable);
+    }
+    bool result = errInfo == 0;
+    ringLock.release();
+    return result;
+}
+
+
+/**
+ * Test if the writer thread has recorded a write error.
+ *
+ * @return true if a queued write has failed.
+ */
+bool SysFileWriter::error()
+{
+    ringLock.request();
+    bool result = errInfo != 0;
+    ringLock.release();
+    return result;
+}
+
+
+/**
+ * Retrieve the recorded write error.  The error is never
+ * cleared: the file position is unknown after a failed write, so
+ * everything queued after it is discarded and every later write
+ * fails until the writer is stopped.
+ *
+ * @return The error number of the failed write.
+ */
+int SysFileWriter::getError()
+{
+    ringLock.request();
+    int error = errInfo;
+    ringLock.release();
+    return error;
+}
+
+
+/**
+ * The writer thread loop.  This writes out each queued buffer in
+ * turn until the owner stops us and the ring is empty.
+ */
+void SysFileWriter::dispatch()
+{
+    ringLock.request();
+    for (;;)
+    {
+        while (count == 0 && !stopping)
+        {
+            waitFor(dataAvailable);
+        }
+        // stopping and nothing left to write
+        if (count == 0)
+        {
+            break;
+        }
+        size_t slot = head;
+        // once a write has failed, the rest of the data is discarded
+        bool discard = errInfo != 0;
+        ringLock.release();
+
+        const char *data = buffers[slot];
+        size_t length = lengths[slot];
+        int writeError = 0;
+        while (length > 0 && !discard)
+        {
+            ssize_t written = ::write(fileHandle, data, length);
+            if (written <= 0)
+            {
+                writeError = written == 0 ? EIO : errno;
+                break;
+            }
+            data += written;
+            length -= written;
+        }
+
+        ringLock.request();
+        if (writeError != 0 && errInfo == 0)
+        {
+            errInfo = writeError;
+        }
+        head = (head + 1) % WRITE_BEHIND_BUFFERS;
+        count--;
+        spaceAvailable.post();
+    }
+    ringLock.release();
+}
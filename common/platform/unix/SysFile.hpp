@@ -46,6 +46,8 @@
 #define Included_SysFile
 
 #include "rexxapitypes.h"
+#include "SysThread.hpp"
+#include "SysSemaphore.hpp"
 #include <fcntl.h>
 #if defined(__OpenBSD__)
 #include <sys/stat.h>
@@ -69,6 +71,51 @@
 #define RX_S_IWRITE       (S_IWUSR | S_IWGRP | S_IWOTH)
 #define RX_S_IREAD        (S_IRUSR | S_IRGRP | S_IROTH)
 
+/**
+ * A background writer thread used for write-behind streams.
+ * Full output buffers are copied into a fixed ring of buffers
+ * and written out by the thread, so the stream owner only
+ * blocks when the whole ring is still waiting to be written.
+ * Any write error is kept and reported back on the next
+ * operation.
+ */
+class SysFileWriter : public SysThread
+{
+public:
+    enum
+    {
+        WRITE_BEHIND_BUFFERS = 8      // number of buffers in the ring
+    };
+
+    SysFileWriter(int handle, size_t size);
+
+    bool start();
+    void stop();
+    bool queue(const char *data, size_t length);
+    bool drain();
+    virtual void dispatch();
+
+    bool   error();
+    int    getError();
+
+protected:
+    void   waitFor(SysSemaphore &sem);
+
+    int    fileHandle;                // the handle we write to
+    size_t bufferSize;                // size of each ring buffer
+    char  *buffers[WRITE_BEHIND_BUFFERS]; // the ring of output buffers
+    size_t lengths[WRITE_BEHIND_BUFFERS]; // the data length in each buffer
+    size_t head;                      // next buffer to be written
+    size_t tail;                      // next buffer to fill
+    size_t count;                     // number of buffers waiting to be written
+    bool   stopping;                  // the owner is closing the stream
+    int    errInfo;                   // the first write error (sticky until stopped)
+    SysMutex ringLock;                // protects the ring positions
+    SysSemaphore dataAvailable;       // posted when a buffer is queued
+    SysSemaphore spaceAvailable;      // posted when a buffer is written
+};
+
+
 class SysFile
 {
 public:
@@ -81,6 +128,7 @@ public:
     enum
     {
         DEFAULT_BUFFER_SIZE = 4096,   // default size for buffering
+        WRITE_BEHIND_BUFFER_SIZE = 65536, // buffer size for write-behind streams
         LINE_POSITIONING_BUFFER = 512 // buffer size for line movement
     };
 
@@ -93,6 +141,7 @@ public:
     void setStdOut();
     void setStdErr();
     void setBuffering(bool buffer, size_t length);
+    bool setWriteBehind(bool writeBehind);
     bool close();
     bool flush();
     bool read(char *buf, size_t len, size_t &bytesRead);
@@ -131,6 +180,8 @@ public:
 
 protected:
     void   getStreamTypeInfo();
+    bool   writeBuffer();
+    void   stopWriter();
 
     int    fileHandle;      // separate file handle
     int    errInfo;         // last error info
@@ -154,6 +205,7 @@ protected:
     int64_t filePointer;    // current file pointer location
     int    ungetchar;       // a pushed back character value
     bool   fileeof;         // have we reached eof?
+    SysFileWriter *writer;  // background writer for write-behind mode
 };
 
 #endif
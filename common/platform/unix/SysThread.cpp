@@ -113,6 +113,37 @@ void SysThread::yield()
 }
 
 
+/**
+ * Wait for a thread we created to finish running.
+ *
+ * @return true if there was a thread to wait for, false if the
+ *         thread was never successfully created.
+ */
+bool SysThread::waitForTermination()
+{
+    if (attached || _threadID == 0)
+    {
+        return false;
+    }
+    pthread_join(_threadID, NULL);
+    _threadID = 0;
+    return true;
+}
+
+
+/**
+ * Return the number of processors available for running
+ * threads.
+ *
+ * @return The online processor count (at least 1).
+ */
+size_t SysThread::processorCount()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count < 1 ? 1 : (size_t)count;
+}
+
+
 bool SysThread::equals(SysThread &other)
 {
     return pthread_equal(_threadID, other._threadID);
@@ -90,6 +90,8 @@ public:
     void startup();
     void shutdown();
     void yield();
+    bool waitForTermination();
+    static size_t processorCount();
     inline uintptr_t threadID()
     {
          return (uintptr_t)_threadID;
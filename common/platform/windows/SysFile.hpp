@@ -92,6 +92,8 @@ public:
     void setStdOut();
     void setStdErr();
     void setBuffering(bool buffer, size_t length);
+    // write-behind is not implemented here, so writes stay synchronous
+    inline bool setWriteBehind(bool writeBehind) { return !writeBehind; }
     bool close();
     bool flush();
     bool read(char *buf, size_t len, size_t &bytesRead);
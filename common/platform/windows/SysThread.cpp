@@ -154,6 +154,34 @@ void SysThread::yield()
 }
 
 
+bool SysThread::waitForTermination()
+/******************************************************************************/
+/* Function:  Wait for a created thread to finish.  Returns false if there    */
+/*            was no thread to wait for.                                      */
+/******************************************************************************/
+{
+    if (attached || _threadHandle == NULL || _threadHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    WaitForSingleObject(_threadHandle, INFINITE);
+    CloseHandle(_threadHandle);
+    _threadHandle = INVALID_HANDLE_VALUE;
+    return true;
+}
+
+
+size_t SysThread::processorCount()
+/******************************************************************************/
+/* Function:  Return the number of processors available for threads          */
+/******************************************************************************/
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors < 1 ? 1 : (size_t)info.dwNumberOfProcessors;
+}
+
+
 bool SysThread::equals(SysThread &other)
 /******************************************************************************/
 /* Function:  Yield dispatching control to other threads.                     */
@@ -81,6 +81,9 @@
 /* Define to 1 if you have the `nsleep' function. */
 #cmakedefine HAVE_NSLEEP
 
+/* Define to 1 if you have the `pipe2' function. */
+#cmakedefine HAVE_PIPE2
+
 /* Define to 1 if you have the <pthread.h> header file. */
 #cmakedefine HAVE_PTHREAD_H
 
@@ -132,6 +135,9 @@
 /* Define to 1 if you have the <stropts.h> header file. */
 #cmakedefine HAVE_STROPTS_H
 
+/* Define to 1 if you have the <sys/epoll.h> header file. */
+#cmakedefine HAVE_SYS_EPOLL_H
+
 /* Define to 1 if you have the <sys/filio.h> header file. */
 #cmakedefine HAVE_SYS_FILIO_H
 
@@ -66,6 +66,8 @@ RexxReturnCode RexxEntry GrxHost(PCONSTRXSTRING command,
 // #define HOSTEMU_DEBUG
 
 #define SYMTABLESIZE 15
+#define EXECIO_BATCH   256           /* records per variable pool call */
+#define EXECIO_BUFSIZE 65536         /* stdio buffer size per file      */
 #define EXECIO_STMT  0
 #define HI_STMT      1
 #define TE_STMT      2
@@ -64,7 +64,6 @@ EXECIO_OPTIONS ExecIO_Options;
 long           lCmdPtr;
 unsigned long  ulNumSym;
 char *         pszSymbol[SYMTABLESIZE];
-char           szInline[1000];
 long           lStmtType;
 
 
@@ -80,9 +79,24 @@ typedef struct _LL
    struct _LL *  next;
    char          FileName [1024];
    FILE *        pFile;
+   char *        pBuffer;           /* stdio block buffer                */
+   char *        pLine;             /* current line (grown as needed)    */
+   size_t        ulLineSize;        /* allocated size of pLine           */
    } LL;
 typedef LL * PLL;
 
+typedef struct _EXECIO_VARS
+   {
+   SHVBLOCK      aBlocks [EXECIO_BATCH];  /* variable pool requests     */
+   char          aNames [EXECIO_BATCH] [sizeof(ExecIO_Options.aStem) + 21];
+   size_t        aOffsets [EXECIO_BATCH]; /* value offsets in pData     */
+   char *        pData;             /* record data for the batch         */
+   size_t        ulDataSize;        /* allocated size of pData           */
+   size_t        ulDataLen;         /* bytes used in pData               */
+   unsigned long ulCount;           /* number of pending requests        */
+   } EXECIO_VARS;
+typedef EXECIO_VARS * PEXECIO_VARS;
+
 
 /*--------------------------------------------------------------------*/
 /*                                                                    */
@@ -109,6 +123,19 @@ static unsigned long ExecIO_Read_To_Stem(
    PLL pll);                     /* Pointer to file linked list item  */
 static unsigned long ExecIO_Read_To_Queue(
    PLL pll);                     /* Pointer to file linked list item  */
+static long Read_Line(
+   PLL pll);                     /* Pointer to file linked list item  */
+static void Write_Line(
+   PLL pll,                      /* Pointer to file linked list item  */
+   const char * pData,           /* Record data                       */
+   size_t ulLen);                /* Record length                     */
+static bool Add_Stem_Value(
+   PEXECIO_VARS pVars,           /* Pending variable pool requests    */
+   long lIndex,                  /* Stem index                        */
+   const char * pValue,          /* Value to assign                   */
+   size_t ulLen);                /* Value length                      */
+static unsigned long Flush_Stem_Values(
+   PEXECIO_VARS pVars);          /* Pending variable pool requests    */
 static PLL Search_LL(
    char * SFilename);               /* Source file name                  */
 static void Insert_LL(
@@ -118,7 +145,8 @@ static void Delete_LL(
 static long queued(
    void);                        /* No arguments                      */
 static void push(
-   char * pushstr,                  /* String to be pushed onto queue    */
+   const char * pushstr,         /* String to be pushed onto queue    */
+   size_t ulLen,                 /* Length of the string              */
    long lOp);                    /* 0 = FIFO, 1 = LIFO                */
 static char * pull(
    void);                        /* No arguments                      */
@@ -333,6 +361,11 @@ RexxReturnCode RexxEntry GrxHost(PCONSTRXSTRING command,
                *flags = RXSUBCOM_FAILURE;
                goto return_point;
                }
+            /* use a large block buffer for the file */
+            pll -> pBuffer = (char *)malloc(EXECIO_BUFSIZE);
+            if (pll -> pBuffer != NULL) {
+               setvbuf(pll -> pFile, pll -> pBuffer, _IOFBF, EXECIO_BUFSIZE);
+               }
             Insert_LL(pll);
             }
          /* is this a read or write operation? */
@@ -418,51 +451,69 @@ static unsigned long ExecIO_Write_From_Stem (
    {
 
    /* Local function variables */
+   PEXECIO_VARS pVars;           /* Batched variable pool requests    */
    char *      Stem;             /* Stem variable name                */
    char *      Index;            /* Stem index value (string)         */
    RXSTRING rxVal;               /* Rexx stem variable value          */
-   int      elements;
+   long     elements;
+   unsigned long i;
+   unsigned long ulRc = 0;       /* Return code                       */
 
    /* process request */
    if (ExecIO_Options.lRcdCnt == 0)
       return 0;
-   Stem = (char *)malloc(strlen(ExecIO_Options.aStem) + 33);
-   if (Stem == NULL) {
-      return 20;
-      }
-   strcpy(Stem, ExecIO_Options.aStem);
-   Index = Stem + strlen(Stem);
    if (ExecIO_Options.lRcdCnt == -1) {
       /* process an "*" record count */
       // get the number of elements
+      Stem = (char *)malloc(strlen(ExecIO_Options.aStem) + 33);
+      if (Stem == NULL) {
+         return 20;
+         }
+      strcpy(Stem, ExecIO_Options.aStem);
+      Index = Stem + strlen(Stem);
       sprintf(Index, "%u", 0);
       FetchRexxVar(Stem, &rxVal);
-      elements = atoi(rxVal.strptr);
+      elements = rxVal.strptr != NULL ? atol(rxVal.strptr) : 0;
       RexxFreeMemory(rxVal.strptr);
-      while (ExecIO_Options.lStartRcd <= elements) {
-         sprintf(Index, "%ld", ExecIO_Options.lStartRcd);
-         FetchRexxVar(Stem, &rxVal);
-         fputs(rxVal.strptr, pll -> pFile);
-         fputs("\n", pll -> pFile);
-         RexxFreeMemory(rxVal.strptr);
-         ExecIO_Options.lStartRcd++;
-         }
+      free(Stem);
       }
    else {
       /* process a specific record count */
-      while (ExecIO_Options.lStartRcd <= ExecIO_Options.lRcdCnt) {
-         sprintf(Index, "%ld", ExecIO_Options.lStartRcd);
-         FetchRexxVar(Stem, &rxVal);
-         fputs(rxVal.strptr, pll -> pFile);
-         fputs("\n", pll -> pFile);
-         RexxFreeMemory(rxVal.strptr);
+      elements = ExecIO_Options.lRcdCnt;
+      }
+   pVars = (PEXECIO_VARS)calloc(1, sizeof(EXECIO_VARS));
+   if (pVars == NULL) {
+      return 20;
+      }
+   /* fetch the records a batch at a time with a single variable pool */
+   /* request per batch, letting the interpreter allocate the values  */
+   while (ExecIO_Options.lStartRcd <= elements) {
+      while (ExecIO_Options.lStartRcd <= elements && pVars -> ulCount < EXECIO_BATCH) {
+         Add_Stem_Value(pVars, ExecIO_Options.lStartRcd, NULL, 0);
          ExecIO_Options.lStartRcd++;
          }
+      /* nothing from a failed batch is written, but any values */
+      /* that were returned still need to be released           */
+      if (Flush_Stem_Values(pVars) != RXSHV_OK) {
+         ulRc = 20;
+         }
+      for (i = 0; i < pVars -> ulCount; i++) {
+         if (ulRc == 0) {
+            Write_Line(pll, pVars -> aBlocks[i].shvvalue.strptr,
+                       pVars -> aBlocks[i].shvvalue.strlength);
+            }
+         RexxFreeMemory(pVars -> aBlocks[i].shvvalue.strptr);
+         }
+      pVars -> ulCount = 0;
+      if (ulRc != 0) {
+         break;
+         }
       }
+   free(pVars -> pData);
+   free(pVars);
    fflush (pll -> pFile);
 
-   /* return with successful return code */
-   return 0;
+   return ulRc;
    }
 
 
@@ -508,8 +559,7 @@ static unsigned long ExecIO_Write_From_Queue (
       while (items > 0) {
          Item = pull();
          if (Item != NULL) {
-            fputs(Item, pll -> pFile);
-            fputs("\n", pll -> pFile);
+            Write_Line(pll, Item, strlen(Item));
             RexxFreeMemory(Item);
             }
          else {
@@ -525,8 +575,7 @@ static unsigned long ExecIO_Write_From_Queue (
             break;
          Item = pull();
          if (Item != NULL) {
-            fputs(Item, pll -> pFile);
-            fputs("\n", pll -> pFile);
+            Write_Line(pll, Item, strlen(Item));
             RexxFreeMemory(Item);
             }
          else {
@@ -566,55 +615,53 @@ static unsigned long ExecIO_Read_To_Stem (
    {
 
    /* Local function variables */
-   char *   Stem;                /* Stem variable name                */
-   char *   Index;               /* Stem index value (string)         */
+   PEXECIO_VARS pVars;           /* Batched variable pool requests    */
+   long     lLen;                /* Length of the current record      */
+   char     szCount[32];         /* Record count for stem.0           */
    unsigned long ulRc = 0;       /* Return code                       */
 
    /* process request */
    if (ExecIO_Options.lRcdCnt == 0) {
       return 0;
       }
-   Stem = (char *)malloc(strlen(ExecIO_Options.aStem) + 33);
-   if (Stem == NULL) {
+   pVars = (PEXECIO_VARS)calloc(1, sizeof(EXECIO_VARS));
+   if (pVars == NULL) {
       return 20;
       }
-   strcpy(Stem, ExecIO_Options.aStem);
-   Index = Stem + strlen(Stem);
-   if (ExecIO_Options.lRcdCnt == -1) {
-      /* process an "*" record count */
-      while (fgets(szInline, sizeof (szInline), pll -> pFile)) {
-         if (*(szInline + strlen(szInline) - 1) == '\n')
-            *(szInline + strlen(szInline) - 1) = '\0';
-         sprintf(Index, "%ld", ExecIO_Options.lStartRcd);
-         SetRexxVar(Stem, szInline, strlen(szInline));
-         ExecIO_Options.lStartRcd++;
-         }
-      }
-   else {
-      /* process a specific record count */
-      while (ExecIO_Options.lRcdCnt > 0) {
-         if (fgets(szInline, sizeof(szInline), pll -> pFile)) {
-            if (*(szInline + strlen(szInline) - 1) == '\n') {
-               *(szInline + strlen(szInline) - 1) = '\0';
-               }
-            sprintf(Index, "%ld", ExecIO_Options.lStartRcd);
-            SetRexxVar(Stem, szInline, strlen(szInline));
-            ExecIO_Options.lStartRcd++;
-            }
-         else {
+   /* records are handed to the variable pool a batch at a time, so   */
+   /* only one batch of records is ever held in memory here           */
+   while (ExecIO_Options.lRcdCnt != 0) {
+      lLen = Read_Line(pll);
+      if (lLen < 0) {
+         /* running out of records is only an error for a specific count */
+         if (ExecIO_Options.lRcdCnt != -1) {
             ulRc = 2;
-            break;
             }
+         break;
+         }
+      if (!Add_Stem_Value(pVars, ExecIO_Options.lStartRcd, pll -> pLine, (size_t)lLen)) {
+         ulRc = 20;
+         break;
+         }
+      ExecIO_Options.lStartRcd++;
+      if (ExecIO_Options.lRcdCnt > 0) {
          ExecIO_Options.lRcdCnt--;
          }
+      if (pVars -> ulCount == EXECIO_BATCH &&
+          Flush_Stem_Values(pVars) != RXSHV_OK) {
+         ulRc = 20;
+         break;
+         }
       }
    ExecIO_Options.lStartRcd--;
-   sprintf(szInline, "%ld", ExecIO_Options.lStartRcd);
-   sprintf(Index, "%d", 0);
-   SetRexxVar(Stem, szInline, strlen (szInline));
-   free(Stem);
+   sprintf(szCount, "%ld", ExecIO_Options.lStartRcd);
+   Add_Stem_Value(pVars, 0, szCount, strlen(szCount));
+   if (Flush_Stem_Values(pVars) != RXSHV_OK) {
+      ulRc = 20;
+      }
+   free(pVars -> pData);
+   free(pVars);
 
-   /* return with successful return code */
    return ulRc;
    }
 
@@ -640,6 +687,7 @@ static unsigned long ExecIO_Read_To_Queue (
    {
 
    /* Local function variables */
+   long     lLen;                /* Length of the current record      */
 
    /* process request */
    if (ExecIO_Options.lRcdCnt == 0) {
@@ -647,24 +695,19 @@ static unsigned long ExecIO_Read_To_Queue (
       }
    if (ExecIO_Options.lRcdCnt == -1) {
       /* process an "*" record count */
-      while (fgets (szInline, sizeof (szInline), pll -> pFile)) {
-         if (*(szInline + strlen (szInline) - 1) == '\n') {
-            *(szInline + strlen (szInline) - 1) = '\0';
-            }
+      while ((lLen = Read_Line(pll)) >= 0) {
          if (ExecIO_Options.lDirection != 2) {
-            push (szInline, ExecIO_Options.lDirection);
+            push (pll -> pLine, (size_t)lLen, ExecIO_Options.lDirection);
             }
          }
       }
    else {
       /* process a specific record count */
       while (ExecIO_Options.lRcdCnt > 0) {
-         if (fgets (szInline, sizeof (szInline), pll -> pFile)) {
-            if (*(szInline + strlen (szInline) - 1) == '\n') {
-               *(szInline + strlen (szInline) - 1) = '\0';
-               }
+         lLen = Read_Line(pll);
+         if (lLen >= 0) {
             if (ExecIO_Options.lDirection != 2) {
-               push (szInline, ExecIO_Options.lDirection);
+               push (pll -> pLine, (size_t)lLen, ExecIO_Options.lDirection);
                }
             }
          else {
@@ -679,6 +722,195 @@ static unsigned long ExecIO_Read_To_Queue (
    }
 
 
+/*--------------------------------------------------------------------*/
+/*                                                                    */
+/* Function:    Read_Line                                             */
+/*                                                                    */
+/* Description: Read the next record from a file.                     */
+/*                                                                    */
+/* Input:       Pointer to file linked list item                      */
+/*                                                                    */
+/* Returns:     Length of the record or -1 at end of file             */
+/*                                                                    */
+/* References:  None.                                                 */
+/*                                                                    */
+/* Notes:       The record is returned in pll -> pLine without the    */
+/*              line terminator.  The line buffer is grown as needed, */
+/*              so records are not limited in length.                 */
+/*                                                                    */
+/*--------------------------------------------------------------------*/
+
+static long Read_Line (
+   PLL pll)                      /* Pointer to file linked list item  */
+   {
+
+   /* Local function variables */
+   ssize_t lLen;
+
+   lLen = getline(&pll -> pLine, &pll -> ulLineSize, pll -> pFile);
+   if (lLen < 0) {
+      return -1;
+      }
+   if (lLen > 0 && pll -> pLine[lLen - 1] == '\n') {
+      pll -> pLine[--lLen] = '\0';
+      }
+   return (long)lLen;
+   }
+
+
+/*--------------------------------------------------------------------*/
+/*                                                                    */
+/* Function:    Write_Line                                            */
+/*                                                                    */
+/* Description: Write a record to a file.                             */
+/*                                                                    */
+/* Input:       Pointer to file linked list item                      */
+/*              Pointer to the record data                            */
+/*              Record length                                         */
+/*                                                                    */
+/* Returns:     None.                                                 */
+/*                                                                    */
+/* References:  None.                                                 */
+/*                                                                    */
+/* Notes:       The data goes through the block buffer of the file,   */
+/*              so no system call is made per record.                 */
+/*                                                                    */
+/*--------------------------------------------------------------------*/
+
+static void Write_Line (
+   PLL pll,                      /* Pointer to file linked list item  */
+   const char * pData,           /* Record data                       */
+   size_t ulLen)                 /* Record length                     */
+   {
+
+   if (ulLen > 0) {
+      fwrite(pData, 1, ulLen, pll -> pFile);
+      }
+   putc('\n', pll -> pFile);
+   return;
+   }
+
+
+/*--------------------------------------------------------------------*/
+/*                                                                    */
+/* Function:    Add_Stem_Value                                        */
+/*                                                                    */
+/* Description: Queue a stem variable request for the next batched    */
+/*              variable pool call.                                   */
+/*                                                                    */
+/* Input:       Pointer to the pending requests                       */
+/*              Stem index                                            */
+/*              Pointer to the value (NULL for a fetch request)       */
+/*              Value length                                          */
+/*                                                                    */
+/* Returns:     false if the value could not be saved                 */
+/*                                                                    */
+/* References:  None.                                                 */
+/*                                                                    */
+/* Notes:       Set values are copied into the batch data buffer, so  */
+/*              the caller may reuse its buffer immediately.          */
+/*                                                                    */
+/*--------------------------------------------------------------------*/
+
+static bool Add_Stem_Value (
+   PEXECIO_VARS pVars,           /* Pending variable pool requests    */
+   long lIndex,                  /* Stem index                        */
+   const char * pValue,          /* Value to assign                   */
+   size_t ulLen)                 /* Value length                      */
+   {
+
+   /* Local function variables */
+   PSHVBLOCK pBlock = &pVars -> aBlocks[pVars -> ulCount];
+   char *    pszName = pVars -> aNames[pVars -> ulCount];
+   size_t    ulNewSize;
+   char *    pNewData;
+
+   memset(pBlock, '\0', sizeof(SHVBLOCK));
+   sprintf(pszName, "%s%ld", ExecIO_Options.aStem, lIndex);
+   pBlock -> shvname.strptr = pszName;
+   pBlock -> shvname.strlength = strlen(pszName);
+   pBlock -> shvnamelen = pBlock -> shvname.strlength;
+   if (pValue == NULL) {
+      pBlock -> shvcode = RXSHV_SYFET;
+      }
+   else {
+      /* make sure there is room for the value */
+      if (pVars -> ulDataLen + ulLen > pVars -> ulDataSize) {
+         ulNewSize = pVars -> ulDataSize == 0 ? EXECIO_BUFSIZE : pVars -> ulDataSize * 2;
+         while (ulNewSize < pVars -> ulDataLen + ulLen) {
+            ulNewSize *= 2;
+            }
+         pNewData = (char *)realloc(pVars -> pData, ulNewSize);
+         if (pNewData == NULL) {
+            return false;
+            }
+         pVars -> pData = pNewData;
+         pVars -> ulDataSize = ulNewSize;
+         }
+      memcpy(pVars -> pData + pVars -> ulDataLen, pValue, ulLen);
+      /* the data buffer may move, so the pointer is set at flush time */
+      pVars -> aOffsets[pVars -> ulCount] = pVars -> ulDataLen;
+      pVars -> ulDataLen += ulLen;
+      pBlock -> shvvalue.strlength = ulLen;
+      pBlock -> shvvaluelen = ulLen;
+      pBlock -> shvcode = RXSHV_SYSET;
+      }
+   pVars -> ulCount++;
+   return true;
+   }
+
+
+/*--------------------------------------------------------------------*/
+/*                                                                    */
+/* Function:    Flush_Stem_Values                                     */
+/*                                                                    */
+/* Description: Process all queued stem variable requests with a      */
+/*              single RexxVariablePool call.                         */
+/*                                                                    */
+/* Input:       Pointer to the pending requests                       */
+/*                                                                    */
+/* Returns:     Return code from RexxVariablePool()                   */
+/*                                                                    */
+/* References:  None.                                                 */
+/*                                                                    */
+/* Notes:       Set requests are cleared from the batch.  Fetch       */
+/*              requests are left in place so the caller can process  */
+/*              the returned values and then reset the count.         */
+/*                                                                    */
+/*--------------------------------------------------------------------*/
+
+static unsigned long Flush_Stem_Values (
+   PEXECIO_VARS pVars)           /* Pending variable pool requests    */
+   {
+
+   /* Local function variables */
+   unsigned long ulRetc = RXSHV_OK;
+   unsigned long i;
+   bool          fFetch = false;
+
+   if (pVars -> ulCount == 0) {
+      return ulRetc;
+      }
+   /* chain the requests together and resolve the value pointers */
+   for (i = 0; i < pVars -> ulCount; i++) {
+      if (pVars -> aBlocks[i].shvcode == RXSHV_SYSET) {
+         pVars -> aBlocks[i].shvvalue.strptr = pVars -> pData + pVars -> aOffsets[i];
+         }
+      else {
+         fFetch = true;
+         }
+      pVars -> aBlocks[i].shvnext = i + 1 < pVars -> ulCount ? &pVars -> aBlocks[i + 1] : NULL;
+      }
+   ulRetc = RexxVariablePool(pVars -> aBlocks);
+   if (!fFetch) {
+      pVars -> ulCount = 0;
+      }
+   pVars -> ulDataLen = 0;
+   /* new variables are not an error */
+   return ulRetc & ~RXSHV_NEWV;
+   }
+
+
 /*--------------------------------------------------------------------*/
 /*                                                                    */
 /* Function:    Search_LL                                             */
@@ -777,6 +1009,9 @@ static void Delete_LL (
    if (pll -> prev != NULL) {
       pll -> prev -> next = pll -> next;
       }
+   /* the file has already been closed, so its buffers can go */
+   free(pll -> pBuffer);
+   free(pll -> pLine);
    free(pll);
    return;
    }
@@ -817,6 +1052,7 @@ static long queued (
 /* Description: Push an item onto the current Rexx queue.             */
 /*                                                                    */
 /* Input:       Pointer to the string to be pushed                    */
+/*              Length of the string                                  */
 /*                                                                    */
 /* Returns:     Number of queued items                                */
 /*                                                                    */
@@ -827,14 +1063,15 @@ static long queued (
 /*--------------------------------------------------------------------*/
 
 static void push (
-   char * pushstr,               /* String to be pushed onto queue    */
+   const char * pushstr,         /* String to be pushed onto queue    */
+   size_t ulLen,                 /* Length of the string              */
    long lOp)                     /* 0 = FIFO, 1 = LIFO                */
    {
 
    CONSTRXSTRING rxstr;
 
    rxstr.strptr = pushstr;
-   rxstr.strlength = strlen(pushstr);
+   rxstr.strlength = ulLen;
    RexxAddQueue("SESSION", &rxstr, (size_t)lOp);
    return;
    }
@@ -181,6 +181,7 @@
 #include <math.h>
 #include <limits.h>
 #include <sys/stat.h>                  /* mkdir() function           */
+#include <sys/mman.h>                  /* mmap() for SysFileSearch   */
 #include <errno.h>                     /* get the errno variable     */
 #include <stddef.h>
 #include <sys/types.h>
@@ -192,6 +193,7 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <signal.h>
+#include <setjmp.h>                    /* SysFileSearch SIGBUS guard */
 #include <time.h>
 #include <netdb.h>
 #include <alloca.h>
@@ -258,12 +260,12 @@ extern char *resolve_tilde(const char *);
 #define  VALID_ROUTINE    0            /* Successful completion      */
 //#define  MAX_LINE_LEN   2048         /* max line length */
 #define  MAX_LINE_LEN   4096           /* max line length */
-#define  MAX_READ       0x10000        /* full segment of buffer     */
 #define  CH_EOF         0x1A           /* end of file marker         */
 #define  CH_CR          '\r'           /* carriage return character  */
 #define  CH_NL          '\n'           /* new line character         */
 #define  MAX            256            /* temporary buffer length    */
 #define  IBUF_LEN       4096           /* Input buffer length        */
+#define  SEARCH_BATCH   64             /* SysFileSearch stem batch   */
 #define CURRENT_DIR_FIRST 0            /* search flag 'C'            */
 #define ENVIRONMENT_ONLY  1            /* search flag 'N'            */
 #define OFFSET          1000           /* needed to prevent collision*/
@@ -416,17 +418,24 @@ typedef struct RxTreeData {
 
 
 /*********************************************************************/
-/* RxTree Structure used by GetLine, OpenFile and CloseFile          */
+/* Structures used by SysFileSearch                                  */
 /*********************************************************************/
 
-typedef struct _GetFileData {
-  char *       buffer;                 /* file read buffer           */
-  size_t       size;                   /* file size                  */
-  size_t       data;                   /* data left in buffer        */
-  size_t       residual;               /* size left to read          */
-  const char  *scan;                   /* current scan position      */
-  FILE         *handle;                /* file handle                */
-} GetFileData;
+typedef struct _MappedFile {
+  const char  *data;                   /* file contents              */
+  size_t       size;                   /* data length up to any EOF  */
+  size_t       length;                 /* mapped/allocated length    */
+  bool         mapped;                 /* true if data is mmapped    */
+} MappedFile;
+
+typedef struct _SearchTarget {
+  unsigned char fold[256];             /* case folding table         */
+  unsigned char needle[MAX_LINE_LEN];  /* folded search string       */
+  size_t        length;                /* search string length       */
+  unsigned char first[2];              /* first byte variants        */
+  unsigned char last[2];               /* last byte variants         */
+  bool          filter;                /* word filter is usable      */
+} SearchTarget;
 
 /*********************************************************************/
 /* RxStemData                                                        */
@@ -514,44 +523,6 @@ bool string2size_t(
 /****************  REXXUTIL Supporting Functions  ********************/
 /*********************************************************************/
 
-/********************************************************************
-* Function:  ReadNextBuffer(filedata)                               *
-*                                                                   *
-* Purpose:   Reads the next buffer of data.                         *
-*                                                                   *
-* RC:        0       buffer was read                                *
-*            1     - error occurred reading buffer                  *
-*********************************************************************/
-int ReadNextBuffer(
-   GetFileData  *filedata )            /* global file information    */
-{
-  size_t    size;                      /* size to read               */
-  char     *endptr;                    /* end of file pointer        */
-                                       /* get size of this read      */
-  if(filedata->residual >= MAX_READ)
-    size = MAX_READ;                   /* read as much as possible   */
-  else
-    size = filedata->residual;         /* take the rest              */
-                                       /* read the file in           */
-  filedata->data = fread(filedata->buffer, 1, size, filedata->handle);
-  if(!filedata->data)                  /* problems ?                 */
-    return (1);                        /* get out                    */
-  if (filedata->data != size)          /* not get all of it?         */
-    filedata->residual = 0;            /* no residual                */
-  else                                 /* residual is remainder      */
-    filedata->residual = filedata->residual - size;
-                                       /* look for a EOF mark        */
-  endptr = (char *)memchr(filedata->buffer, CH_EOF, filedata->data);
-
-  if (endptr) {                        /* found an EOF mark          */
-                                       /* set new length             */
-    filedata->data = (size_t)(endptr - filedata->buffer);
-    filedata->residual = 0;            /* no residual                */
-  }
-  filedata->scan = filedata->buffer;   /* set position to beginning  */
-  return 0;
-}
-
 /***********************************************************************/
 /* Function: strupr(string)                                            */
 /* Purpose:  Uppercas the given string                                 */
@@ -564,260 +535,288 @@ void strupr(char * string){
 }
 
 /********************************************************************
-* Function:  OpenFile(file, filedata)                               *
+* Function:  OpenMappedFile(file, filedata, canMap)                 *
 *                                                                   *
-* Purpose:   Prepares a file for reading.                           *
+* Purpose:   Maps a regular file into memory for searching.  Other  *
+*            files, files that cannot be mapped, and all files when *
+*            canMap is false are read into a buffer instead.  The   *
+*            size is the full file length; the caller looks for the *
+*            EOF mark, since a mapped file must only be touched     *
+*            under the search guard.                                *
 *                                                                   *
 * RC:        0     - file was opened successfully                   *
 *            1     - file open error occurred                       *
 *********************************************************************/
 
-int OpenFile(
+int OpenMappedFile(
    const char  *file,                  /* file name                  */
-   GetFileData *filedata )             /* global file information    */
+   MappedFile  *filedata,              /* mapped file information    */
+   bool         canMap )               /* mapping is allowed         */
 {
-   struct stat64 finfo;                /* file information           */
-   char *      endptr = NULL;          /* end of buffer pointer      */
+  struct stat64 finfo;                 /* file information           */
+  int         handle;                  /* file handle                */
 
-                                       /* try to open the file       */
-  if((filedata->handle = fopen(file,"r")) == NULL)
+  if ((handle = open(file, O_RDONLY)) == -1)
     return (1);                        /* return failure             */
                                        /* retrieve the file size     */
-  if((stat64(file,&finfo) == -1)||(!finfo.st_size)){
-    fclose(filedata->handle);          /* close the file             */
+  if (fstat64(handle, &finfo) == -1 || !finfo.st_size ||
+      (uint64_t)finfo.st_size > (uint64_t)SIZE_MAX) {
+    close(handle);                     /* close the file             */
     return (1);                        /* and quit                   */
   }
-  if (finfo.st_size <= MAX_READ) {     /* less than a single buffer  */
-                                       /* allocate buffer for file   */
-    if((filedata->buffer = (char *)malloc(finfo.st_size)) == NULL ){
-      fclose(filedata->handle);        /* close the file             */
-      return (1);                      /* and quit                   */
-    }
-    filedata->size = finfo.st_size;    /* save file size             */
-    filedata->residual = 0;            /* no left over information   */
-                                       /* read the file in           */
-    filedata->data = fread(filedata->buffer, 1,
-                                      finfo.st_size, filedata->handle);
-    if(filedata->data != (size_t)finfo.st_size){/*  problems ?               */
-      free(filedata->buffer);          /* free the buffer            */
-      fclose(filedata->handle);        /* close the file             */
-      return (1);                      /* and quit                   */
-    }                                  /* look for a EOF mark        */
-    endptr = (char *)memchr(filedata->buffer, CH_EOF, filedata->data);
-    if (endptr)                        /* found an EOF mark          */
-                                       /* set new length             */
-      filedata->data = (size_t)(endptr - filedata->buffer);
-    filedata->scan = filedata->buffer; /* set position to beginning  */
-  }
-  else {                               /* need to read partial       */
-                                       /* allocate buffer for read   */
-    if((filedata->buffer = (char *)malloc(MAX_READ)) == NULL ){
-      fclose(filedata->handle);        /* close the file             */
-      return (1);                      /* and quit                   */
-    }
-    filedata->size = finfo.st_size;    /* save file size             */
-                                       /* and set remainder          */
-    filedata->residual = filedata->size;
-                                       /* read the file in           */
-    if (ReadNextBuffer(filedata)) {
-      free(filedata->buffer);          /* free the buffer            */
-      fclose(filedata->handle);        /* close the file             */
-      return 1;
+  filedata->length = (size_t)finfo.st_size;
+                                       /* only map regular files     */
+  filedata->mapped = canMap && S_ISREG(finfo.st_mode);
+  if (filedata->mapped)
+    filedata->data = (const char *)mmap(NULL, filedata->length, PROT_READ, MAP_PRIVATE, handle, 0);
+  if (!filedata->mapped || filedata->data == (const char *)MAP_FAILED) {
+                                       /* read the whole file in     */
+    filedata->mapped = false;
+    char *buffer = (char *)malloc(filedata->length);
+    size_t total = 0;
+    while (buffer != NULL && total < filedata->length) {
+      ssize_t count = read(handle, buffer + total, filedata->length - total);
+      if (count <= 0)
+        break;
+      total += count;
+    }
+    if (buffer == NULL || total != filedata->length) {
+      free(buffer);
+      close(handle);
+      return (1);
     }
+    filedata->data = buffer;
   }
+#ifdef MADV_SEQUENTIAL
+  else {
+    madvise((void *)filedata->data, filedata->length, MADV_SEQUENTIAL);
+  }
+#endif
+  close(handle);                       /* the mapping stays valid    */
+  filedata->size = filedata->length;
   return 0;                            /* file is opened             */
 }
 
 /********************************************************************
-* Function:  CloseFile(filedata)                                    *
+* Function:  CloseMappedFile(filedata)                              *
 *                                                                   *
-* Purpose:   Close a file                                           *
+* Purpose:   Release a file opened with OpenMappedFile              *
 *********************************************************************/
-void CloseFile(
-   GetFileData *filedata )             /* global file information    */
+void CloseMappedFile(
+   MappedFile  *filedata )             /* mapped file information    */
 {
-  fclose(filedata->handle);            /* close the file             */
-  free(filedata->buffer);              /* release the file buffer    */
+  if (filedata->mapped)
+    munmap((void *)filedata->data, filedata->length);
+  else
+    free((void *)filedata->data);
 }
 
-/*********************************************************************
-* Function:  GetLine(line, size, filedata)                          *
-*                                                                   *
-* Purpose:   Reads a line of data using buffered reads.  At end of  *
-*            file, zero is returned to indicate nothing left.       *
-*                                                                   *
-* RC:        true -  line was read successfully                     *
-*            false - end of file was reached                        *
+/********************************************************************
+* Search guard.  A mapped file that another process truncates       *
+* (logrotate copytruncate, for example) raises SIGBUS when the      *
+* missing pages are touched.  One thread at a time may scan a       *
+* mapped file; it catches SIGBUS and reports a read error instead.  *
+* Threads that cannot take the guard read the file into a buffer.   *
+* Only the scan runs under the guard: the variable pool is always   *
+* given copies of the lines, never pointers into the mapping.       *
 *********************************************************************/
 
-int GetLine(
-   char *line,                        /* returned line              */
-   size_t      size,                  /* size of line buffer        */
-   GetFileData *filedata )            /* file handle                */
+static pthread_mutex_t  searchGuardLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t        searchGuardThread;   /* thread owning guard */
+static sigjmp_buf       searchGuardJump;     /* recovery point      */
+static struct sigaction searchGuardSaved;    /* previous SIGBUS     */
+
+static void SearchGuardHandler(int signal)
 {
-   const char *scan;                    /* current scan pointer       */
-   size_t        length;                /* line length                */
-   size_t        copylength;            /* copied length              */
+  if (pthread_equal(pthread_self(), searchGuardThread))
+    siglongjmp(searchGuardJump, 1);    /* abandon the mapped scan    */
+                                       /* not ours: put back the old */
+                                       /* handling and let the fault */
+                                       /* happen again               */
+  sigaction(SIGBUS, &searchGuardSaved, NULL);
+}
 
+/* Arm the guard for this thread; the lock is already held           */
+static void StartSearchGuard()
+{
+  struct sigaction action;
 
-  if (!(filedata->data)) {             /* if out of current buffer   */
-    if (filedata->residual) {          /* may be another buffer      */
-      ReadNextBuffer(filedata);        /* try to read one            */
-      if (!filedata->data)             /* nothing more?              */
-        return 1;                      /* all done                   */
-    }
-    else
-      return (1);                      /* return EOF condition       */
-  }
-                                       /* look for a line feed       */
-  scan = (const char *)memchr(filedata->scan, CH_NL, filedata->data);
-  if (scan) {                          /* found one                  */
-                                       /* calculate the length       */
-    length = scan - filedata->scan;
-    copylength = length;
-    if (copylength > size)
-    {
-        copylength = size;
-    }
-                                       /* copy over the data         */
-    memcpy(line, filedata->scan, copylength);
-    line[copylength] = '\0';           /* make into ASCIIZ string    */
+  searchGuardThread = pthread_self();
+  action.sa_handler = SearchGuardHandler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = 0;
+  sigaction(SIGBUS, &action, &searchGuardSaved);
+}
 
-    /* we don't want the CR character in the result string*/
-    if ( line[copylength - 1] == CH_CR ) {
-      line[copylength - 1] = '\0';
-    }
+/* Disarm the guard and let another thread map a file                */
+static void EndSearchGuard()
+{
+  sigaction(SIGBUS, &searchGuardSaved, NULL);
+  pthread_mutex_unlock(&searchGuardLock);
+}
 
-    filedata->data -= length + 1;      /* reduce the length          */
-    filedata->scan = scan + 1;         /* set new scan point         */
+/********************************************************************
+* Word-at-a-time helpers.  These test 8 bytes of data at once       *
+* using ordinary 64-bit arithmetic, which works on any platform     *
+* and needs no alignment.                                           *
+*********************************************************************/
 
-    if (!filedata->data) {             /* all used up                */
-      if (filedata->residual)          /* more to read               */
-        ReadNextBuffer(filedata);      /* read the next buffer       */
-    }
-    return 0;                            /* this worked ok           */
-  }
-  else                                   /* ran off the end          */
-  {
-/* now we have scanned the whole buffer, but didn't find LF.         */
-/* we have two situation that can appear:                            */
-/* 1.) size > filedata->data ==> there is still room in the working  */
-/*     buffer, we can see whether we have scanned the whole file     */
-/*     --> ReadNextBuffer, or this was it, and we return             */
-/* 2.) size < filedata->buffer ==> we have scanned to the end of the */
-/*     buffer, more than what would fit into it, but still we        */
-/*     haven't had a hit. So copy all elements into the buffer       */
-/*     read the next buffer, GetLine to get the next LF              */
-/*     and return what was put into buffer. Be ALWAYS AWARE that     */
-/*     that buffer limits to 2047 bytes, and that we only return up  */
-/*     to 2047 bytes of a line. The rest of the line is not returned */
-/*     and not checked for search argument. Nevertheless, this       */
-/*     garantees, that the line counter (argument 'N') corresponds   */
-/*     with the input file                                           */
-
-                                       /* get length to copy         */
-    if (size > filedata->data)
-    {
-       copylength = filedata->data;    /* copy the rest into linebuffer */
-                                       /* copy over the data         */
-       memcpy(line, filedata->scan, copylength);
-       line[copylength] = '\0';           /* make into ASCIIZ string    */
-
-     /* all data should be read, filedata->data must be zero          */
-       filedata->data -= copylength;
-     /* scan should be at the end                                     */
-       filedata->scan += copylength;    /* set new scan point         */
-
-    /* if no more data to read in the file, return OK     */
-       if (!filedata->residual)
-          return 0;
-       else
-          return GetLine(line + copylength, size - copylength, filedata);
-    }
-    else        /* the line is full, scan until LF found but no copy */
-    {
-       copylength = filedata->data;
-       if (size < copylength)
-       {
-           copylength = size;
-       }
-                                      /* copy over the data         */
-       memcpy(line, filedata->scan, copylength);
-       line[copylength] = '\0';           /* make into ASCIIZ string    */
+#define  WORD_ONES     0x0101010101010101ULL
+#define  WORD_LOWS     0x7f7f7f7f7f7f7f7fULL
 
-    /* we don't want the CR character in the result string*/
-       filedata->data  = 0;             /* no data in buffer          */
-       filedata->scan += filedata->data;     /* set scan point to end */
+inline uint64_t LoadWord(const char *data)
+{
+  uint64_t word;
+  memcpy(&word, data, sizeof(word));
+  return word;
+}
 
-       if (filedata->residual)          /* more to read               */
-       {
-           ReadNextBuffer(filedata);    /* read the next buffer       */
-           return GetLine(line + copylength, 0, filedata);
-       }
-       else
-          return 0;
-    }
-  }
+/* sets the high bit of each byte of word equal to ch, exactly       */
+inline uint64_t MatchBytes(uint64_t word, unsigned char ch)
+{
+  uint64_t x = word ^ (WORD_ONES * ch);
+  return ~(((x & WORD_LOWS) + WORD_LOWS) | x | WORD_LOWS);
+}
+
+/* counts the bytes flagged by MatchBytes                            */
+inline size_t CountBytes(uint64_t flags)
+{
+  return (size_t)((((flags >> 7) * WORD_ONES) >> 56) & 0xff);
 }
 
 /********************************************************************
-* Function:  mystrstr(haystack, needle, hlen, nlen, sensitive)      *
-*                                                                   *
-* Purpose:   Determines if the string 'needle' is in the            *
-*            string 'haystack' by returning it's position or        *
-*            a NULL if not found.  The length of haystack and       *
-*            needle are given by 'hlen' and 'nlen' respectively.    *
-*                                                                   *
-*            If 'sensitive' is true, then the search is case        *
-*            sensitive, else it is case insensitive.                *
-*                                                                   *
-* RC:        num  - The pos where needle was found.                 *
-*            NULL - needle not found.                               *
+* Function:  CountLines(scan, end)                                  *
 *                                                                   *
-* Used By:   SysFileSearch()                                        *
+* Purpose:   Counts the line feeds in a range of data.              *
 *********************************************************************/
+size_t CountLines(
+  const char  *scan,                   /* start of data              */
+  const char  *end )                   /* end of data                */
+{
+  size_t count = 0;
 
-const char *mystrstr(
-  const char   *haystack,
-  const char   *needle,
-  size_t   hlen,
-  size_t   nlen,
-  bool    sensitive)
+  while (end - scan >= (ptrdiff_t)sizeof(uint64_t)) {
+    count += CountBytes(MatchBytes(LoadWord(scan), CH_NL));
+    scan += sizeof(uint64_t);
+  }
+  for (; scan < end; scan++) {
+    if (*scan == CH_NL)
+      count++;
+  }
+  return count;
+}
 
+/********************************************************************
+* Function:  InitSearchTarget(target, string, length, sensitive)    *
+*                                                                   *
+* Purpose:   Prepares a search string.  Nulls in the search string  *
+*            match blanks, and the string is uppercased for a case  *
+*            insensitive search.                                    *
+*                                                                   *
+* RC:        true  - the target can match a line                    *
+*            false - the target can never match                     *
+*********************************************************************/
+bool InitSearchTarget(
+  SearchTarget *target,
+  const char   *string,
+  size_t        length,
+  bool          sensitive)
 {
-  char line[MAX_LINE_LEN];
-  char target[MAX_LINE_LEN];
-  size_t p;
+  size_t i;
 
- /* Copy line  - Change nulls to spaces and uppercase if needed      */
+  /* lines are never longer than this, and never contain a line feed */
+  if (length >= MAX_LINE_LEN || memchr(string, CH_NL, length) != NULL)
+    return false;
 
-  for (p = 0; p < hlen; p++) {
+  for (i = 0; i < 256; i++)
+    target->fold[i] = sensitive ? (unsigned char)i : (unsigned char)toupper(i);
+
+  target->length = length;
+  for (i = 0; i < length; i++)
+    target->needle[i] = target->fold[string[i] == '\0' ? ' ' : (unsigned char)string[i]];
+
+  /* the word filter needs the first and last bytes of the target,   */
+  /* and only handles two spellings of each                          */
+  target->filter = length > 0;
+  if (target->filter) {
+    unsigned char probes[2] = { target->needle[0], target->needle[length - 1] };
+    unsigned char *variants[2] = { target->first, target->last };
+    for (size_t p = 0; p < 2; p++) {
+      size_t count = 0;
+      for (i = 0; i < 256; i++) {
+        if (target->fold[i] == probes[p]) {
+          if (count == 2) {
+            target->filter = false;
+            break;
+          }
+          variants[p][count++] = (unsigned char)i;
+        }
+      }
+      if (count == 1)
+        variants[p][1] = variants[p][0];
+    }
+  }
+  return true;
+}
 
-    if (haystack[p] == '\0')
-      line[p] = ' ';
-    else if (sensitive)
-      line[p] = haystack[p];
-    else line[p] = toupper(haystack[p]);
+/********************************************************************
+* Function:  TargetAt(scan, target)                                 *
+*                                                                   *
+* Purpose:   Tests for the target string at a position.             *
+*********************************************************************/
+inline bool TargetAt(
+  const char   *scan,
+  SearchTarget *target)
+{
+  for (size_t i = 0; i < target->length; i++) {
+    if (target->fold[(unsigned char)scan[i]] != target->needle[i])
+      return false;
   }
-  line[p] = '\0';
- /* Copy target  - Change nulls to spaces and uppercase if needed    */
+  return true;
+}
 
-  for (p = 0; p < nlen; p++) {
+/********************************************************************
+* Function:  FindTarget(scan, end, target)                          *
+*                                                                   *
+* Purpose:   Finds the first occurrence of the target in a range of *
+*            data.  Eight candidate positions are tested at a time  *
+*            by matching the first and last bytes of the target,    *
+*            and only the candidates that pass are compared in full.*
+*                                                                   *
+* RC:        The position of the match, or NULL if not found.       *
+*********************************************************************/
+const char *FindTarget(
+  const char   *scan,
+  const char   *end,
+  SearchTarget *target)
+{
+  size_t length = target->length;
 
-    if (needle[p] == '\0')
-      target[p] = ' ';
-    else if (sensitive)
-      target[p] = needle[p];
-    else target[p] = toupper(needle[p]);
+  if ((size_t)(end - scan) < length)
+    return NULL;
+  const char *last = end - length;     /* last possible match start  */
+
+  if (target->filter) {
+    /* both words must lie inside the data                           */
+    while (last - scan >= (ptrdiff_t)sizeof(uint64_t) - 1) {
+      uint64_t head = LoadWord(scan);
+      uint64_t tail = LoadWord(scan + length - 1);
+      uint64_t hits = (MatchBytes(head, target->first[0]) | MatchBytes(head, target->first[1])) &
+                      (MatchBytes(tail, target->last[0]) | MatchBytes(tail, target->last[1]));
+      if (hits != 0) {
+        for (size_t i = 0; i < sizeof(uint64_t); i++) {
+          if (TargetAt(scan + i, target))
+            return scan + i;
+        }
+      }
+      scan += sizeof(uint64_t);
+    }
   }
-  target[p] = '\0';
-  const char *hit = strstr(line, target);
-  if (hit == NULL)
-  {
-      return NULL;
+  for (; scan <= last; scan++) {
+    if (TargetAt(scan, target))
+      return scan;
   }
-  // adjust original pointer to offset
-  return haystack +  (hit - line);
+  return NULL;
 }
 
 /*************************************************************************
@@ -1635,35 +1634,50 @@ size_t RexxEntry SysFileDelete(const char *name, size_t numargs, CONSTRXSTRING a
 *                                                                        *
 * Return:    NO_UTIL_ERROR   - Successful.                               *
 *            ERROR_NOMEM     - Out of memory.                            *
+*            ERROR_FILEOPEN  - The file could not be opened or read.     *
 *************************************************************************/
 
 size_t RexxEntry SysFileSearch(const char *name, size_t numargs, CONSTRXSTRING args[], const char *queuename, PRXSTRING retstr)
 {
-  const char *target;                  /* search string              */
   const char *file;                    /* search file                */
   const char *opts;                    /* option string              */
-  const char *ptr;                     /* Pointer to char str found  */
+  const char *data;                    /* start of file data         */
+  const char *end;                     /* end of file data           */
+  const char *scan;                    /* current search position    */
+  const char *counted;                 /* lines counted up to here   */
+  const char *hit;                     /* Pointer to char str found  */
+  const char *lineStart;               /* start of matching line     */
+  const char *lineEnd;                 /* end of matching line       */
   size_t      num = 0;                 /* Line number                */
   size_t      len;                     /* Length of string           */
   size_t      len2;                    /* Length of string           */
+  size_t      stemlen;                 /* Length of stem name        */
+  size_t      count = 0;               /* Number of lines found      */
+  size_t      batched = 0;             /* Entries in current batch   */
   bool        linenums = false;        /* Set true for linenums in   */
                                        /* output                     */
   bool        sensitive = false;       /* Set true for case-sens     */
                                        /* search                     */
-  RXSTEMDATA  ldp;                     /* stem data                  */
-  GetFileData filedata;                /* file read information      */
-  char *       dir_buf = NULL;          /* directory buffer           */
-  char *       line = NULL;             /* Line read from file        */
+  bool        failed = false;          /* variable pool failure      */
+  bool        guarded;                 /* holding the search guard   */
+  SearchTarget searchTarget;           /* prepared search string     */
+  MappedFile  filedata;                /* file contents              */
+  SHVBLOCK    shvb[SEARCH_BATCH];      /* batched variable requests  */
+  char        varnames[SEARCH_BATCH][MAX + MAX_DIGITS + 2];
+  char        stemname[MAX];           /* uppercased stem name       */
+  char        countbuf[MAX_DIGITS + 12];  /* stem.0 value            */
+  char *      values = NULL;           /* numbered line values       */
+  char *      dir_buf = NULL;          /* directory buffer           */
 
   BUILDRXSTRING(retstr, NO_UTIL_ERROR);/* pass back result           */
                                        /* validate arguments         */
   if (numargs < 3 || numargs > 4 ||
       !RXVALIDSTRING(args[0]) ||
       !RXVALIDSTRING(args[1]) ||
-      !RXVALIDSTRING(args[2]))
+      !RXVALIDSTRING(args[2]) ||
+      args[2].strlength >= MAX - 1)
     return INVALID_ROUTINE;            /* raise an error             */
 
-  target = args[0].strptr;             /* get target pointer         */
   file = args[1].strptr;               /* get file name              */
 
   if(*(file) == '~'){                  /* check for using '~/'       */
@@ -1678,77 +1692,145 @@ size_t RexxEntry SysFileSearch(const char *name, size_t numargs, CONSTRXSTRING a
     if (strstr(opts, "C") || strstr(opts, "c"))
       sensitive = true;
   }
-                                       /* Initialize data area       */
-  ldp.count = 0;
-  strcpy(ldp.varname, args[2].strptr);
-  ldp.stemlen = args[2].strlength;
-  strupr(ldp.varname);                 /* uppercase the name         */
-  if (ldp.varname[ldp.stemlen-1] != '.')
-    ldp.varname[ldp.stemlen++] = '.';
-  if (OpenFile(file, &filedata)) {     /* open the file              */
+                                       /* Initialize the stem name   */
+  strcpy(stemname, args[2].strptr);
+  stemlen = args[2].strlength;
+  strupr(stemname);                    /* uppercase the name         */
+  if (stemname[stemlen-1] != '.')
+    stemname[stemlen++] = '.';
+  stemname[stemlen] = '\0';
+                                       /* map only if we can guard   */
+  guarded = pthread_mutex_trylock(&searchGuardLock) == 0;
+  if (OpenMappedFile(file, &filedata, guarded)) {  /* open the file  */
+    if (guarded)
+      pthread_mutex_unlock(&searchGuardLock);
     BUILDRXSTRING(retstr, ERROR_FILEOPEN);
     if(dir_buf)                        /* did we allocate ?          */
       free(dir_buf);                   /* free it                    */
     return VALID_ROUTINE;              /* finished                   */
   }
+  if (guarded && !filedata.mapped) {   /* read in, no guard needed   */
+    pthread_mutex_unlock(&searchGuardLock);
+    guarded = false;
+  }
+                                       /* found lines are copied out */
+                                       /* of the file data           */
+  values = (char *)malloc(SEARCH_BATCH * IBUF_LEN);
+  if (values == NULL) {
+    if (guarded)
+      pthread_mutex_unlock(&searchGuardLock);
+    CloseMappedFile(&filedata);
+    BUILDRXSTRING(retstr, ERROR_NOMEM);
+    if(dir_buf)                        /* did we allocate ?          */
+      free(dir_buf);                   /* free it                    */
+    return VALID_ROUTINE;
+  }
+  if (guarded) {
+    StartSearchGuard();
+    if (sigsetjmp(searchGuardJump, 1) != 0) {
+                                       /* the file shrank under us   */
+      EndSearchGuard();
+      free(values);
+      CloseMappedFile(&filedata);
+      BUILDRXSTRING(retstr, ERROR_FILEOPEN);
+      if(dir_buf)                      /* did we allocate ?          */
+        free(dir_buf);                 /* free it                    */
+      return VALID_ROUTINE;
+    }
+  }
 
-  line = (char *) malloc(4096 * sizeof(char));
+  data = filedata.data;
+  end = (const char *)memchr(data, CH_EOF, filedata.size);
+  if (end == NULL)                     /* data ends at any EOF mark  */
+    end = data + filedata.size;
+  scan = data;
+  counted = data;
                                        /* do the search...found lines*/
                                        /* are saved in stem vars     */
-  while (!GetLine(line, MAX_LINE_LEN - 1, &filedata)) {
-    len = strlen(line);
-    num++;
-
-    ptr = mystrstr(line, target, len, args[0].strlength, sensitive);
-    if (ptr != '\0') {
+  if (InitSearchTarget(&searchTarget, args[0].strptr, args[0].strlength, sensitive)) {
+    while (!failed && (hit = FindTarget(scan, end, &searchTarget)) != NULL) {
+                                       /* locate the enclosing line  */
+      lineStart = hit;
+      while (lineStart > scan && lineStart[-1] != CH_NL)
+        lineStart--;
+      lineEnd = (const char *)memchr(hit, CH_NL, end - hit);
+      if (lineEnd == NULL)
+        lineEnd = end;
+                                       /* apply the line rules: lines*/
+                                       /* are truncated, lose a CR   */
+                                       /* before the line feed, and  */
+                                       /* end at the first null      */
+      len = lineEnd - lineStart;
+      if (len > MAX_LINE_LEN - 1)
+        len = MAX_LINE_LEN - 1;
+      if (lineEnd < end && len > 0 && lineStart[len-1] == CH_CR)
+        len--;
+      const char *nul = (const char *)memchr(lineStart, '\0', len);
+      if (nul != NULL)
+        len = nul - lineStart;
+      scan = lineEnd < end ? lineEnd + 1 : end;
+                                       /* the match must be in the   */
+                                       /* part of the line kept      */
+      if ((size_t)(hit - lineStart) + searchTarget.length > len)
+        continue;
+
+      num += CountLines(counted, lineStart) + 1;
+      counted = scan;
+
+      SHVBLOCK *block = &shvb[batched];
+      char *varname = varnames[batched];
+      char *value = values + batched * IBUF_LEN;
+      len2 = 0;
       if (linenums) {
-        sprintf(ldp.ibuf, "%d ", (int)num);
-        len2 = strlen(ldp.ibuf);
-        memcpy(ldp.ibuf+len2, line, len < IBUF_LEN-len2 ? len : IBUF_LEN-len2);
-        ldp.vlen = IBUF_LEN < len+len2 ? IBUF_LEN : len + len2;
-      }
-      else {
-        memcpy(ldp.ibuf, line, len);
-        ldp.vlen = len;
+        sprintf(value, "%d ", (int)num);
+        len2 = strlen(value);
       }
-      ldp.count++;
-      sprintf(ldp.varname+ldp.stemlen, "%d", (int)ldp.count);
-      if (ldp.ibuf[ldp.vlen-1] == '\n')
-        ldp.vlen--;
-      ldp.shvb.shvnext = NULL;
-      ldp.shvb.shvname.strptr = ldp.varname;
-      ldp.shvb.shvname.strlength = strlen(ldp.varname);
-      ldp.shvb.shvnamelen = ldp.shvb.shvname.strlength;
-      ldp.shvb.shvvalue.strptr = ldp.ibuf;
-      ldp.shvb.shvvalue.strlength = ldp.vlen;
-      ldp.shvb.shvvaluelen = ldp.vlen;
-      ldp.shvb.shvcode = RXSHV_SET;
-      ldp.shvb.shvret = 0;
-      if (RexxVariablePool(&ldp.shvb) == RXSHV_BADN) {
-        CloseFile(&filedata);          /* close the file             */
-        if(dir_buf)                    /* did we allocate ?          */
-          free(dir_buf);               /* free it                    */
-        free(line);
-        return INVALID_ROUTINE;        /* error on non-zero          */
+      memcpy(value+len2, lineStart, len < IBUF_LEN-len2 ? len : IBUF_LEN-len2);
+      block->shvvalue.strptr = value;
+      block->shvvalue.strlength = IBUF_LEN < len+len2 ? IBUF_LEN : len + len2;
+      count++;
+      sprintf(varname, "%s%d", stemname, (int)count);
+      block->shvnext = NULL;
+      block->shvname.strptr = varname;
+      block->shvname.strlength = strlen(varname);
+      block->shvnamelen = block->shvname.strlength;
+      block->shvvaluelen = block->shvvalue.strlength;
+      block->shvcode = RXSHV_SET;
+      block->shvret = 0;
+      if (batched > 0)
+        shvb[batched-1].shvnext = block;
+                                       /* set a full batch at once   */
+      if (++batched == SEARCH_BATCH) {
+        failed = (RexxVariablePool(shvb) & RXSHV_BADN) != 0;
+        batched = 0;
       }
     }
   }
-  free(line);
-  CloseFile(&filedata);                /* Close that file            */
+  if (guarded)                         /* done with the mapped data  */
+    EndSearchGuard();
+                                       /* set any remaining entries  */
+  if (!failed && batched > 0)
+    failed = (RexxVariablePool(shvb) & RXSHV_BADN) != 0;
+  free(values);
+  CloseMappedFile(&filedata);          /* Close that file            */
+  if (failed) {
+    if(dir_buf)                        /* did we allocate ?          */
+      free(dir_buf);                   /* free it                    */
+    return INVALID_ROUTINE;            /* error on non-zero          */
+  }
                                        /* set stem.0 to lines read   */
-  sprintf(ldp.ibuf, "%d", (int)ldp.count);
-  ldp.varname[ldp.stemlen] = '0';
-  ldp.varname[ldp.stemlen+1] = 0;
-  ldp.shvb.shvnext = NULL;
-  ldp.shvb.shvname.strptr = ldp.varname;
-  ldp.shvb.shvname.strlength = ldp.stemlen+1;
-  ldp.shvb.shvnamelen = ldp.stemlen+1;
-  ldp.shvb.shvvalue.strptr = ldp.ibuf;
-  ldp.shvb.shvvalue.strlength = strlen(ldp.ibuf);
-  ldp.shvb.shvvaluelen = ldp.shvb.shvvalue.strlength;
-  ldp.shvb.shvcode = RXSHV_SET;
-  ldp.shvb.shvret = 0;
-  if (RexxVariablePool(&ldp.shvb) == RXSHV_BADN){
+  sprintf(countbuf, "%d", (int)count);
+  sprintf(varnames[0], "%s0", stemname);
+  shvb[0].shvnext = NULL;
+  shvb[0].shvname.strptr = varnames[0];
+  shvb[0].shvname.strlength = stemlen+1;
+  shvb[0].shvnamelen = stemlen+1;
+  shvb[0].shvvalue.strptr = countbuf;
+  shvb[0].shvvalue.strlength = strlen(countbuf);
+  shvb[0].shvvaluelen = shvb[0].shvvalue.strlength;
+  shvb[0].shvcode = RXSHV_SET;
+  shvb[0].shvret = 0;
+  if (RexxVariablePool(&shvb[0]) == RXSHV_BADN){
     if(dir_buf)                        /* did we allocate ?          */
       free(dir_buf);                   /* free it                    */
     return INVALID_ROUTINE;            /* error on non-zero          */
@@ -664,6 +664,16 @@ REXX_TYPED_ROUTINE_PROTOTYPE(SockShutDown);
 REXX_TYPED_ROUTINE_PROTOTYPE(SockSock_Errno);
 REXX_TYPED_ROUTINE_PROTOTYPE(SockSocket);
 REXX_TYPED_ROUTINE_PROTOTYPE(SockSoClose);
+REXX_TYPED_ROUTINE_PROTOTYPE(SockRecvBuffer);
+REXX_TYPED_ROUTINE_PROTOTYPE(SockSendBuffer);
+#if defined(HAVE_SYS_EPOLL_H)
+REXX_TYPED_ROUTINE_PROTOTYPE(SockPollCreate);
+REXX_TYPED_ROUTINE_PROTOTYPE(SockPollAdd);
+REXX_TYPED_ROUTINE_PROTOTYPE(SockPollModify);
+REXX_TYPED_ROUTINE_PROTOTYPE(SockPollRemove);
+REXX_TYPED_ROUTINE_PROTOTYPE(SockPollWait);
+REXX_TYPED_ROUTINE_PROTOTYPE(SockPollClose);
+#endif
 
 
 // now build the actual entry list
@@ -697,6 +707,16 @@ RexxRoutineEntry rxsock_functions[] =
     REXX_TYPED_ROUTINE( SockSocket,         SockSocket),
     REXX_TYPED_ROUTINE( SockSoClose,        SockSoClose),
     REXX_TYPED_ROUTINE( SockVersion,        SockVersion),
+    REXX_TYPED_ROUTINE( SockRecvBuffer,     SockRecvBuffer),
+    REXX_TYPED_ROUTINE( SockSendBuffer,     SockSendBuffer),
+#if defined(HAVE_SYS_EPOLL_H)
+    REXX_TYPED_ROUTINE( SockPollCreate,     SockPollCreate),
+    REXX_TYPED_ROUTINE( SockPollAdd,        SockPollAdd),
+    REXX_TYPED_ROUTINE( SockPollModify,     SockPollModify),
+    REXX_TYPED_ROUTINE( SockPollRemove,     SockPollRemove),
+    REXX_TYPED_ROUTINE( SockPollWait,       SockPollWait),
+    REXX_TYPED_ROUTINE( SockPollClose,      SockPollClose),
+#endif
     REXX_LAST_ROUTINE()
 };
 
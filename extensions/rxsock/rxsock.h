@@ -52,6 +52,15 @@ typedef struct in_addr     in_addr;
 typedef int socklen_t;
 #endif
 
+#if defined(MSG_DONTWAIT)
+#define RXSOCK_NONBLOCKING MSG_DONTWAIT   // per-call non-blocking flag
+#else
+#define RXSOCK_NONBLOCKING 0
+#endif
+
+#define RXSOCK_BUFFER_CHUNK 65536         // default SockRecvBuffer size
+#define RXSOCK_POLL_EVENTS  1024          // default SockPollWait batch
+
 class StemManager;
 
 
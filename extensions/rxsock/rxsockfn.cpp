@@ -79,6 +79,9 @@
 #if defined( HAVE_SYS_FILIO_H )
 #include <sys/filio.h>
 #endif
+#if defined( HAVE_SYS_EPOLL_H )
+#include <sys/epoll.h>
+#endif
 #endif
 
 #define psock_errno(s) fprintf(stderr, "RxSOCK Error: %s\n", s)
@@ -1342,3 +1345,383 @@ RexxRoutine1(int, SockSoClose, int, sock)
     return rc;
 }
 
+
+/*-/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\-*/
+/*-\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/-*/
+
+/*------------------------------------------------------------------
+ * recv() directly into a MutableBuffer
+ *
+ * The received data is appended to the end of the buffer, so no
+ * intermediate string is created.  The call does not block; if no
+ * data is available it returns -1 with errno set to EAGAIN.
+ *------------------------------------------------------------------*/
+RexxRoutine4(int, SockRecvBuffer, int, sock, RexxMutableBufferObject, buffer, OPTIONAL_int, dataLen, OPTIONAL_CSTRING, flagVal)
+{
+    if (argumentOmitted(3))
+    {
+        dataLen = RXSOCK_BUFFER_CHUNK;
+    }
+    else if (dataLen < 0)
+    {
+        context->InvalidRoutine();
+        return 0;
+    }
+
+    /*---------------------------------------------------------------
+     * get flags
+     *---------------------------------------------------------------*/
+    int flags = RXSOCK_NONBLOCKING;
+    if (flagVal != NULL)
+    {
+        char *flagStr = strdup(flagVal);
+        if (flagStr == NULL)
+        {
+            context->InvalidRoutine();
+            return 0;
+        }
+        const char *pszWord = strtok(flagStr, " ");
+        while (pszWord)
+        {
+            if (!caselessCompare(pszWord,"MSG_OOB"))  flags |= MSG_OOB;
+            else if (!caselessCompare(pszWord,"MSG_PEEK")) flags |= MSG_PEEK;
+            pszWord = strtok(NULL," ");
+        }
+        free(flagStr);
+    }
+
+    /*---------------------------------------------------------------
+     * make room at the end of the buffer.  Extending the length
+     * pads the buffer, so this must happen before the receive.
+     *---------------------------------------------------------------*/
+    size_t length = context->MutableBufferLength(buffer);
+    if (context->MutableBufferCapacity(buffer) < length + dataLen)
+    {
+        context->SetMutableBufferCapacity(buffer, length + dataLen);
+    }
+    context->SetMutableBufferLength(buffer, length + dataLen);
+    char *pBuffer = (char *)context->MutableBufferData(buffer);
+
+    /*---------------------------------------------------------------
+     * call function
+     *---------------------------------------------------------------*/
+    int rc = recv(sock, pBuffer + length, dataLen, flags);
+
+    // set the errno information
+    cleanup(context);
+
+    // trim the buffer back to the data actually received
+    context->SetMutableBufferLength(buffer, rc > 0 ? length + rc : length);
+
+    /*---------------------------------------------------------------
+     * set return code
+     *---------------------------------------------------------------*/
+    return rc;
+}
+
+/*-/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\-*/
+/*-\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/-*/
+
+/*------------------------------------------------------------------
+ * send() directly from a MutableBuffer
+ *
+ * Sends length bytes starting at position start of the buffer
+ * (default is the entire buffer).  The call does not block; the
+ * return value is the number of bytes actually sent, which may be
+ * less than requested, or -1 with errno set to EAGAIN.
+ *------------------------------------------------------------------*/
+RexxRoutine5(int, SockSendBuffer, int, sock, RexxMutableBufferObject, buffer, OPTIONAL_size_t, start, OPTIONAL_size_t, dataLen, OPTIONAL_CSTRING, flagArg)
+{
+    size_t length = context->MutableBufferLength(buffer);
+
+    if (argumentOmitted(3))
+    {
+        start = 1;
+    }
+    if (start == 0)
+    {
+        context->InvalidRoutine();
+        return 0;
+    }
+    // starting past the end sends nothing
+    if (start > length)
+    {
+        dataLen = 0;
+    }
+    else if (argumentOmitted(4) || dataLen > length - start + 1)
+    {
+        dataLen = length - start + 1;
+    }
+
+    /*---------------------------------------------------------------
+     * get flags
+     *---------------------------------------------------------------*/
+    int flags = RXSOCK_NONBLOCKING;
+    if (flagArg != NULL)
+    {
+        char *flagStr = strdup(flagArg);
+        if (flagStr == NULL)
+        {
+            context->InvalidRoutine();
+            return 0;
+        }
+
+        const char *pszWord = strtok(flagStr, " ");
+        while (pszWord)
+        {
+            if (!caselessCompare(pszWord,"MSG_OOB"))
+            {
+                flags |= MSG_OOB;
+            }
+            else if (!caselessCompare(pszWord,"MSG_DONTROUTE"))
+            {
+                flags |= MSG_DONTROUTE;
+            }
+
+            pszWord = strtok(NULL," ");
+        }
+        free(flagStr);
+    }
+
+    const char *data = (const char *)context->MutableBufferData(buffer);
+
+    /*---------------------------------------------------------------
+     * call function
+     *---------------------------------------------------------------*/
+    int rc = send(sock, data + start - 1, dataLen, flags);
+
+    // set the errno information
+    cleanup(context);
+
+    /*---------------------------------------------------------------
+     * set return code
+     *---------------------------------------------------------------*/
+    return rc;
+}
+
+#if defined(HAVE_SYS_EPOLL_H)
+
+/*-/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\-*/
+/*-\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/-*/
+
+/*------------------------------------------------------------------
+ * convert a blank delimited list of event names into epoll flags
+ *------------------------------------------------------------------*/
+static bool stringToPollEvents(const char *eventArg, uint32_t &events)
+{
+    events = 0;
+    char *eventStr = strdup(eventArg);
+    if (eventStr == NULL)
+    {
+        return false;
+    }
+
+    bool valid = true;
+    const char *pszWord = strtok(eventStr, " ");
+    while (pszWord)
+    {
+        if (!caselessCompare(pszWord,"READ"))          events |= EPOLLIN;
+        else if (!caselessCompare(pszWord,"WRITE"))    events |= EPOLLOUT;
+        else if (!caselessCompare(pszWord,"PRIORITY")) events |= EPOLLPRI;
+        else if (!caselessCompare(pszWord,"EDGE"))     events |= EPOLLET;
+        else if (!caselessCompare(pszWord,"ONESHOT"))  events |= EPOLLONESHOT;
+        else
+        {
+            valid = false;
+        }
+        pszWord = strtok(NULL, " ");
+    }
+    free(eventStr);
+    return valid;
+}
+
+
+/*------------------------------------------------------------------
+ * convert epoll flags into a blank delimited list of event names
+ *------------------------------------------------------------------*/
+static void pollEventsToString(uint32_t events, char *eventStr)
+{
+    *eventStr = '\0';
+    if (events & EPOLLIN)  strcat(eventStr, "READ ");
+    if (events & EPOLLOUT) strcat(eventStr, "WRITE ");
+    if (events & EPOLLPRI) strcat(eventStr, "PRIORITY ");
+    if (events & EPOLLERR) strcat(eventStr, "ERROR ");
+    if (events & EPOLLHUP) strcat(eventStr, "HANGUP ");
+
+    // remove the trailing blank
+    size_t len = strlen(eventStr);
+    if (len > 0)
+    {
+        eventStr[len - 1] = '\0';
+    }
+}
+
+
+/*-/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\-*/
+/*-\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/-*/
+
+/*------------------------------------------------------------------
+ * create a persistent poller (epoll_create())
+ *
+ * Unlike SockSelect, the set of watched sockets is kept by the
+ * poller between calls, so the cost of a wait is proportional to
+ * the number of ready sockets rather than the number watched.
+ *------------------------------------------------------------------*/
+RexxRoutine0(int, SockPollCreate)
+{
+    int rc = epoll_create1(EPOLL_CLOEXEC);
+
+    // set the errno information
+    cleanup(context);
+    return rc;
+}
+
+/*-/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\-*/
+/*-\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/-*/
+
+/*------------------------------------------------------------------
+ * common handling for adding or modifying a poller socket
+ *------------------------------------------------------------------*/
+static int pollControl(RexxCallContext *context, int op, int poller, int sock, CSTRING eventArg)
+{
+    struct epoll_event event;
+    uint32_t events;
+
+    if (!stringToPollEvents(eventArg == NULL ? "READ" : eventArg, events))
+    {
+        context->InvalidRoutine();
+        return 0;
+    }
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.fd = sock;
+
+    int rc = epoll_ctl(poller, op, sock, &event);
+
+    // set the errno information
+    cleanup(context);
+    return rc;
+}
+
+/*------------------------------------------------------------------
+ * add a socket to a poller (epoll_ctl(EPOLL_CTL_ADD))
+ *------------------------------------------------------------------*/
+RexxRoutine3(int, SockPollAdd, int, poller, int, sock, OPTIONAL_CSTRING, eventArg)
+{
+    return pollControl(context, EPOLL_CTL_ADD, poller, sock, eventArg);
+}
+
+/*------------------------------------------------------------------
+ * change the events watched for a socket (epoll_ctl(EPOLL_CTL_MOD))
+ *------------------------------------------------------------------*/
+RexxRoutine3(int, SockPollModify, int, poller, int, sock, OPTIONAL_CSTRING, eventArg)
+{
+    return pollControl(context, EPOLL_CTL_MOD, poller, sock, eventArg);
+}
+
+/*------------------------------------------------------------------
+ * remove a socket from a poller (epoll_ctl(EPOLL_CTL_DEL))
+ *------------------------------------------------------------------*/
+RexxRoutine2(int, SockPollRemove, int, poller, int, sock)
+{
+    struct epoll_event event;
+
+    // older kernels require a non-NULL event even though it is ignored
+    memset(&event, 0, sizeof(event));
+    int rc = epoll_ctl(poller, EPOLL_CTL_DEL, sock, &event);
+
+    // set the errno information
+    cleanup(context);
+    return rc;
+}
+
+/*-/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\-*/
+/*-\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/-*/
+
+/*------------------------------------------------------------------
+ * wait for poller sockets to become ready (epoll_wait())
+ *
+ * The timeout is in milliseconds; if omitted the wait is
+ * indefinite.  Returns an array of the ready sockets.  If an array
+ * is given as the third argument, the ready events for each socket
+ * are stored at the matching index as a blank delimited list of
+ * READ, WRITE, PRIORITY, ERROR and HANGUP.
+ *------------------------------------------------------------------*/
+RexxRoutine4(RexxArrayObject, SockPollWait, int, poller, OPTIONAL_int, timeout, OPTIONAL_RexxArrayObject, eventArray, OPTIONAL_int, maxEvents)
+{
+    if (argumentOmitted(2) || timeout < 0)
+    {
+        timeout = -1;
+    }
+    if (argumentOmitted(4) || maxEvents <= 0)
+    {
+        maxEvents = RXSOCK_POLL_EVENTS;
+    }
+
+    struct epoll_event *events = (struct epoll_event *)malloc(sizeof(struct epoll_event) * maxEvents);
+    if (events == NULL)
+    {
+        context->InvalidRoutine();
+        return NULLOBJECT;
+    }
+
+    // don't leave stale entries from a previous wait behind, even if
+    // this one times out or fails
+    if (eventArray != NULLOBJECT)
+    {
+        context->SendMessage0(eventArray, "EMPTY");
+    }
+
+    int rc = epoll_wait(poller, events, maxEvents, timeout);
+
+    // set the errno information
+    cleanup(context);
+
+    RexxArrayObject ready = context->NewArray(rc > 0 ? rc : 0);
+    if (rc > 0)
+    {
+        RexxObjectPtr *sockets = (RexxObjectPtr *)malloc(sizeof(RexxObjectPtr) * rc);
+        if (sockets == NULL)
+        {
+            free(events);
+            context->InvalidRoutine();
+            return NULLOBJECT;
+        }
+        for (int i = 0; i < rc; i++)
+        {
+            sockets[i] = context->Int32ToObject(events[i].data.fd);
+        }
+        context->ArrayPutRange(ready, 1, sockets, rc);
+
+        if (eventArray != NULLOBJECT)
+        {
+            char eventStr[64];
+            for (int i = 0; i < rc; i++)
+            {
+                pollEventsToString(events[i].events, eventStr);
+                sockets[i] = context->String(eventStr);
+            }
+            context->ArrayPutRange(eventArray, 1, sockets, rc);
+        }
+        free(sockets);
+    }
+    free(events);
+    return ready;
+}
+
+/*-/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\-*/
+/*-\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/\/-*/
+
+/*------------------------------------------------------------------
+ * close a poller
+ *------------------------------------------------------------------*/
+RexxRoutine1(int, SockPollClose, int, poller)
+{
+    int rc = close(poller);
+
+    // set the errno information
+    cleanup(context);
+    return rc;
+}
+
+#endif
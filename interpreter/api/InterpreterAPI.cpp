@@ -199,6 +199,34 @@ RexxReturnCode REXXENTRY RexxTranslateProgram(const char *inFile, const char *ou
 }
 
 
+/**
+ * Translate a program, along with all of the ::REQUIRES files
+ * it needs, and store the translated results in a single
+ * external file.
+ *
+ * @param inFile  The input source file.
+ * @param outFile The output source.
+ * @param exits   The exits to use during the translation process.
+ *
+ * @return The error return code (if any).
+ */
+RexxReturnCode REXXENTRY RexxTranslateBundledProgram(const char *inFile, const char *outFile, PRXSYSEXIT exits)
+{
+    TranslateDispatcher arguments;
+    arguments.programName = inFile;
+    arguments.instore = NULL;
+    arguments.outputName = outFile;
+    arguments.bundleRequires = true;
+    arguments.invoke(exits, NULL);
+
+    // terminate and clean up the interpreter runtime.  This only works
+    // if there are no active instances
+    Interpreter::terminateInterpreter();
+
+    return (RexxReturnCode)arguments.rc;
+}
+
+
 /**
  * Translate a program and store the translated results in an
  * external file.
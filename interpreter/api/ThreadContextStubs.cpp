@@ -66,6 +66,7 @@
 #include "LanguageParser.hpp"
 #include "StemClass.hpp"
 #include "NumberStringClass.hpp"
+#include "ObjectSerializer.hpp"
 
 BEGIN_EXTERN_C()
 
@@ -1952,6 +1953,205 @@ logical_t RexxEntry IsMutableBuffer(RexxThreadContext *c, RexxObjectPtr o)
     return false;
 }
 
+void RexxEntry SetStemElements(RexxThreadContext *c, RexxStemObject s, CSTRING *n, RexxObjectPtr *v, size_t count)
+{
+    ApiContext context(c);
+    try
+    {
+        ((StemClass *)s)->setElements(n, (RexxObject **)v, count);
+    }
+    catch (NativeActivation *)
+    {
+    }
+}
+
+size_t RexxEntry GetStemElements(RexxThreadContext *c, RexxStemObject s, CSTRING *n, RexxObjectPtr *v, size_t count)
+{
+    ApiContext context(c);
+    try
+    {
+        size_t found = ((StemClass *)s)->getElements(n, (RexxObject **)v, count);
+        // a single array anchors all of the returned values rather than
+        // creating a local reference for each one.
+        context.ret(new_array(count, (RexxObject **)v));
+        return found;
+    }
+    catch (NativeActivation *)
+    {
+    }
+    return 0;
+}
+
+void RexxEntry SetStemArrayElements(RexxThreadContext *c, RexxStemObject s, size_t i, RexxObjectPtr *v, size_t count)
+{
+    ApiContext context(c);
+    try
+    {
+        ((StemClass *)s)->setArrayElements(i, (RexxObject **)v, count);
+    }
+    catch (NativeActivation *)
+    {
+    }
+}
+
+size_t RexxEntry GetStemArrayElements(RexxThreadContext *c, RexxStemObject s, size_t i, RexxObjectPtr *v, size_t count)
+{
+    ApiContext context(c);
+    try
+    {
+        size_t found = ((StemClass *)s)->getArrayElements(i, (RexxObject **)v, count);
+        context.ret(new_array(count, (RexxObject **)v));
+        return found;
+    }
+    catch (NativeActivation *)
+    {
+    }
+    return 0;
+}
+
+size_t RexxEntry GetStemElementSnapshot(RexxThreadContext *c, RexxStemObject s, RexxStemElement *e, size_t count)
+{
+    ApiContext context(c);
+    try
+    {
+        // the snapshot holds alternating name/value pairs and keeps all of
+        // the returned objects alive as a single local reference.
+        ArrayClass *snapshot = ((StemClass *)s)->elementSnapshot();
+        context.ret(snapshot);
+        size_t items = snapshot->items() / 2;
+        size_t returned = Numerics::minVal(items, count);
+        for (size_t i = 0; i < returned; i++)
+        {
+            RexxString *name = (RexxString *)snapshot->get(i * 2 + 1);
+            e[i].name = name->getStringData();
+            e[i].nameLength = name->getLength();
+            e[i].value = (RexxObjectPtr)snapshot->get(i * 2 + 2);
+        }
+        // return the full count so the caller can size a buffer
+        return items;
+    }
+    catch (NativeActivation *)
+    {
+    }
+    return 0;
+}
+
+void RexxEntry ArrayPutRange(RexxThreadContext *c, RexxArrayObject a, size_t i, RexxObjectPtr *v, size_t count)
+{
+    ApiContext context(c);
+    try
+    {
+        if (i == 0)
+        {
+            reportException(Error_Incorrect_method_positive, 2);
+        }
+        ((ArrayClass *)a)->putRange((RexxInternalObject **)v, i, count);
+    }
+    catch (NativeActivation *)
+    {
+    }
+}
+
+size_t RexxEntry ArrayAtRange(RexxThreadContext *c, RexxArrayObject a, size_t i, RexxObjectPtr *v, size_t count)
+{
+    ApiContext context(c);
+    try
+    {
+        if (i == 0)
+        {
+            reportException(Error_Incorrect_method_positive, 1);
+        }
+        size_t found = ((ArrayClass *)a)->getRange((RexxInternalObject **)v, i, count);
+        context.ret(new_array(count, (RexxInternalObject **)v));
+        return found;
+    }
+    catch (NativeActivation *)
+    {
+    }
+    return 0;
+}
+
+RexxArrayObject RexxEntry NewStringArray(RexxThreadContext *c, CSTRING b, const size_t *offsets, size_t count)
+{
+    ApiContext context(c);
+    try
+    {
+        // the offsets array has count + 1 entries, with the final entry
+        // marking the end of the last string.
+        ArrayClass *result = new_array(count);
+        ProtectedObject p(result);
+        for (size_t i = 0; i < count; i++)
+        {
+            result->put(new_string(b + offsets[i], offsets[i + 1] - offsets[i]), i + 1);
+        }
+        return (RexxArrayObject)context.ret(result);
+    }
+    catch (NativeActivation *)
+    {
+    }
+    return NULLOBJECT;
+}
+
+RexxBufferObject RexxEntry SerializeObject(RexxThreadContext *c, RexxObjectPtr o)
+{
+    ApiContext context(c);
+    try
+    {
+        return (RexxBufferObject)context.ret((RexxObject *)ObjectSerializer::serialize((RexxObject *)o));
+    }
+    catch (NativeActivation *)
+    {
+    }
+    return NULLOBJECT;
+}
+
+
+RexxObjectPtr RexxEntry DeserializeObject(RexxThreadContext *c, RexxPackageObject p, CSTRING d, size_t l)
+{
+    ApiContext context(c);
+    try
+    {
+        return (RexxObjectPtr)context.ret(ObjectSerializer::deserialize(d, l, (PackageClass *)p));
+    }
+    catch (NativeActivation *)
+    {
+    }
+    return NULLOBJECT;
+}
+
+
+logical_t RexxEntry SerializeObjectToFile(RexxThreadContext *c, RexxObjectPtr o, CSTRING n)
+{
+    ApiContext context(c);
+    try
+    {
+        RexxString *name = new_string(n);
+        ProtectedObject p(name);
+        ObjectSerializer::save((RexxObject *)o, name);
+        return true;
+    }
+    catch (NativeActivation *)
+    {
+    }
+    return false;
+}
+
+
+RexxObjectPtr RexxEntry DeserializeObjectFromFile(RexxThreadContext *c, RexxPackageObject p, CSTRING n)
+{
+    ApiContext context(c);
+    try
+    {
+        RexxString *name = new_string(n);
+        ProtectedObject p1(name);
+        return (RexxObjectPtr)context.ret(ObjectSerializer::restore(name, (PackageClass *)p));
+    }
+    catch (NativeActivation *)
+    {
+    }
+    return NULLOBJECT;
+}
+
 END_EXTERN_C()
 
 RexxThreadInterface Activity::threadContextFunctions =
@@ -2107,4 +2307,16 @@ RexxThreadInterface Activity::threadContextFunctions =
     IsMutableBuffer,
     MutableBufferCapacity,
     SetMutableBufferCapacity,
+    SetStemElements,
+    GetStemElements,
+    SetStemArrayElements,
+    GetStemArrayElements,
+    GetStemElementSnapshot,
+    ArrayPutRange,
+    ArrayAtRange,
+    NewStringArray,
+    SerializeObject,
+    DeserializeObject,
+    SerializeObjectToFile,
+    DeserializeObjectFromFile,
 };
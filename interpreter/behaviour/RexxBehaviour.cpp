@@ -143,7 +143,16 @@ void RexxBehaviour::flatten(Envelope *envelope)
 {
     setUpFlatten(RexxBehaviour)
 
-    flattenRef(methodDictionary);
+    // an object serialization restores the behaviour from the owning
+    // class, so only the class reference needs to be carried along.
+    if (envelope->isSerializing())
+    {
+        newThis->methodDictionary = OREF_NULL;
+    }
+    else
+    {
+        flattenRef(methodDictionary);
+    }
     flattenRef(owningClass);
 
     // if this is a non-primitive behaviour, we need to mark this for restore
@@ -156,6 +165,21 @@ void RexxBehaviour::flatten(Envelope *envelope)
 }
 
 
+/**
+ * Check a behaviour from a flattened buffer.  Only non-primitive
+ * behaviours get flattened, and these always need resolving.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if the behaviour can be unflattened.
+ */
+bool RexxBehaviour::isValidFlattened(ValidatingMarkHandler &image)
+{
+    return getObjectSize() >= sizeof(RexxBehaviour) && (size_t)classType <= T_Last_Internal_Class &&
+        isNonPrimitive() && isNotResolved();
+}
+
+
 /**
  * Set a new method dictionary in the behaviour.
  *
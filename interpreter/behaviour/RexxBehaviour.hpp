@@ -62,6 +62,7 @@ class RexxBehaviour : public RexxInternalObject
     virtual void live(size_t);
     virtual void liveGeneral(MarkReason reason);
     virtual void flatten(Envelope*);
+    virtual bool isValidFlattened(ValidatingMarkHandler &);
     virtual RexxInternalObject *copy();
 
     void         copyBehaviour();
@@ -149,6 +150,23 @@ class RexxBehaviour : public RexxInternalObject
         return &primitiveBehaviours[behaviourID];          // translate back into proper behaviour
     }
 
+    // the class type of a saved primitive behaviour, or SIZE_MAX if this
+    // does not identify a class that can appear in a flattened buffer.
+    static inline size_t savedPrimitiveClassType(RexxBehaviour *b)
+    {
+        uintptr_t behaviourID = (uintptr_t)b;
+        if ((behaviourID & INTERNALCLASS) != 0)
+        {
+            behaviourID &= ~INTERNALCLASS;
+            if (behaviourID == 0 || behaviourID > T_Last_Internal_Class - T_Last_Exported_Class)
+            {
+                return SIZE_MAX;
+            }
+            return behaviourID + T_Last_Exported_Class;
+        }
+        return behaviourID <= T_Last_Exported_Class ? behaviourID : SIZE_MAX;
+    }
+
     inline PCPPM getOperatorMethod(size_t index) { return operatorMethods[index]; }
     static inline RexxBehaviour *getPrimitiveBehaviour(size_t index) { return &primitiveBehaviours[index]; }
     static inline PCPPM *getOperatorMethods(size_t index) { return getPrimitiveBehaviour(index)->operatorMethods; }
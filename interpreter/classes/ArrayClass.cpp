@@ -55,6 +55,11 @@
 #include "MutableBufferClass.hpp"
 #include "ProtectedObject.hpp"
 #include "MethodArguments.hpp"
+#include "IntegerClass.hpp"
+#include "NumberStringClass.hpp"
+#include "PackageClass.hpp"
+#include "StringUtil.hpp"
+#include "SysThread.hpp"
 
 // singleton class instance
 RexxClass *ArrayClass::classInstance = OREF_NULL;
@@ -353,6 +358,9 @@ RexxInternalObject *ArrayClass::copy()
         // make sure the new array is updated to point to itself
         newArray->expansionArray = newArray;
     }
+    // the copy is not being iterated by anybody
+    newArray->iterationSnapshot = OREF_NULL;
+    newArray->iterationLoops = 0;
     return newArray;
 }
 
@@ -367,6 +375,7 @@ void ArrayClass::live(size_t liveMark)
     memory_mark(dimensions);
     memory_mark(objectVariables);
     memory_mark(expansionArray);
+    memory_mark(iterationSnapshot);
 
     // if we expand, we adjust the expansion size down so we don't overrun.
     // but we need to mark our space too, since we could be the expansion array.
@@ -387,6 +396,7 @@ void ArrayClass::liveGeneral(MarkReason reason)
     memory_mark_general(dimensions);
     memory_mark_general(objectVariables);
     memory_mark_general(expansionArray);
+    memory_mark_general(iterationSnapshot);
 
     // if we expand, we adjust the expansion size down so we don't overrun.
     // but we need to mark our space too.
@@ -399,6 +409,7 @@ void ArrayClass::flatten(Envelope *envelope)
     flattenRef(dimensions);
     flattenRef(objectVariables);
     flattenRef(expansionArray);
+    flattenRef(iterationSnapshot);
 
     flattenArrayRefs(arraySize, objects);
 
@@ -406,6 +417,86 @@ void ArrayClass::flatten(Envelope *envelope)
 }
 
 
+/**
+ * Check an array from a flattened buffer.  The item slots used
+ * by the array are held by the expansion array, and the
+ * dimensions must describe exactly that many items.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if the array can be unflattened.
+ */
+bool ArrayClass::isValidFlattened(ValidatingMarkHandler &image)
+{
+    // the offset of this object, for recognizing self references
+    RexxInternalObject *self = image.offsetOf(this);
+
+    // an expansion array (or an unexpanded one) holds its own items
+    if (expansionArray == OREF_NULL || expansionArray == self)
+    {
+        if (arraySize > maximumSize || !fitsInObject(objects, maximumSize, sizeof(RexxInternalObject *)))
+        {
+            return false;
+        }
+    }
+    // an expanded array has no items of its own
+    else
+    {
+        if (arraySize != 0 || image.typeOf(expansionArray) != T_Array)
+        {
+            return false;
+        }
+        ArrayClass *expansion = (ArrayClass *)image.resolve(expansionArray);
+        // the expansion array checks its own slots
+        if (expansion->expansionArray != OREF_NULL || maximumSize != expansion->maximumSize)
+        {
+            return false;
+        }
+    }
+
+    // the remaining checks apply to arrays with a visible size
+    if (expansionArray == OREF_NULL)
+    {
+        return true;
+    }
+    size_t items = expansionArray == self ? arraySize : ((ArrayClass *)image.resolve(expansionArray))->arraySize;
+    if (lastItem > items || itemCount > items)
+    {
+        return false;
+    }
+    if (iterationSnapshot != OREF_NULL && image.typeOf(iterationSnapshot) != T_Array)
+    {
+        return false;
+    }
+
+    if (dimensions != OREF_NULL)
+    {
+        if (image.typeOf(dimensions) != T_NumberArray)
+        {
+            return false;
+        }
+        // the product of the dimensions must match the item count
+        NumberArray *dims = (NumberArray *)image.resolve(dimensions);
+        if (!dims->isValidFlattened(image))
+        {
+            return false;
+        }
+        size_t product = 1;
+        for (size_t i = 1; i <= dims->size(); i++)
+        {
+            size_t dimension = dims->get(i);
+            if (dimension != 0 && product > SIZE_MAX / dimension)
+            {
+                return false;
+            }
+            product *= dimension;
+        }
+        return product == items;
+    }
+    return true;
+}
+
+
 /**
  * Check and raise an error for a operation that is not
  * permitted on a multi-dimensioal array.
@@ -430,6 +521,7 @@ void ArrayClass::checkMultiDimensional(const char *methodName)
  */
 inline void ArrayClass::setItem(size_t position, RexxInternalObject *value)
 {
+    checkIterationSnapshot();
     setOtherField(expansionArray, objects[position - 1], value);
 }
 
@@ -442,6 +534,7 @@ inline void ArrayClass::setItem(size_t position, RexxInternalObject *value)
  */
 inline void ArrayClass::clearItem(size_t position)
 {
+    checkIterationSnapshot();
     setOtherField(expansionArray, objects[position - 1], OREF_NULL);
 }
 
@@ -564,6 +657,114 @@ void ArrayClass::put(RexxInternalObject *value, size_t pos)
 }
 
 
+/**
+ * Get the snapshot token for a DO OVER loop over this array.
+ * The loop iterates the array directly for as long as this
+ * token is still the current one.  If the array is changed
+ * while a loop is running, the current contents are copied into
+ * the token first, and the loop continues with that copy.
+ * Loops started while the array is unchanged share the token.
+ *
+ * @return The snapshot token.
+ */
+ArrayClass *ArrayClass::getIterationSnapshot()
+{
+    if (iterationSnapshot == OREF_NULL)
+    {
+        ArrayClass *snapshot = new_array((size_t)0);
+        setField(iterationSnapshot, snapshot);
+    }
+    iterationLoops++;
+    return iterationSnapshot;
+}
+
+
+/**
+ * Give back a snapshot token when a DO OVER loop ends.  When
+ * the last loop using the current token has finished, the token
+ * is dropped so later changes do not copy the array for nobody.
+ *
+ * @param snapshot The token obtained from getIterationSnapshot().
+ */
+void ArrayClass::releaseIterationSnapshot(ArrayClass *snapshot)
+{
+    // a token that has already been filled in belongs to the loops alone
+    if (iterationSnapshot == snapshot && --iterationLoops == 0)
+    {
+        setField(iterationSnapshot, OREF_NULL);
+    }
+}
+
+
+/**
+ * Copy the array contents into the pending DO OVER snapshot
+ * before the array is changed.  The items keep their index
+ * positions so the loops can continue where they are.
+ */
+void ArrayClass::freezeIterationSnapshot()
+{
+    // the copy allocates, so keep the snapshot anchored to us until
+    // it is filled in.  The snapshot has no snapshot of its own, so
+    // filling it does not recurse.
+    iterationSnapshot->putRange(data(), 1, lastItem);
+    setField(iterationSnapshot, OREF_NULL);
+    iterationLoops = 0;
+}
+
+
+/**
+ * Store a block of items into the array as the result of a bulk
+ * api call.  The array is expanded once for the entire range
+ * rather than once per item.
+ *
+ * @param values The array of values to store.  A NULL value clears
+ *               the corresponding array slot.
+ * @param start  The index of the first slot to set (origin 1).
+ * @param count  The number of values to store.
+ */
+void ArrayClass::putRange(RexxInternalObject **values, size_t start, size_t count)
+{
+    // nothing to do, nothing to extend
+    if (count == 0)
+    {
+        return;
+    }
+
+    ensureSpace(start + count - 1);
+    for (size_t i = 0; i < count; i++)
+    {
+        setOrClearArrayItem(start + i, values[i]);
+    }
+}
+
+
+/**
+ * Retrieve a block of items from the array as the result of a
+ * bulk api call.
+ *
+ * @param values The buffer that receives the items.  Empty or
+ *               out-of-bounds slots are returned as NULL.
+ * @param start  The index of the first slot to retrieve (origin 1).
+ * @param count  The number of slots to retrieve.
+ *
+ * @return The number of non-empty items returned.
+ */
+size_t ArrayClass::getRange(RexxInternalObject **values, size_t start, size_t count)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        RexxInternalObject *item = safeGet(start + i);
+        values[i] = item;
+        if (item != OREF_NULL)
+        {
+            found++;
+        }
+    }
+    return found;
+}
+
+
 /**
  * The Rexx stub for the Array PUT method.  This does full
  * checking for the array.
@@ -642,6 +843,7 @@ void ArrayClass::fill(RexxInternalObject *value)
  */
 RexxObject *ArrayClass::empty()
 {
+    checkIterationSnapshot();
     // if not working with an oldspace object (VERY likely), we can just use memset to clear
     // everything.
     if (isNewSpace())
@@ -835,6 +1037,7 @@ RexxInternalObject *ArrayClass::deleteRexx(RexxObject *index)
  */
 void ArrayClass::openGap(size_t index, size_t elements)
 {
+    checkIterationSnapshot();
     // is this larger than our current last element?  If so, we have nothing to move
     // but do need to expand the array size to accommodate the additional members
     if (index > lastItem)
@@ -879,6 +1082,7 @@ void ArrayClass::openGap(size_t index, size_t elements)
  */
 void ArrayClass::closeGap(size_t index, size_t elements)
 {
+    checkIterationSnapshot();
     // if we're beyond the current last item, nothing to do here
     if (index > lastItem)
     {
@@ -2336,6 +2540,10 @@ void ArrayClass::ElementCopier::copyElements(size_t newDimension)
  */
 void ArrayClass::extendMulti(RexxObject **index, size_t indexCount, size_t argPosition)
 {
+    // the items are about to be moved to new positions, so any running
+    // DO OVER loop needs its copy made from the current layout.
+    checkIterationSnapshot();
+
     // our new dimensions array will be the same as the number of indexes.
     Protected<NumberArray> newDimArray = new (indexCount) NumberArray(indexCount);
 
@@ -2714,6 +2922,12 @@ ArrayClass *ArrayClass::stableSortRexx()
         }
     }
 
+    // arrays of strings can be sorted without sending any messages
+    if (primitiveSort(count, StringSort, false, 0))
+    {
+        return this;
+    }
+
     // the merge sort requires a temporary scratch area for the sort.
     Protected<ArrayClass> working = new_array(count);
 
@@ -2751,6 +2965,12 @@ ArrayClass *ArrayClass::stableSortWithRexx(RexxObject *comparator)
         }
     }
 
+    // the built-in comparators have native versions for arrays of strings
+    if (primitiveSortWith(comparator, count))
+    {
+        return this;
+    }
+
     // the merge sort requires a temporary scratch area for the sort.
     Protected<ArrayClass> working = new_array(count);
     ProtectedObject p(working);
@@ -2787,3 +3007,573 @@ wholenumber_t ArrayClass::WithSortComparator::compare(RexxInternalObject *first,
 }
 
 
+/**
+ * A sort element used by the primitive sorting paths.  The
+ * sort keys are extracted from the items once, so the
+ * comparisons never need to touch the objects or send
+ * messages, and can safely run on threads that do not hold
+ * the kernel lock.
+ */
+class PrimitiveSortElement
+{
+public:
+    RexxInternalObject *item;        // the array item being sorted
+    const char *data;                // the string data for string orderings
+    size_t length;                   // the string length
+    wholenumber_t number;            // the value for numeric orderings
+};
+
+
+/**
+ * The compareTo() ordering for primitive strings.
+ */
+class StringSortOrder
+{
+public:
+    inline wholenumber_t compare(const PrimitiveSortElement &left, const PrimitiveSortElement &right) const
+    {
+        int result = memcmp(left.data, right.data, Numerics::minVal(left.length, right.length));
+        if (result != 0)
+        {
+            return result;
+        }
+        return left.length == right.length ? 0 : (left.length < right.length ? -1 : 1);
+    }
+};
+
+
+/**
+ * The caselessCompareTo() ordering for primitive strings.
+ */
+class CaselessSortOrder
+{
+public:
+    inline wholenumber_t compare(const PrimitiveSortElement &left, const PrimitiveSortElement &right) const
+    {
+        int result = StringUtil::caselessCompare(left.data, right.data, Numerics::minVal(left.length, right.length));
+        if (result != 0)
+        {
+            return result;
+        }
+        return left.length == right.length ? 0 : (left.length < right.length ? -1 : 1);
+    }
+};
+
+
+/**
+ * The NumericComparator ordering for whole numbers.
+ */
+class NumericSortOrder
+{
+public:
+    inline wholenumber_t compare(const PrimitiveSortElement &left, const PrimitiveSortElement &right) const
+    {
+        return left.number == right.number ? 0 : (left.number < right.number ? -1 : 1);
+    }
+};
+
+
+/**
+ * Reverses another ordering, the same as negating the
+ * compare result in the descending comparators.
+ */
+template <class Order> class DescendingSortOrder
+{
+public:
+    inline wholenumber_t compare(const PrimitiveSortElement &left, const PrimitiveSortElement &right) const
+    {
+        return order.compare(right, left);
+    }
+
+    Order order;
+};
+
+
+/**
+ * A section of a primitive sort, either sorting a range of
+ * elements or merging two sorted ranges into a target.  Large
+ * sorts run each section on a separate thread.
+ */
+template <class Order> class PrimitiveSortTask : public SysThread
+{
+public:
+    inline PrimitiveSortTask() : first(NULL), last(NULL), second(NULL), secondLast(NULL), target(NULL) { }
+
+    inline void setSort(PrimitiveSortElement *f, PrimitiveSortElement *l, PrimitiveSortElement *w)
+    {
+        first = f;
+        last = l;
+        second = NULL;
+        secondLast = NULL;
+        target = w;
+    }
+
+    inline void setMerge(PrimitiveSortElement *f, PrimitiveSortElement *l, PrimitiveSortElement *s, PrimitiveSortElement *sl, PrimitiveSortElement *t)
+    {
+        first = f;
+        last = l;
+        second = s;
+        secondLast = sl;
+        target = t;
+    }
+
+    inline void start() { createThread(); }
+    // wait for the thread to complete.  If we were unable to start
+    // a thread, the work is done here instead.
+    inline void finish()
+    {
+        if (!waitForTermination())
+        {
+            run();
+        }
+    }
+
+    virtual void dispatch() { run(); }
+
+    void run()
+    {
+        if (second == NULL)
+        {
+            sort(first, last - first, target);
+        }
+        else
+        {
+            merge(first, last, second, secondLast, target);
+        }
+    }
+
+    /**
+     * A merge sort of a range of elements, using the same
+     * approach as ArrayClass::mergeSort().
+     *
+     * @param elements The first element.
+     * @param count    The number of elements to sort.
+     * @param working  Scratch space of the same size.
+     */
+    void sort(PrimitiveSortElement *elements, size_t count, PrimitiveSortElement *working)
+    {
+        // use insertion sort for small ranges
+        if (count <= 10)
+        {
+            for (size_t i = 1; i < count; i++)
+            {
+                PrimitiveSortElement current = elements[i];
+                size_t j = i;
+                while (j > 0 && order.compare(current, elements[j - 1]) < 0)
+                {
+                    elements[j] = elements[j - 1];
+                    j--;
+                }
+                elements[j] = current;
+            }
+            return;
+        }
+
+        size_t mid = count / 2;
+        sort(elements, mid, working);
+        sort(elements + mid, count - mid, working + mid);
+
+        // if the halves are already in order, there is nothing to merge
+        if (order.compare(elements[mid - 1], elements[mid]) <= 0)
+        {
+            return;
+        }
+
+        merge(elements, elements + mid, elements + mid, elements + count, working);
+        memcpy(elements, working, count * sizeof(PrimitiveSortElement));
+    }
+
+    /**
+     * Merge two sorted ranges.  Equal elements are taken from
+     * the first range first, which keeps the sort stable.
+     */
+    void merge(PrimitiveSortElement *left, PrimitiveSortElement *leftEnd, PrimitiveSortElement *right,
+        PrimitiveSortElement *rightEnd, PrimitiveSortElement *output)
+    {
+        while (left < leftEnd && right < rightEnd)
+        {
+            if (order.compare(*left, *right) <= 0)
+            {
+                *output++ = *left++;
+            }
+            else
+            {
+                *output++ = *right++;
+            }
+        }
+        memcpy(output, left, (leftEnd - left) * sizeof(PrimitiveSortElement));
+        output += leftEnd - left;
+        memcpy(output, right, (rightEnd - right) * sizeof(PrimitiveSortElement));
+    }
+
+    /**
+     * Locate the first element of a sorted range that does not
+     * sort lower than a value.
+     */
+    PrimitiveSortElement *lowerBound(PrimitiveSortElement *left, PrimitiveSortElement *right, const PrimitiveSortElement &value)
+    {
+        while (left < right)
+        {
+            PrimitiveSortElement *mid = left + (right - left) / 2;
+            if (order.compare(*mid, value) < 0)
+            {
+                left = mid + 1;
+            }
+            else
+            {
+                right = mid;
+            }
+        }
+        return left;
+    }
+
+    Order order;                          // the ordering we're sorting with
+
+protected:
+    PrimitiveSortElement *first;          // the range to sort, or the first merge range
+    PrimitiveSortElement *last;
+    PrimitiveSortElement *second;         // the second merge range (NULL for a sort)
+    PrimitiveSortElement *secondLast;
+    PrimitiveSortElement *target;         // the merge target or the sort scratch space
+};
+
+
+/**
+ * Run a set of sort tasks, using the current thread for the
+ * first one.
+ *
+ * @param tasks  The task array.
+ * @param count  The number of tasks to run.
+ */
+template <class Order> static void runSortTasks(PrimitiveSortTask<Order> *tasks, size_t count)
+{
+    for (size_t i = 1; i < count; i++)
+    {
+        tasks[i].start();
+    }
+    tasks[0].run();
+    for (size_t i = 1; i < count; i++)
+    {
+        tasks[i].finish();
+    }
+}
+
+
+/**
+ * Sort a set of primitive sort elements.  Large sorts are
+ * split into sections sorted on separate threads, then the
+ * sections are merged in pairs.  Each pair merge is itself
+ * split up across the threads by partitioning the first range
+ * and locating the matching split point in the second.
+ *
+ * @param elements The elements to sort.
+ * @param working  Scratch space for the same number of elements.
+ * @param count    The number of elements.
+ *
+ * @return Whichever of elements or working holds the sorted result.
+ */
+template <class Order> static PrimitiveSortElement *sortPrimitiveElements(PrimitiveSortElement *elements, PrimitiveSortElement *working, size_t count, size_t threads)
+{
+    PrimitiveSortTask<Order> tasks[ArrayClass::MaximumSortThreads];
+
+    if (threads <= 1)
+    {
+        tasks[0].sort(elements, count, working);
+        return elements;
+    }
+
+    // the section boundaries
+    size_t bounds[ArrayClass::MaximumSortThreads + 1];
+    for (size_t i = 0; i <= threads; i++)
+    {
+        bounds[i] = (count * i) / threads;
+    }
+
+    for (size_t i = 0; i < threads; i++)
+    {
+        tasks[i].setSort(elements + bounds[i], elements + bounds[i + 1], working + bounds[i]);
+    }
+    runSortTasks(tasks, threads);
+
+    PrimitiveSortElement *source = elements;
+    PrimitiveSortElement *target = working;
+    size_t runs = threads;
+
+    while (runs > 1)
+    {
+        size_t pairs = runs / 2;
+        size_t pieces = Numerics::maxVal((size_t)1, threads / pairs);
+        size_t taskCount = 0;
+
+        for (size_t p = 0; p < pairs; p++)
+        {
+            PrimitiveSortElement *left = source + bounds[2 * p];
+            PrimitiveSortElement *leftEnd = source + bounds[2 * p + 1];
+            PrimitiveSortElement *right = leftEnd;
+            PrimitiveSortElement *rightEnd = source + bounds[2 * p + 2];
+            PrimitiveSortElement *output = target + bounds[2 * p];
+            size_t leftLength = leftEnd - left;
+
+            PrimitiveSortElement *leftSplit = left;
+            PrimitiveSortElement *rightSplit = right;
+            for (size_t k = 1; k <= pieces; k++)
+            {
+                PrimitiveSortElement *nextLeft = leftEnd;
+                PrimitiveSortElement *nextRight = rightEnd;
+                if (k < pieces)
+                {
+                    nextLeft = left + (leftLength * k) / pieces;
+                    // items from the right range that are equal to the split
+                    // point belong after it, which keeps this stable.
+                    nextRight = tasks[0].lowerBound(rightSplit, rightEnd, *nextLeft);
+                }
+                tasks[taskCount++].setMerge(leftSplit, nextLeft, rightSplit, nextRight,
+                    output + (leftSplit - left) + (rightSplit - right));
+                leftSplit = nextLeft;
+                rightSplit = nextRight;
+            }
+        }
+
+        // an odd section out just gets copied along
+        if ((runs & 1) != 0)
+        {
+            memcpy(target + bounds[runs - 1], source + bounds[runs - 1], (count - bounds[runs - 1]) * sizeof(PrimitiveSortElement));
+        }
+
+        runSortTasks(tasks, taskCount);
+
+        // the merged sections start at every other boundary
+        runs = (runs + 1) / 2;
+        for (size_t i = 0; i < runs; i++)
+        {
+            bounds[i] = bounds[2 * i];
+        }
+        bounds[runs] = count;
+
+        PrimitiveSortElement *temp = source;
+        source = target;
+        target = temp;
+    }
+    return source;
+}
+
+
+/**
+ * Convert a string into a whole number for the numeric sort
+ * ordering.  Only plain integers (an optional sign followed by
+ * digits) within the comparison precision qualify, since those
+ * compare exactly the same way as the sign(left - right)
+ * calculation of the NumericComparator.
+ *
+ * @param data      The string data.
+ * @param length    The string length.
+ * @param precision The comparison precision.
+ * @param result    The returned value.
+ *
+ * @return true if the string qualifies, false otherwise.
+ */
+static bool primitiveSortNumber(const char *data, size_t length, wholenumber_t precision, wholenumber_t &result)
+{
+    const char *end = data + length;
+    bool negative = false;
+
+    if (data < end && (*data == '-' || *data == '+'))
+    {
+        negative = *data == '-';
+        data++;
+    }
+    if (data == end)
+    {
+        return false;
+    }
+
+    wholenumber_t value = 0;
+    wholenumber_t digits = 0;
+    for (; data < end; data++)
+    {
+        if (*data < '0' || *data > '9')
+        {
+            return false;
+        }
+        // leading zeros don't count against the precision
+        if (digits > 0 || *data != '0')
+        {
+            if (++digits > Numerics::ARGUMENT_DIGITS)
+            {
+                return false;
+            }
+        }
+        value = value * 10 + (*data - '0');
+    }
+
+    if (!Numerics::isValid(value, precision))
+    {
+        return false;
+    }
+    result = negative ? -value : value;
+    return true;
+}
+
+
+/**
+ * Sort the array using native sort keys when all of the items
+ * are primitive strings (or numbers, which sort using their
+ * string values).  The result is the same as the general sort
+ * using the matching comparator, just without sending any
+ * messages.
+ *
+ * @param count      The number of items to sort.
+ * @param type       The ordering to apply.
+ * @param descending Reverse the ordering.
+ * @param precision  The precision for numeric orderings.
+ *
+ * @return true if the array was sorted, false if the items don't
+ *         qualify and the general sort is needed.
+ */
+bool ArrayClass::primitiveSort(size_t count, PrimitiveSortType type, bool descending, wholenumber_t precision)
+{
+    // first check that everything qualifies.  Getting the string value of a
+    // number might allocate a new string, so do this before we allocate the
+    // native sort elements.  The string values are cached in the number
+    // objects, so they remain anchored.
+    for (size_t i = 1; i <= count; i++)
+    {
+        RexxInternalObject *item = get(i);
+        if (isOfClass(Integer, item))
+        {
+            if (type == NumericSort && !Numerics::isValid(((RexxInteger *)item)->wholeNumber(), precision))
+            {
+                return false;
+            }
+            item->stringValue();
+        }
+        else if (isOfClass(NumberString, item))
+        {
+            item->stringValue();
+        }
+        else if (!isOfClass(String, item))
+        {
+            return false;
+        }
+    }
+
+    PrimitiveSortElement *elements = (PrimitiveSortElement *)malloc(sizeof(PrimitiveSortElement) * count * 2);
+    if (elements == NULL)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        RexxInternalObject *item = get(i + 1);
+        RexxString *value = (RexxString *)item;
+        if (isOfClass(Integer, item) || isOfClass(NumberString, item))
+        {
+            value = item->stringValue();
+        }
+        elements[i].item = item;
+        elements[i].data = value->getStringData();
+        elements[i].length = value->getLength();
+        elements[i].number = 0;
+        if (type == NumericSort)
+        {
+            if (isOfClass(Integer, item))
+            {
+                elements[i].number = ((RexxInteger *)item)->wholeNumber();
+            }
+            else if (!primitiveSortNumber(elements[i].data, elements[i].length, precision, elements[i].number))
+            {
+                free(elements);
+                return false;
+            }
+        }
+    }
+
+    // only go parallel if there is enough work to go around
+    size_t threads = 1;
+    if (count >= ParallelSortThreshold)
+    {
+        threads = Numerics::minVal(Numerics::minVal(SysThread::processorCount(), MaximumSortThreads), count / (ParallelSortThreshold / 2));
+    }
+
+    PrimitiveSortElement *working = elements + count;
+    PrimitiveSortElement *sorted;
+    switch (type)
+    {
+        case StringSort:
+            sorted = descending ? sortPrimitiveElements<DescendingSortOrder<StringSortOrder> >(elements, working, count, threads)
+                                : sortPrimitiveElements<StringSortOrder>(elements, working, count, threads);
+            break;
+
+        case CaselessSort:
+            sorted = descending ? sortPrimitiveElements<DescendingSortOrder<CaselessSortOrder> >(elements, working, count, threads)
+                                : sortPrimitiveElements<CaselessSortOrder>(elements, working, count, threads);
+            break;
+
+        default:
+            sorted = sortPrimitiveElements<NumericSortOrder>(elements, working, count, threads);
+            break;
+    }
+
+    // and move everything back into the array in the new order
+    for (size_t i = 0; i < count; i++)
+    {
+        setSortItem(i + 1, sorted[i].item);
+    }
+    free(elements);
+    return true;
+}
+
+
+/**
+ * Check if a sortWith comparator is one of the built-in
+ * comparators that has a primitive ordering, and sort using
+ * that if possible.
+ *
+ * @param comparator The comparator object.
+ * @param count      The number of items to sort.
+ *
+ * @return true if the array was sorted, false if the general sort
+ *         is needed.
+ */
+bool ArrayClass::primitiveSortWith(RexxObject *comparator, size_t count)
+{
+    // an instance with its own methods might not do what the class does
+    if (comparator->behaviourObject()->isEnhanced())
+    {
+        return false;
+    }
+
+    RexxClass *comparatorClass = comparator->classObject();
+
+    if (comparatorClass == TheRexxPackage->findClass(GlobalNames::Comparator))
+    {
+        return primitiveSort(count, StringSort, false, 0);
+    }
+    else if (comparatorClass == TheRexxPackage->findClass(GlobalNames::DescendingComparator))
+    {
+        return primitiveSort(count, StringSort, true, 0);
+    }
+    else if (comparatorClass == TheRexxPackage->findClass(GlobalNames::CaselessComparator))
+    {
+        return primitiveSort(count, CaselessSort, false, 0);
+    }
+    else if (comparatorClass == TheRexxPackage->findClass(GlobalNames::CaselessDescendingComparator))
+    {
+        return primitiveSort(count, CaselessSort, true, 0);
+    }
+    else if (comparatorClass == TheRexxPackage->findClass(GlobalNames::NumericComparator))
+    {
+        // the comparison precision is held in the comparator
+        RexxObject *precisionValue = comparator->getObjectVariable(GlobalNames::PRECISION, comparatorClass);
+        wholenumber_t precision;
+        if (precisionValue == OREF_NULL || !precisionValue->numberValue(precision) || precision < 1)
+        {
+            return false;
+        }
+        return primitiveSort(count, NumericSort, false, precision);
+    }
+    return false;
+}
+
+
@@ -107,6 +107,18 @@ class ArrayClass : public RexxObject
      };
 
 
+    /**
+     * The orderings we can apply to arrays of primitive strings
+     * without sending any messages.
+     */
+    typedef enum
+    {
+        StringSort,              // compareTo() ordering
+        CaselessSort,            // caselessCompareTo() ordering
+        NumericSort              // NumericComparator ordering of whole numbers
+    } PrimitiveSortType;
+
+
     /**
      * Our base sort comparator, which just uses a compareTo
      * method.
@@ -152,6 +164,7 @@ class ArrayClass : public RexxObject
     virtual void live(size_t);
     virtual void liveGeneral(MarkReason reason);
     virtual void flatten(Envelope *);
+    virtual bool isValidFlattened(ValidatingMarkHandler &);
 
     virtual RexxInternalObject *copy();
     virtual ArrayClass *makeArray();
@@ -164,6 +177,8 @@ class ArrayClass : public RexxObject
     RexxInternalObject  *getRexx(RexxObject **, size_t);
     RexxInternalObject  *safeGet(size_t pos);
     void          put(RexxInternalObject * eref, size_t pos);
+    void          putRange(RexxInternalObject **values, size_t start, size_t count);
+    size_t        getRange(RexxInternalObject **values, size_t start, size_t count);
     RexxObject   *putRexx(RexxObject **, size_t);
     void          putApi(RexxInternalObject * eref, size_t pos);
     // this is virtual because Queue redefines this as a delete operation.
@@ -257,14 +272,28 @@ class ArrayClass : public RexxObject
            void         clearArrayItem(size_t position);
            void         copyArrayItem(size_t position, RexxInternalObject *value);
            void         setOrClearArrayItem(size_t position, RexxInternalObject *value);
-    inline void         zeroItem(size_t position) { data()[position - 1] = OREF_NULL; }
+    inline void         zeroItem(size_t position) { checkIterationSnapshot(); data()[position - 1] = OREF_NULL; }
            void         clearItem(size_t position);
            // NOTE:  only to be used during sorting!
-    inline void         setSortItem(size_t position, RexxInternalObject *value) { expansionArray->objects[position - 1] = value; }
+    inline void         setSortItem(size_t position, RexxInternalObject *value) { checkIterationSnapshot(); expansionArray->objects[position - 1] = value; }
            void         setItem(size_t position, RexxInternalObject *value);
            void         checkMultiDimensional(const char *methodName);
            void         shrink(size_t amount);
 
+    // DO OVER support.  Loops iterate the array in place and only get a
+    // copy of the items if the array is changed while they are running.
+           ArrayClass  *getIterationSnapshot();
+           void         releaseIterationSnapshot(ArrayClass *snapshot);
+           void         freezeIterationSnapshot();
+    inline bool         isIterationSnapshot(ArrayClass *s) { return iterationSnapshot == s; }
+    inline void         checkIterationSnapshot()
+    {
+        if (iterationSnapshot != OREF_NULL)
+        {
+            freezeIterationSnapshot();
+        }
+    }
+
     // check if we need to update the itemcount when writing to a given position.
     inline void checkSetItemCount(size_t pos)
     {
@@ -327,6 +356,8 @@ class ArrayClass : public RexxObject
     static ArrayClass *nullArray;
 
     static const size_t DefaultArraySize = 16;     // default size for ooRexx allocation
+    static const size_t ParallelSortThreshold = 100000;  // smallest primitive sort we split across threads
+    static const size_t MaximumSortThreads = 8;    // most threads used for a single sort
 
  protected:
 
@@ -334,6 +365,8 @@ class ArrayClass : public RexxObject
     void         merge(BaseSortComparator &comparator, ArrayClass *working, size_t left, size_t mid, size_t right);
     static void  arraycopy(ArrayClass *source, size_t start, ArrayClass *target, size_t index, size_t count);
     size_t       find(BaseSortComparator &comparator, RexxInternalObject *val, int bnd, size_t left, size_t right);
+    bool         primitiveSort(size_t count, PrimitiveSortType type, bool descending, wholenumber_t precision);
+    bool         primitiveSortWith(RexxObject *comparator, size_t count);
     void         openGap(size_t index, size_t elements);
     void         closeGap(size_t index, size_t elements);
     inline RexxInternalObject **slotAddress(size_t index) { return &(data()[index - 1]); }
@@ -350,6 +383,8 @@ class ArrayClass : public RexxObject
     size_t itemCount;                   // the count of items in the array
     NumberArray *dimensions;            // Array containing dimensions - null if 1-dimensional
     ArrayClass *expansionArray;         // actual array containing data (will be self-referential originall)
+    ArrayClass *iterationSnapshot;      // pending snapshot shared by DO OVER loops running over this array
+    size_t      iterationLoops;         // number of running loops sharing the pending snapshot
     RexxInternalObject *objects[1];     // the start of the array of stored objects.
 };
 
@@ -73,6 +73,19 @@ void *BufferClass::operator new(size_t size, size_t length)
 }
 
 
+/**
+ * Check a buffer from a flattened buffer.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if the buffer data is inside the object.
+ */
+bool BufferClass::isValidFlattened(ValidatingMarkHandler &image)
+{
+    return dataLength <= bufferSize && fitsInObject(data, bufferSize, sizeof(char));
+}
+
+
 /**
  * New method for the buffer class.  This always raises
  * an error if called.
@@ -110,6 +110,7 @@ public:
     BufferClass *expand(size_t);
     RexxObject *newRexx(RexxObject **args, size_t argc);
     virtual char *getData() { return data; }
+    virtual bool isValidFlattened(ValidatingMarkHandler &);
 
     static void createInstance();
 
@@ -121,6 +121,7 @@ void RexxClass::live(size_t liveMark)
     memory_mark(subClasses);
     memory_mark(package);
     memory_mark(annotations);
+    memory_mark(variableSlots);
 }
 
 
@@ -140,6 +141,9 @@ void RexxClass::liveGeneral(MarkReason reason)
         package = TheRexxPackage;
         // this class can no longer be altered
         setRexxDefined();
+        // the slot assignments are rebuilt on demand, along with
+        // the object variable slots that use them
+        variableSlots = OREF_NULL;
     }
 
     memory_mark_general(objectVariables);
@@ -154,6 +158,7 @@ void RexxClass::liveGeneral(MarkReason reason)
     memory_mark_general(subClasses);
     memory_mark_general(package);
     memory_mark_general(annotations);
+    memory_mark_general(variableSlots);
 }
 
 
@@ -377,6 +382,35 @@ RexxObject *RexxClass::getAnnotationRexx(RexxObject *name)
 }
 
 
+/**
+ * Get the slot number assigned to an object variable name at
+ * this scope level.  The object variable dictionaries for this
+ * scope cache their variables by slot number, which allows EXPOSE
+ * and attribute methods to bind variables without a name lookup.
+ *
+ * @param name   The variable name.
+ *
+ * @return The slot number for the variable (origin 1).
+ */
+size_t RexxClass::getVariableSlot(RexxString *name)
+{
+    if (variableSlots == OREF_NULL)
+    {
+        StringTable *slots = new_string_table();
+        setField(variableSlots, slots);
+    }
+
+    RexxInteger *slot = (RexxInteger *)variableSlots->get(name);
+    // first time we've seen this name in this scope, give it the next number.
+    if (slot == OREF_NULL)
+    {
+        slot = new_integer(variableSlots->items() + 1);
+        variableSlots->put(slot, name);
+    }
+    return slot->getValue();
+}
+
+
 /**
  * Retrieve the String ID for a class object.
  *
@@ -1752,6 +1786,8 @@ RexxClass  *RexxClass::newRexx(RexxObject **args, size_t argCount)
     new_class->id = class_id;
     // the new class does not inherit annotations
     new_class->annotations = OREF_NULL;
+    // or the variable slot numbers of the metaclass scope
+    new_class->variableSlots = OREF_NULL;
 
     // no new class objects start out as abstract.
     new_class->clearAbstract();
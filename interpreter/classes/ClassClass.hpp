@@ -136,6 +136,7 @@ class RexxClass : public RexxObject
     RexxObject *isSubclassOf(RexxClass *other);
     RexxString *defaultNameRexx();
     RexxObject *getAnnotationRexx(RexxObject *name);
+    size_t      getVariableSlot(RexxString *name);
     void        setPackage(PackageClass *s);
     PackageClass *getPackage();
     void        completeNewObject(RexxObject *obj, RexxObject **initArgs = OREF_NULL, size_t argCount = 0);
@@ -206,5 +207,6 @@ class RexxClass : public RexxObject
     ListClass     *subClasses;         // our list of weak referenced subclasses
     PackageClass  *package;            // source we're defined in (if any)
     StringTable   *annotations;        // annotations attached to the class (if any)
+    StringTable   *variableSlots;      // slot numbers assigned to object variables of this scope
 };
 #endif
@@ -310,6 +310,7 @@ RexxInternalObject *DirectoryClass::remove(RexxInternalObject *entryName)
     // the removed value might come from running a method,
     RexxInternalObject *oldVal = get(entryName);
 
+    modified();
     // remove from the contents (unconditionally)
     contents->remove(entryName);
 
@@ -355,6 +356,7 @@ RexxInternalObject *DirectoryClass::get(RexxInternalObject *index)
  */
 void DirectoryClass::put(RexxInternalObject *value, RexxInternalObject *index)
 {
+    modified();
     // a PUT replaces any existing value, including methods that may have been defined.
     if (methodTable != OREF_NULL)
     {
@@ -371,6 +373,7 @@ void DirectoryClass::put(RexxInternalObject *value, RexxInternalObject *index)
  */
 void DirectoryClass::empty()
 {
+    modified();
     // empty the hashtables without reallocating.
     contents->empty();
     if (methodTable != OREF_NULL)
@@ -522,6 +525,7 @@ RexxInternalObject *DirectoryClass::setMethodRexx(RexxString *entryname, MethodC
     // since setting a method will also override any contents, we need to
     // ensure the contents don't have this either.
     contents->remove(entryname);
+    modified();
     return OREF_NULL;
 }
 
@@ -552,10 +556,29 @@ RexxInternalObject *DirectoryClass::unsetMethodRexx(RexxString *entryname)
         }
     }
 
+    modified();
     return OREF_NULL;
 }
 
 
+/**
+ * Test whether a lookup of an index would produce its value by
+ * running a method rather than from a stored entry.
+ *
+ * @param index  The target index (already uppercase).
+ *
+ * @return true if the value comes from the method table or the unknown method.
+ */
+bool DirectoryClass::isComputedEntry(RexxString *index)
+{
+    if (contents->hasIndex(index))
+    {
+        return false;
+    }
+    return unknownMethod != OREF_NULL || (methodTable != OREF_NULL && methodTable->hasIndex(index));
+}
+
+
 /**
  * Retrieve a value from the method table, if there is one.
  *
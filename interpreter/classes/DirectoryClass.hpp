@@ -53,7 +53,7 @@ class DirectoryClass : public StringHashCollection
     inline void  operator delete(void *) { ; }
 
     inline DirectoryClass(RESTORETYPE restoreType) { ; }
-           DirectoryClass(size_t capacity = HashCollection::DefaultTableSize) : methodTable(OREF_NULL), unknownMethod(OREF_NULL), StringHashCollection(capacity) { }
+           DirectoryClass(size_t capacity = HashCollection::DefaultTableSize) : methodTable(OREF_NULL), unknownMethod(OREF_NULL), modifications(0), StringHashCollection(capacity) { }
 
     RexxObject *newRexx(RexxObject **, size_t);
 
@@ -87,8 +87,14 @@ class DirectoryClass : public StringHashCollection
     RexxInternalObject *methodTableValue(RexxInternalObject *index);
     RexxInternalObject *unknownValue(RexxInternalObject *index);
 
+    // change tracking used by cached environment symbol lookups
+    inline size_t getModifications() { return modifications; }
+    bool          isComputedEntry(RexxString *index);
+    inline void   modified() { modifications++; }
+
     StringTable *methodTable;            // table of added methods
     MethodClass *unknownMethod;          // unknown method entry
+    size_t       modifications;          // count of changes made to the directory
 
     static void createInstance();
     // singleton class instance;
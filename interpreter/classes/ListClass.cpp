@@ -178,6 +178,7 @@ RexxInternalObject *ListClass::copy()
     ListClass *newlist = (ListClass *)this->RexxObject::copy();
     // copy the backing contents
     newlist->contents = (ListContents *)contents->copy();
+    newlist->contentsShared = false;
     return newlist;
 }
 
@@ -284,6 +285,9 @@ void ListClass::expandContents(size_t capacity )
     contents->mergeInto(newContents);
 
     setField(contents, (ListContents *)newContents);
+    // the merge leaves the old contents intact, so any DO OVER loop can
+    // continue using those.
+    contentsShared = false;
 }
 
 
@@ -360,6 +364,7 @@ void ListClass::put(RexxInternalObject *value, size_t index)
     // make sure we have enough space to add and then
     // have the contents add this.
     checkFull();
+    checkSharedContents();
     contents->put(value, index);
 }
 
@@ -467,6 +472,7 @@ size_t ListClass::insert(RexxInternalObject *value, size_t insertionPoint)
     // make sure we have enough space to add and then
     // have the contents add this.
     checkFull();
+    checkSharedContents();
     return contents->insert(value, insertionPoint);
 }
 
@@ -483,6 +489,7 @@ size_t ListClass::addLast(RexxInternalObject *value)
     // make sure we have enough space to add and then
     // have the contents add this.
     checkFull();
+    checkSharedContents();
     return contents->insert(value, ListContents::AtEnd);
 }
 
@@ -499,6 +506,7 @@ size_t ListClass::addFirst(RexxInternalObject *value)
     // make sure we have enough space to add and then
     // have the contents add this.
     checkFull();
+    checkSharedContents();
     return contents->insert(value, ListContents::AtBeginning);
 }
 
@@ -515,6 +523,7 @@ size_t ListClass::append(RexxInternalObject *value)
     // make sure we have enough space to add and then
     // have the contents add this.
     checkFull();
+    checkSharedContents();
     return contents->insertAtEnd(value);
 }
 
@@ -556,6 +565,7 @@ RexxObject *ListClass::removeRexx(RexxObject *argIndex)
  */
 RexxInternalObject *ListClass::remove(size_t index)
 {
+    checkSharedContents();
     return contents->remove(index);
 }
 
@@ -792,6 +802,7 @@ RexxObject *ListClass::emptyRexx()
  */
 void ListClass::empty()
 {
+    checkSharedContents();
     contents->empty();
 }
 
@@ -915,6 +926,7 @@ RexxInternalObject *ListClass::removeItemRexx(RexxObject *target)
  */
 RexxInternalObject *ListClass::removeItem(RexxInternalObject *target)
 {
+    checkSharedContents();
     return contents->removeItem(target);
 }
 
@@ -964,6 +976,33 @@ ArrayClass *ListClass::weakReferenceArray()
 }
 
 
+/**
+ * Get the contents for a DO OVER loop to iterate over.  The
+ * contents are marked as shared, so the next change to the
+ * list is made to a copy and the loop keeps seeing the items
+ * the list had when the loop started.
+ *
+ * @return The current list contents.
+ */
+ListContents *ListClass::getIterationContents()
+{
+    contentsShared = true;
+    return contents;
+}
+
+
+/**
+ * Replace shared contents with a private copy before the list
+ * is changed.
+ */
+void ListClass::unshareContents()
+{
+    ListContents *newContents = (ListContents *)contents->copy();
+    setField(contents, newContents);
+    contentsShared = false;
+}
+
+
 /**
  * Rexx method for allocating a List item.
  *
@@ -93,6 +93,7 @@ class ListClass : public RexxObject
     SupplierClass *supplier();
     size_t items();
     ArrayClass *weakReferenceArray();
+    ListContents *getIterationContents();
 
     // The exported Rexx methods
     RexxObject *initRexx(RexxObject *initialSize);
@@ -141,8 +142,20 @@ class ListClass : public RexxObject
     void ensureCapacity(size_t delta);
     void checkFull();
     RexxObject *indexObject(ListContents::ItemLink index);
+    void unshareContents();
+
+    // a DO OVER loop might be iterating over the current contents, so
+    // make our own copy before making any changes
+    inline void checkSharedContents()
+    {
+        if (contentsShared)
+        {
+            unshareContents();
+        }
+    }
 
     ListContents *contents;               // list table  item
+    bool contentsShared;                  // the contents are in use by a DO OVER loop
 };
 
 
@@ -533,18 +533,33 @@ RexxObject *MessageClass::start()
     receiver->validateScopeOverride(startscope);
     receiver->validateOverrideContext(receiver, startscope);
 
-    // spawn a new activity off of the old activity
+    // get an activity to run on.  If the instance is using a bounded
+    // start scheduler, this might be queued until a worker is free.
     Activity *oldActivity = ActivityManager::currentActivity;
-    Activity *newActivity = oldActivity->spawnReply();
-    // mark which activity we're running on, then dispatch the message
-    // on the new activity (which is sitting waiting for work to perform)
-    setField(startActivity, newActivity);
-    newActivity->run(this);
+    Activity *newActivity = oldActivity->getInstance()->scheduleStart(oldActivity, this);
+    if (newActivity != OREF_NULL)
+    {
+        dispatchStart(newActivity);
+    }
     // we have no return value.
     return OREF_NULL;
 }
 
 
+/**
+ * Dispatch a started message on the activity that will run it.
+ *
+ * @param activity The activity to run on.
+ */
+void MessageClass::dispatchStart(Activity *activity)
+{
+    // mark which activity we're running on, then dispatch the message
+    // on the new activity (which is sitting waiting for work to perform)
+    setField(startActivity, activity);
+    activity->run(this);
+}
+
+
 /**
  * Do a dynamic invocation of an object method.
  *
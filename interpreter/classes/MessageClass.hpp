@@ -100,6 +100,7 @@ class MessageClass : public RexxObject
     RexxObject   *errorCondition();
     RexxObject   *newRexx(RexxObject **, size_t);
     Activity     *getActivity() { return startActivity; }
+    void          dispatchStart(Activity *activity);
     RexxObject   *messageCompleted(RexxObject *messageSource);
     RexxObject   *halt(RexxString *description);
 
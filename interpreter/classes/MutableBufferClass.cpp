@@ -207,6 +207,24 @@ void MutableBuffer::flatten(Envelope *envelope)
 }
 
 
+/**
+ * Check a mutable buffer from a flattened buffer.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if the data fits in the data buffer.
+ */
+bool MutableBuffer::isValidFlattened(ValidatingMarkHandler &image)
+{
+    if (image.typeOf(data) != T_Buffer)
+    {
+        return false;
+    }
+    BufferClass *buffer = (BufferClass *)image.resolve(data);
+    return dataLength <= bufferLength && bufferLength <= buffer->getBufferSize();
+}
+
+
 /**
  * copy an object
  *
@@ -1238,12 +1256,8 @@ MutableBuffer *MutableBuffer::lower(RexxInteger *_start, RexxInteger *_length)
     }
 
     char *bufferData = getData() + startPos;
-    // now uppercase in place
-    for (size_t i = 0; i < rangeLength; i++)
-    {
-        *bufferData = tolower(*bufferData);
-        bufferData++;
-    }
+    // now lowercase in place
+    StringUtil::lowerCase(bufferData, bufferData, rangeLength);
     return this;
 }
 
@@ -1279,11 +1293,7 @@ MutableBuffer *MutableBuffer::upper(RexxInteger *_start, RexxInteger *_length)
 
     char *bufferData = getData() + startPos;
     // now uppercase in place
-    for (size_t i = 0; i < rangeLength; i++)
-    {
-        *bufferData = toupper(*bufferData);
-        bufferData++;
-    }
+    StringUtil::upperCase(bufferData, bufferData, rangeLength);
     return this;
 }
 
@@ -1327,37 +1337,10 @@ MutableBuffer *MutableBuffer::translate(RexxString *tableo, RexxString *tablei,
 
     // capy the real range
     range = Numerics::minVal(range, getLength() - startPos + 1);
-    char *scanPtr = getData() + startPos - 1;
-    size_t scanLength = range;
-
-    while (scanLength--)
-    {
-        char ch = *scanPtr;
-        size_t position;
-
-        if (tablei->getLength() != 0)
-        {
-            position = StringUtil::memPos(inTable, inTableLength, ch);
-        }
-        else
-        {
-            position = ((size_t)ch) & 0xff;
-        }
-        // if found in the table, need to convert
-        if (position != (size_t)(-1))
-        {
-            if (position < outTableLength)
-            {
-                *scanPtr = *(outTable + position);
-            }
-            // use the pad character if the output table is shorter
-            else
-            {
-                *scanPtr = padChar;
-            }
-        }
-        scanPtr++;
-    }
+    // resolve the tables into a single mapping table, then translate in place
+    char mapping[256];
+    StringUtil::buildTranslateTable(mapping, outTable, outTableLength, inTable, inTableLength, inTableLength != 0, padChar);
+    StringUtil::translateCharacters(getData() + startPos - 1, range, mapping);
     return this;
 }
 
@@ -64,6 +64,7 @@ class MutableBuffer : public RexxObject
     virtual void live(size_t);
     virtual void liveGeneral(MarkReason reason);
     virtual void flatten(Envelope *envelope);
+    virtual bool isValidFlattened(ValidatingMarkHandler &);
 
     virtual RexxInternalObject *copy();
     void        ensureCapacity(size_t addedLength);
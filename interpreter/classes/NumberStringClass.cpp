@@ -162,6 +162,20 @@ void NumberString::flatten(Envelope *envelope)
 }
 
 
+/**
+ * Check a number string from a flattened buffer.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if the digits are inside the object.
+ */
+bool NumberString::isValidFlattened(ValidatingMarkHandler &image)
+{
+    return digitsCount >= 0 && fitsInObject(numberDigits, (size_t)digitsCount, sizeof(char)) &&
+        (stringObject == OREF_NULL || image.typeOf(stringObject) == T_String);
+}
+
+
 /**
  * Set the number string's string value
  *
@@ -184,6 +184,7 @@ class NumberString : public NumberStringBase
     virtual void live(size_t);
     virtual void liveGeneral(MarkReason reason);
     virtual void flatten(Envelope *);
+    virtual bool isValidFlattened(ValidatingMarkHandler &);
 
     virtual bool numberValue(wholenumber_t &result, wholenumber_t precision);
     virtual bool numberValue(wholenumber_t &result);
@@ -66,6 +66,7 @@ class SecurityManager;
 class BaseExecutable;
 class Activity;
 class PointerTable;
+class ValidatingMarkHandler;
 
 
 typedef size_t HashCode;               // a hash code value
@@ -86,6 +87,7 @@ typedef enum
     SAVINGIMAGE,            // saving the Rexx image
     FLATTENINGOBJECT,       // marking to flatten an object
     UNFLATTENINGOBJECT,     // marking to unflatten an object
+    VALIDATINGOBJECT,       // checking a flattened object before unflattening
 } MarkReason;
 
 
@@ -260,6 +262,12 @@ class RexxInternalObject : public RexxVirtualBase
 
     inline RexxInternalObject *nextObject() { return (RexxInternalObject *)(((char *)this) + getObjectSize()); }
     inline RexxInternalObject *nextObject(size_t l) { return (RexxInternalObject *)(((char *)this) + l); }
+    // check that count items of the given size starting at a field are inside this object
+    inline bool fitsInObject(void *start, size_t count, size_t itemSize)
+    {
+        size_t offset = (char *)start - (char *)this;
+        return offset <= getObjectSize() && count <= (getObjectSize() - offset) / itemSize;
+    }
     // these clear everything after the hash value.
     inline void   clearObject() { memset(getObjectDataSpace(), '\0', getObjectDataSize()); }
     inline void   clearObject(size_t l) { memset(getObjectDataSpace(), '\0', l - getObjectHeaderSize()); }
@@ -295,6 +303,7 @@ class RexxInternalObject : public RexxVirtualBase
     inline void   setOldSpace() { header.setOldSpace(); }
     inline void   makeProxiedObject() { header.makeProxiedObject(); }
     inline bool   isProxyObject() { return header.isProxyObject(); }
+    inline bool   requiresProxyObject() { return header.requiresProxyObject(); }
            bool   isSubClassOrEnhanced();
            bool   isBaseClass();
            size_t getObjectTypeNumber();
@@ -305,6 +314,7 @@ class RexxInternalObject : public RexxVirtualBase
     inline void   setBehaviour(RexxBehaviour *b) { behaviour = b; }
 
     virtual RexxObject  *makeProxy(Envelope *);
+    virtual bool         isValidFlattened(ValidatingMarkHandler &) { return true; }
     virtual RexxInternalObject *copy();
     virtual RexxObject  *evaluate(RexxActivation *, ExpressionStack *) { return OREF_NULL; }
     virtual RexxObject  *getValue(RexxActivation *) { return OREF_NULL; }
@@ -66,6 +66,8 @@
 
 // singleton class instance
 RexxClass *PackageClass::classInstance = OREF_NULL;
+// version stamp for cached class resolutions
+size_t PackageClass::classTableVersion = 0;
 
 
 /**
@@ -218,6 +220,7 @@ void PackageClass::live(size_t liveMark)
     memory_mark(publicRoutines);
     memory_mark(libraries);
     memory_mark(requires);
+    memory_mark(bundledRequires);
     memory_mark(classes);
     memory_mark(resources);
     memory_mark(annotations);
@@ -260,6 +263,7 @@ void PackageClass::liveGeneral(MarkReason reason)
     memory_mark_general(publicRoutines);
     memory_mark_general(libraries);
     memory_mark_general(requires);
+    memory_mark_general(bundledRequires);
     memory_mark_general(classes);
     memory_mark_general(resources);
     memory_mark_general(annotations);
@@ -297,6 +301,7 @@ void PackageClass::flatten (Envelope *envelope)
     flattenRef(publicRoutines);
     flattenRef(libraries);
     flattenRef(requires);
+    flattenRef(bundledRequires);
     flattenRef(classes);
     flattenRef(resources);
     flattenRef(annotations);
@@ -640,6 +645,7 @@ void PackageClass::inheritPackageContext(PackageClass *parent)
 {
     // set this as a parent
     setField(parentPackage, parent);
+    classTablesChanged();
 }
 
 
@@ -651,6 +657,7 @@ void PackageClass::inheritPackageContext(PackageClass *parent)
  */
 void PackageClass::mergeRequired(PackageClass *mergeSource)
 {
+    classTablesChanged();
     // handle the directly defined public ones first, followed by any merged from
     // other sources.  This will maintain the proper search order.
     if (mergeSource->publicRoutines != OREF_NULL)
@@ -1172,6 +1179,7 @@ void PackageClass::processInstall(RexxActivation *activation)
         setField(installedClasses, new_string_table());
         /* and the public classes            */
         setField(installedPublicClasses, new_string_table());
+        classTablesChanged();
         Protected<ArrayClass> createdClasses = new_array(classes->items());
 
         size_t count = classes->items();
@@ -1209,6 +1217,19 @@ PackageClass *PackageClass::loadRequires(Activity *activity, RexxString *target)
     // we need the instance this is associated with
     InterpreterInstance *instance = activity->getInstance();
 
+    // a bundled image carries its compiled packages with it, so there is
+    // no file to search for.
+    if (bundledRequires != OREF_NULL)
+    {
+        PackageClass *bundled = (PackageClass *)bundledRequires->get(target);
+        if (bundled != OREF_NULL)
+        {
+            PackageClass *packageInstance = instance->loadRequires(activity, target, bundled);
+            addPackage(packageInstance);
+            return packageInstance;
+        }
+    }
+
     // get a fully resolved name for this....we might locate this under either name, but the
     // fully resolved name is generated from this source file context.
     RexxString *fullName = resolveProgramName(activity, target);
@@ -1228,6 +1249,66 @@ PackageClass *PackageClass::loadRequires(Activity *activity, RexxString *target)
 }
 
 
+/**
+ * Compile the transitive closure of this package's ::REQUIRES
+ * files and attach them to the package, so that a saved image
+ * of the package can be run without locating or translating
+ * any of the required files.
+ *
+ * @param activity The current activity.
+ */
+void PackageClass::bundleRequires(Activity *activity)
+{
+    Protected<StringTable> bundled = new_string_table();
+    bundleRequires(activity, bundled);
+}
+
+
+/**
+ * Bundle the ::REQUIRES files for a package.
+ *
+ * @param activity The current activity.
+ * @param bundled  The packages bundled so far, indexed by their resolved names.
+ *                 A package required from several places is only compiled once.
+ */
+void PackageClass::bundleRequires(Activity *activity, StringTable *bundled)
+{
+    if (requires == OREF_NULL)
+    {
+        return;
+    }
+
+    StringTable *packages = new_string_table();
+    setField(bundledRequires, packages);
+
+    size_t count = requires->items();
+    for (size_t i = 1; i <= count; i++)
+    {
+        RexxString *target = ((RequiresDirective *)requires->get(i))->getName();
+        RexxString *fullName = resolveProgramName(activity, target);
+        // things we can't find as files (such as macrospace entries) are left
+        // to be resolved at run time.
+        if (fullName == OREF_NULL)
+        {
+            continue;
+        }
+        ProtectedObject p(fullName);
+
+        PackageClass *package = (PackageClass *)bundled->get(fullName);
+        if (package == OREF_NULL)
+        {
+            Protected<PackageClass> newPackage = LanguageParser::createPackage(fullName);
+            bundled->put(newPackage, fullName);
+            // this goes into the image without its source, just like the main program
+            newPackage->detachSource();
+            newPackage->bundleRequires(activity, bundled);
+            package = newPackage;
+        }
+        bundledRequires->put(package, target);
+    }
+}
+
+
 /**
  * Load a ::REQUIRES directive from an provided source target
  *
@@ -1302,6 +1383,7 @@ void PackageClass::addInstalledClass(RexxString *name, RexxClass *classObject, b
         setField(installedClasses, new_string_table());
     }
     installedClasses->setEntry(name, classObject);
+    classTablesChanged();
     if (publicClass)
     {
         // make sure we have this created also
@@ -76,6 +76,11 @@ public:
     static void createInstance();
     static RexxClass *classInstance;
 
+    // bumped whenever any package class lookup table changes
+    static size_t classTableVersion;
+    static inline size_t getClassTableVersion() { return classTableVersion; }
+    static inline void classTablesChanged() { classTableVersion++; }
+
     void          deepCopy();
     void          setup();
     void          extractNameInformation();
@@ -88,6 +93,8 @@ public:
     void          mergeRequired(PackageClass *);
     PackageClass *loadRequires(Activity *activity, RexxString *target);
     PackageClass *loadRequires(Activity *activity, RexxString *target, ArrayClass *s);
+    void          bundleRequires(Activity *activity);
+    void          bundleRequires(Activity *activity, StringTable *bundled);
     void          addPackage(PackageClass *package);
     void          inheritPackageContext(PackageClass *parent);
     RoutineClass *findRoutine(RexxString *);
@@ -160,6 +167,9 @@ public:
     inline void enableProlog() { packageSettings.enableProlog(); }
     inline void disableProlog() { packageSettings.disableProlog(); }
     inline bool isPrologEnabled() { return packageSettings.isPrologEnabled() && initCode != OREF_NULL; }
+    inline void enableOptimize() { packageSettings.enableOptimize(); }
+    inline void disableOptimize() { packageSettings.disableOptimize(); }
+    inline bool isOptimizeEnabled() { return packageSettings.isOptimizeEnabled(); }
     inline RoutineClass *getMain() { return (RoutineClass *)mainExecutable; }
 
            RexxString    *getTrace();
@@ -227,6 +237,7 @@ protected:
     StringTable *resources;               // assets defined in the package
     StringTable *unattachedMethods;       // methods found on directives
     StringTable *namespaces;              // named packages
+    StringTable *bundledRequires;         // compiled ::REQUIRES packages carried in a bundled image
 
     // sections resolved from the install process.
 
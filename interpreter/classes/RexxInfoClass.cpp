@@ -48,6 +48,7 @@
 #include "MethodArguments.hpp"
 #include "Interpreter.hpp"
 #include "SystemInterpreter.hpp"
+#include "RexxCode.hpp"
 
 RexxClass *RexxInfo::classInstance = OREF_NULL;   // singleton class instance
 
@@ -326,6 +327,30 @@ RexxObject *RexxInfo::getRevision()
 }
 
 
+/**
+ * Get the number of INTERPRET instructions that reused a cached
+ * translation.
+ *
+ * @return The hit count as an Integer object.
+ */
+RexxObject *RexxInfo::getInterpretCacheHits()
+{
+    return new_integer(RexxCode::interpretCacheHits);
+}
+
+
+/**
+ * Get the number of INTERPRET instructions that had to translate
+ * their string.
+ *
+ * @return The miss count as an Integer object.
+ */
+RexxObject *RexxInfo::getInterpretCacheMisses()
+{
+    return new_integer(RexxCode::interpretCacheMisses);
+}
+
+
 /**
  * Retrieve the interpreter build date.
  *
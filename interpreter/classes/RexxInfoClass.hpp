@@ -86,6 +86,8 @@ public:
     RexxObject *getMajorVersion();
     RexxObject *getRelease();
     RexxObject *getRevision();
+    RexxObject *getInterpretCacheHits();
+    RexxObject *getInterpretCacheMisses();
 
     RexxObject *copyRexx();
     RexxObject *newRexx(RexxObject **args, size_t argc);
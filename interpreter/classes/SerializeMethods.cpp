@@ -0,0 +1,125 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 1995, 2004 IBM Corporation. All rights reserved.             */
+/* Copyright (c) 2005-2026 Rexx Language Association. All rights reserved.    */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* http://www.oorexx.org/license.html                                         */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*********************************************************************/
+/*                                                                   */
+/*  Function:  Native serialization methods of .SerializeFunctions   */
+/*                                                                   */
+/*********************************************************************/
+#include "RexxCore.h"
+
+
+/**
+ * Validate the optional package argument used to resolve
+ * class references on a restore.
+ *
+ * @param context  The method context.
+ * @param package  The package argument (can be NULLOBJECT).
+ * @param position The argument position.
+ *
+ * @return true if the argument is usable.
+ */
+static bool checkPackage(RexxMethodContext *context, RexxObjectPtr package, size_t position)
+{
+    if (package != NULLOBJECT && package != context->Nil() && !context->IsOfType(package, "PACKAGE"))
+    {
+        context->RaiseException2(Rexx_Error_Incorrect_method_noclass, context->StringSizeToObject(position), context->String("Package"));
+        return false;
+    }
+    return true;
+}
+
+
+/********************************************************************************************/
+/* serialize_pack                                                                           */
+/********************************************************************************************/
+RexxMethod1(RexxObjectPtr, serialize_pack, RexxObjectPtr, object)
+{
+    RexxBufferObject buffer = context->SerializeObject(object);
+    // an error has already been raised if this failed
+    if (buffer == NULLOBJECT)
+    {
+        return NULLOBJECT;
+    }
+    return context->NewString((CSTRING)context->BufferData(buffer), context->BufferLength(buffer));
+}
+
+
+/********************************************************************************************/
+/* serialize_unpack                                                                         */
+/********************************************************************************************/
+RexxMethod2(RexxObjectPtr, serialize_unpack, RexxObjectPtr, data, OPTIONAL_RexxObjectPtr, package)
+{
+    if (!checkPackage(context, package, 2))
+    {
+        return NULLOBJECT;
+    }
+    RexxPackageObject scope = package == context->Nil() ? NULLOBJECT : (RexxPackageObject)package;
+
+    // mutable buffers can be used directly, without creating a string copy first
+    if (context->IsMutableBuffer(data))
+    {
+        RexxMutableBufferObject buffer = (RexxMutableBufferObject)data;
+        return context->DeserializeObject(scope, (CSTRING)context->MutableBufferData(buffer), context->MutableBufferLength(buffer));
+    }
+
+    RexxStringObject string = context->ObjectToString(data);
+    return context->DeserializeObject(scope, context->StringData(string), context->StringLength(string));
+}
+
+
+/********************************************************************************************/
+/* serialize_save                                                                           */
+/********************************************************************************************/
+RexxMethod2(RexxObjectPtr, serialize_save, RexxObjectPtr, object, CSTRING, fileName)
+{
+    context->SerializeObjectToFile(object, fileName);
+    return NULLOBJECT;
+}
+
+
+/********************************************************************************************/
+/* serialize_restore                                                                        */
+/********************************************************************************************/
+RexxMethod2(RexxObjectPtr, serialize_restore, CSTRING, fileName, OPTIONAL_RexxObjectPtr, package)
+{
+    if (!checkPackage(context, package, 2))
+    {
+        return NULLOBJECT;
+    }
+    RexxPackageObject scope = package == context->Nil() ? NULLOBJECT : (RexxPackageObject)package;
+    return context->DeserializeObjectFromFile(scope, fileName);
+}
@@ -1262,6 +1262,140 @@ void StemClass::dropElement(CompoundVariableTail &resolved_tail)
 }
 
 
+/**
+ * Set a block of stem variables using simple string tails as
+ * the result of a bulk api call.
+ *
+ * @param tailNames The tail names of the target elements.
+ * @param values    The values to assign.  A NULL value drops the
+ *                  corresponding element.
+ * @param count     The number of elements to set.
+ */
+void StemClass::setElements(const char **tailNames, RexxObject **values, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        CompoundVariableTail resolved_tail(tailNames[i]);
+        if (values[i] == OREF_NULL)
+        {
+            dropElement(resolved_tail);
+        }
+        else
+        {
+            getCompoundVariable(resolved_tail)->set(values[i]);
+        }
+    }
+}
+
+
+/**
+ * Set a block of stem variables with consecutive numeric tails
+ * as the result of a bulk api call.
+ *
+ * @param start  The tail of the first element to set.
+ * @param values The values to assign.  A NULL value drops the
+ *               corresponding element.
+ * @param count  The number of elements to set.
+ */
+void StemClass::setArrayElements(size_t start, RexxObject **values, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        CompoundVariableTail resolved_tail(start + i);
+        if (values[i] == OREF_NULL)
+        {
+            dropElement(resolved_tail);
+        }
+        else
+        {
+            getCompoundVariable(resolved_tail)->set(values[i]);
+        }
+    }
+}
+
+
+/**
+ * Retrieve a block of stem variables using simple string tails
+ * as the result of a bulk api call.
+ *
+ * @param tailNames The tail names of the requested elements.
+ * @param values    The buffer that receives the values.  Elements
+ *                  that do not exist are returned as NULL.
+ * @param count     The number of elements to retrieve.
+ *
+ * @return The number of elements that had a value.
+ */
+size_t StemClass::getElements(const char **tailNames, RexxObject **values, size_t count)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        CompoundVariableTail resolved_tail(tailNames[i]);
+        values[i] = getElement(resolved_tail);
+        if (values[i] != OREF_NULL)
+        {
+            found++;
+        }
+    }
+    return found;
+}
+
+
+/**
+ * Retrieve a block of stem variables with consecutive numeric
+ * tails as the result of a bulk api call.
+ *
+ * @param start  The tail of the first element to retrieve.
+ * @param values The buffer that receives the values.  Elements
+ *               that do not exist are returned as NULL.
+ * @param count  The number of elements to retrieve.
+ *
+ * @return The number of elements that had a value.
+ */
+size_t StemClass::getArrayElements(size_t start, RexxObject **values, size_t count)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        CompoundVariableTail resolved_tail(start + i);
+        values[i] = getElement(resolved_tail);
+        if (values[i] != OREF_NULL)
+        {
+            found++;
+        }
+    }
+    return found;
+}
+
+
+/**
+ * Create a flat snapshot of all of the stem elements for the
+ * native api.  The tail names and values are stored as
+ * alternating items (name1, value1, name2, value2, ...) in a
+ * single array, which is much cheaper to build than a directory.
+ *
+ * @return An array of name/value pairs.
+ */
+ArrayClass *StemClass::elementSnapshot()
+{
+    ArrayClass *result = new_array(items() * 2);
+    size_t index = 1;
+
+    CompoundTableElement *variable = tails.first();
+    while (variable != OREF_NULL)
+    {
+        // only include the elements with real values
+        if (variable->getVariableValue() != OREF_NULL)
+        {
+            result->put(variable->getName(), index++);
+            result->put(variable->getVariableValue(), index++);
+        }
+        variable = tails.next(variable);
+    }
+    return result;
+}
+
+
 /**
  * Create a full compound name from a constructed compound taile.
  *
@@ -154,6 +154,11 @@ class StemClass : public RexxObject
     RexxObject *getElement(size_t tail);
     RexxObject *getElement(const char *tail);
     RexxObject *getElement(CompoundVariableTail &tail);
+    void setElements(const char **tailNames, RexxObject **values, size_t count);
+    void setArrayElements(size_t start, RexxObject **values, size_t count);
+    size_t getElements(const char **tailNames, RexxObject **values, size_t count);
+    size_t getArrayElements(size_t start, RexxObject **values, size_t count);
+    ArrayClass *elementSnapshot();
 
     CompoundVariableTable::TableIterator iterator();
 
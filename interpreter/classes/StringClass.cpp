@@ -130,6 +130,11 @@ HashCode RexxString::getObjectHashCode()
 void RexxString::live(size_t liveMark)
 {
     memory_mark(numberStringValue);
+    memory_mark(wordTable);
+    if (isTailView())
+    {
+        memory_mark(((StringTailView *)this)->viewParent);
+    }
     memory_mark(objectVariables);
 }
 
@@ -146,8 +151,15 @@ void RexxString::liveGeneral(MarkReason reason)
     if (reason == PREPARINGIMAGE)
     {
         numberString();
+        // the word index is rebuilt on demand
+        wordTable = OREF_NULL;
     }
     memory_mark_general(numberStringValue);
+    memory_mark_general(wordTable);
+    if (isTailView())
+    {
+        memory_mark_general(((StringTailView *)this)->viewParent);
+    }
     memory_mark_general(objectVariables);
 }
 
@@ -163,11 +175,50 @@ void RexxString::flatten(Envelope *envelope)
 
     flattenRef(numberStringValue);
     flattenRef(objectVariables);
+    if (isTailView())
+    {
+        // the parent reference is not part of the RexxString fields
+        StringTailView *newView = (StringTailView *)newThis;
+        envelope->flattenReference((void *)&newThis, newSelf, (void *)&(newView->viewParent));
+    }
+    // the word index is rebuilt on demand
+    newThis->wordTable = OREF_NULL;
 
     cleanUpFlatten
 }
 
 
+/**
+ * Check a string from a flattened buffer.  The string data
+ * must be inside the object, or for a tail view, inside the
+ * parent string.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if the string can be unflattened.
+ */
+bool RexxString::isValidFlattened(ValidatingMarkHandler &image)
+{
+    // the word index is never part of the flattened string
+    if (wordTable != OREF_NULL)
+    {
+        return false;
+    }
+    if (isTailView())
+    {
+        if (getObjectSize() < sizeof(StringTailView) || image.typeOf(getViewParent()) != T_String)
+        {
+            return false;
+        }
+        // views always share the data of a flat string
+        RexxString *parent = (RexxString *)image.resolve(getViewParent());
+        return !parent->isTailView() && parent->length >= length;
+    }
+    // there needs to be room for the terminating null too
+    return length < getObjectSize() && fitsInObject(stringData, length + 1, sizeof(char));
+}
+
+
 /**
  * unflatten an object
  *
@@ -177,8 +228,13 @@ void RexxString::flatten(Envelope *envelope)
  */
 RexxInternalObject *RexxString::unflatten(Envelope *envelope)
 {
-    // if this has been proxied, then retrieve our target object from the environment
-    if (isProxyObject())
+    // if this has been proxied, then retrieve our target object from the environment.
+    // An object serialization has the envelope locate the target object.
+    if (envelope->isSerializing() && requiresProxyObject())
+    {
+        return envelope->resolveProxy(this);
+    }
+    else if (!envelope->isSerializing() && isProxyObject())
     {
         return TheEnvironment->entry(this);
     }
@@ -190,6 +246,51 @@ RexxInternalObject *RexxString::unflatten(Envelope *envelope)
 }
 
 
+/**
+ * Copy a string object.  A shared tail view is copied into a
+ * string holding its own data, so the copy can be modified
+ * without touching the string the view shares data with.
+ *
+ * @return A new copy of the string.
+ */
+RexxInternalObject *RexxString::copy()
+{
+    if (isTailView())
+    {
+        return new_string(getStringData(), getLength());
+    }
+    return RexxObject::copy();
+}
+
+
+/**
+ * Extract the trailing part of a string, starting at an
+ * offset.  Long tails share the data of this string rather than
+ * copying it, which keeps repeated "take the rest" operations
+ * from copying the remainder of a large string each time.  The
+ * tail of a string is still null terminated, so a view can be
+ * used anywhere a string can.  Short tails, or tails that only
+ * use a small part of a large string, are copied so that a
+ * small result does not keep a large string alive.
+ *
+ * @param offset The offset of the first character of the tail.
+ *
+ * @return A string containing the tail.
+ */
+RexxString *RexxString::extractTail(size_t offset)
+{
+    size_t tailLength = getLength() - offset;
+    // views always reference the string actually holding the data
+    RexxString *dataOwner = isTailView() ? getViewParent() : this;
+
+    if (tailLength < TAIL_VIEW_MINIMUM || tailLength < dataOwner->getLength() / TAIL_VIEW_RATIO)
+    {
+        return newString(getStringData() + offset, tailLength);
+    }
+    return newTailView(dataOwner, tailLength);
+}
+
+
 /**
  * Return the primitive string value of this object
  *
@@ -1342,20 +1443,12 @@ bool RexxString::logicalValue(logical_t &result)
  */
 bool RexxString::checkLower()
 {
-    const char *data = getStringData();
-    const char *endData = data + getLength();
-
-    // loop until we find a lower case character
-    while (data < endData)
+    // if we have a lower case character, mark as having lower
+    // case characters and return
+    if (StringUtil::hasLowerCase(getStringData(), getLength()))
     {
-        // if we have a lower case character, mark as having lower
-        // case characters and return
-        if (*data != toupper(*data))
-        {
-            setHasLower();
-            return true;
-        }
-        data++;
+        setHasLower();
+        return true;
     }
     // we can mark this as having no lower case characters
     setUpperOnly();
@@ -1371,20 +1464,12 @@ bool RexxString::checkLower()
  */
 bool RexxString::checkUpper()
 {
-    const char *data = getStringData();
-    const char *endData = data + getLength();
-
-    // loop until we find a lower case character
-    while (data < endData)
+    // if we have a upper case character, mark as having upper
+    // case characters and return
+    if (StringUtil::hasUpperCase(getStringData(), getLength()))
     {
-        // if we have a upper case character, mark as having lower
-        // case characters and return
-        if (*data != tolower(*data))
-        {
-            setHasUpper();
-            return true;
-        }
-        data++;
+        setHasUpper();
+        return true;
     }
     // we can mark this as having no upper case characters
     setLowerOnly();
@@ -1405,16 +1490,9 @@ RexxString *RexxString::upper()
     if (!upperOnly() && (hasLower() || checkLower()))
     {
         RexxString *newstring = raw_string(getLength());
-        const char *data = getStringData();
-
-        char *outdata = newstring->getWritableData();
-        const char *endData = data + getLength();
 
         // copy the data over, uppercasing as we go.
-        while (data < endData)
-        {
-            *outdata++ = toupper(*data++);
-        }
+        StringUtil::upperCase(getStringData(), newstring->getWritableData(), getLength());
         // we know this string does not contain lowercase characters
         newstring->setUpperOnly();
         return newstring;
@@ -1488,15 +1566,9 @@ RexxString *RexxString::lower()
     {
 
         RexxString *newstring = raw_string(getLength());
-        const char *data = getStringData();
-        const char *endData = data + getLength();
-        char *outdata = newstring->getWritableData();
 
         // copy the data over, lowercasing as we go.
-        while (data < endData)
-        {
-            *outdata++ = tolower(*data++);
-        }
+        StringUtil::lowerCase(getStringData(), newstring->getWritableData(), getLength());
         // we know this string does not contain uppercase characters
         newstring->setLowerOnly();
         return newstring;
@@ -1592,11 +1664,7 @@ RexxString *RexxString::lower(size_t offset, size_t _length)
 
     char *data = newstring->getWritableData() + offset;
     // now lowercase in place
-    for (size_t i = 0; i < _length; i++)
-    {
-        *data = tolower(*data);
-        data++;
-    }
+    StringUtil::lowerCase(data, data, _length);
     return newstring;
 }
 
@@ -1622,11 +1690,7 @@ RexxString *RexxString::upper(size_t offset, size_t _length)
 
     char *data = newstring->getWritableData() + offset;
     // now uppercase in place
-    for (size_t i = 0; i < _length; i++)
-    {
-        *data = toupper(*data);
-        data++;
-    }
+    StringUtil::upperCase(data, data, _length);
     return newstring;
 }
 
@@ -1682,7 +1746,7 @@ void RexxString::setNumberString(NumberString *numberRep)
     {
         setHasReferences();
     }
-    else
+    else if (wordTable == OREF_NULL && !isTailView())
     {
         setHasNoReferences();
     }
@@ -1975,6 +2039,30 @@ RexxString *RexxString::rawString(size_t length)
 }
 
 
+/**
+ * Allocate a string object that shares the trailing data of
+ * another string.
+ *
+ * @param parent The string holding the data.
+ * @param length The length of the tail.
+ *
+ * @return A new string object viewing the parent's data.
+ */
+RexxString *RexxString::newTailView(RexxString *parent, size_t length)
+{
+    // the view has no data of its own
+    StringTailView *newObj = (StringTailView *)new_object(sizeof(StringTailView), T_String);
+
+    newObj->setLength(length);
+    newObj->hashValue = 0;
+    newObj->viewParent = parent;
+    newObj->attributes.set(STRING_TAILVIEW);
+    // the parent reference needs marking
+    newObj->setHasReferences();
+    return newObj;
+}
+
+
 /**
  * Allocate an initialize a string object that will also
  * contain only uppercase characters.  This allows a creation
@@ -1997,15 +2085,7 @@ RexxString *RexxString::newUpperString(const char * string, size_t length)
     newObj->setLength(length);
     newObj->hashValue = 0;               // make sure the hash value is zeroed
 
-    char *outdata = newObj->getWritableData();
-    // set the input markers
-    const char *indata = string;
-    const char *endData = indata + length;
-
-    while (indata < endData)
-    {
-        *outdata++ = toupper(*indata++);
-    }
+    StringUtil::upperCase(string, newObj->getWritableData(), length);
     // flag as containing only uppercase characters
     newObj->setUpperOnly();
 
@@ -50,6 +50,8 @@
 #include "FlagSet.hpp"
 #include <string.h>
 
+class BufferClass;
+
 /**
  * Return type from string isSymbol() method.
  */
@@ -75,6 +77,7 @@ class RexxString : public RexxObject
         STRING_HASUPPER,
         STRING_NOUPPER,
         STRING_NONNUMERIC,
+        STRING_TAILVIEW,
      } StringFlag;
 
 
@@ -105,8 +108,10 @@ class RexxString : public RexxObject
      class WordIterator
      {
      public:
-         inline WordIterator(const char *b, size_t l) : nextPosition(b), scanLength(l) {}
-         inline WordIterator(RexxString *s) : nextPosition(s->getStringData()), scanLength(s->getLength()) {}
+         inline WordIterator(const char *b, size_t l) : nextPosition(b), scanLength(l), data(b), dataLength(l), offsets(NULL), wordNumber(0) {}
+         inline WordIterator(const char *b, size_t l, const size_t *o) : nextPosition(b), scanLength(l), data(b), dataLength(l), offsets(o), wordNumber(0) {}
+         inline WordIterator(RexxString *s) : nextPosition(s->getStringData()), scanLength(s->getLength()),
+             data(s->getStringData()), dataLength(s->getLength()), offsets(NULL), wordNumber(0) {}
 
          /**
           * Skip leading blanks in a string.
@@ -194,11 +199,26 @@ class RexxString : public RexxObject
              skipNonBlanks(nextPosition, scanLength);
              // get the length of the next word
              currentWordLength -= scanLength;
+             wordNumber++;
              // we have a word
              return true;
          }
 
 
+         /**
+          * Position the iterator on a word using the word index.
+          *
+          * @param number The target word number (origin 1).
+          */
+         inline void seekWord(size_t number)
+         {
+             nextPosition = data + offsets[number];
+             scanLength = dataLength - offsets[number];
+             wordNumber = number - 1;
+             next();
+         }
+
+
          /**
           * Skip over a given number of words.  Returns true if
           * the count was reached before the end of the string, false
@@ -210,6 +230,24 @@ class RexxString : public RexxObject
           */
          inline bool skipWords(size_t count)
          {
+             // with a word index, we can jump directly to the target word.  When
+             // we run out of words, we end up in the same state a scan would leave.
+             if (offsets != NULL && count > 0)
+             {
+                 size_t target = wordNumber + count;
+                 if (target <= offsets[0])
+                 {
+                     seekWord(target);
+                     return true;
+                 }
+                 if (offsets[0] > wordNumber)
+                 {
+                     seekWord(offsets[0]);
+                 }
+                 next();
+                 return false;
+             }
+
              while (count--)
              {
                  if (!next())
@@ -282,6 +320,10 @@ class RexxString : public RexxObject
          const char *nextPosition;      // the next scan position
          size_t currentWordLength;      // the length of the current word match
          size_t scanLength;             // the remaining scan length
+         const char *data;              // the start of the scanned data
+         size_t dataLength;             // the total length of the data
+         const size_t *offsets;         // optional word index (count followed by word offsets)
+         size_t wordNumber;             // the number of the current word
      };
 
 
@@ -292,6 +334,8 @@ class RexxString : public RexxObject
     virtual void liveGeneral(MarkReason reason);
     virtual void flatten(Envelope *envelope);
     virtual RexxInternalObject *unflatten(Envelope *);
+    virtual bool isValidFlattened(ValidatingMarkHandler &);
+    virtual RexxInternalObject *copy();
 
     virtual HashCode getHashValue();
 
@@ -308,7 +352,7 @@ class RexxString : public RexxObject
             // This hashing algorithm is very similar to that used for Java strings.
             for (size_t i = 0; i < len; i++)
             {
-                h = 31 * h + stringData[i];
+                h = 31 * h + getStringData()[i];
             }
             hashValue = h;
         }
@@ -396,6 +440,7 @@ class RexxString : public RexxObject
     RexxObject *format(RexxObject *Integers, RexxObject *Decimals, RexxObject *MathExp, RexxObject *ExpTrigger);
     RexxObject *logicalOperation(RexxObject *, RexxObject *, unsigned int);
     RexxString *extract(size_t offset, size_t sublength) { return newString(getStringData() + offset, sublength); }
+    RexxString *extractTail(size_t offset);
     virtual RexxObject *evaluate(RexxActivation *, ExpressionStack *);
     virtual RexxObject *getValue(RexxActivation *);
     virtual RexxObject *getValue(VariableDictionary *);
@@ -427,6 +472,7 @@ class RexxString : public RexxObject
     RexxObject  *containsWord(RexxString *, RexxInteger *);
     RexxObject  *caselessContainsWord(RexxString *, RexxInteger *);
     RexxInteger *words();
+    const size_t *wordOffsets();
                                         /* the following methods are in    */
                                         /* OKBMISC                         */
     RexxString  *changeStr(RexxString *, RexxString *, RexxInteger *);
@@ -505,12 +551,18 @@ class RexxString : public RexxObject
     inline bool isNullString() const { return length == 0; }
     inline void  setLength(size_t l) { length = l; }
     inline void  finish(size_t l) { length = l; }
-    inline const char *getStringData() const { return stringData; }
-    inline char *getWritableData() { return &stringData[0]; }
+    inline const char *getStringData() const
+    {
+        // a shared tail view uses the trailing section of its parent's data
+        return isTailView() ? tailViewData() : stringData;
+    }
+    // NOTE: only strings still being built may be written to.  This
+    // resolves a tail view so it can never point past the object.
+    inline char *getWritableData() { return const_cast<char *>(getStringData()); }
     inline void  put(size_t s, const void *b, size_t l) { memcpy(getWritableData() + s, b, l); }
     inline void  put(size_t s, RexxString *o) { put(s, o->getStringData(), o->getLength()); }
     inline void  set(size_t s,int c, size_t l) { memset((stringData+s), c, l); }
-    inline char  getChar(size_t p) const { return *(stringData+p); }
+    inline char  getChar(size_t p) const { return *(getStringData()+p); }
     inline char  putChar(size_t p,char c) { return *(stringData+p) = c; }
     inline bool  upperOnly() const {return attributes[STRING_NOLOWER];}
     inline bool  hasLower() const {return attributes[STRING_HASLOWER]; }
@@ -522,17 +574,20 @@ class RexxString : public RexxObject
     inline void  setHasUpper() { attributes.set(STRING_HASUPPER);}
     inline bool  nonNumeric() const {return attributes[STRING_NONNUMERIC];}
     inline void  setNonNumeric() { attributes.set(STRING_NONNUMERIC);}
+    inline bool  isTailView() const { return attributes[STRING_TAILVIEW]; }
+    inline RexxString *getViewParent() const;
+    inline const char *tailViewData() const;
     inline bool  strCompare(const char * s) const { return memCompare((s), strlen(s)); }
-    inline bool  strCaselessCompare(const char * s) const { return (size_t)length == strlen(s) && Utilities::strCaselessCompare(s, stringData) == 0;}
-    inline bool  strCaselessCompare(RexxString *s) const { return length == s->getLength() && Utilities::strCaselessCompare(s->getStringData(), stringData) == 0;}
-    inline bool  memCompare(const char * s, size_t l) const { return l == length && memcmp(s, stringData, l) == 0; }
-    inline bool  memCompare(RexxString *other) const { return other->length == length && memcmp(other->stringData, stringData, length) == 0; }
-    inline bool  strCompare(RexxString *other) const { return other->length == length && memcmp(other->stringData, stringData, length) == 0; }
-    inline void  memCopy(char * s) const { memcpy(s, stringData, length); }
+    inline bool  strCaselessCompare(const char * s) const { return (size_t)length == strlen(s) && Utilities::strCaselessCompare(s, getStringData()) == 0;}
+    inline bool  strCaselessCompare(RexxString *s) const { return length == s->getLength() && Utilities::strCaselessCompare(s->getStringData(), getStringData()) == 0;}
+    inline bool  memCompare(const char * s, size_t l) const { return l == length && memcmp(s, getStringData(), l) == 0; }
+    inline bool  memCompare(RexxString *other) const { return other->length == length && memcmp(other->getStringData(), getStringData(), length) == 0; }
+    inline bool  strCompare(RexxString *other) const { return other->length == length && memcmp(other->getStringData(), getStringData(), length) == 0; }
+    inline void  memCopy(char * s) const { memcpy(s, getStringData(), length); }
     inline void  toRxstring(CONSTRXSTRING &r) { r.strptr = getStringData(); r.strlength = getLength(); }
-    inline void  toRxstring(RXSTRING &r) { r.strptr = getWritableData(); r.strlength = getLength(); }
+    inline void  toRxstring(RXSTRING &r) { r.strptr = const_cast<char *>(getStringData()); r.strlength = getLength(); }
            void  copyToRxstring(RXSTRING &r);
-    inline bool  endsWith(char c) const { return length > 0 && stringData[length - 1] == c; }
+    inline bool  endsWith(char c) const { return length > 0 && getStringData()[length - 1] == c; }
 
     inline int sortCompare(RexxString *other)
     {
@@ -541,7 +596,7 @@ class RexxString : public RexxObject
         {
             compareLength = other->length;
         }
-        int result = memcmp(stringData, other->stringData, compareLength);
+        int result = memcmp(getStringData(), other->getStringData(), compareLength);
         if (result == 0)
         {
             if (length > other->length)
@@ -563,7 +618,7 @@ class RexxString : public RexxObject
         {
             compareLength = other->length;
         }
-        int result = StringUtil::caselessCompare(stringData, other->stringData, compareLength);
+        int result = StringUtil::caselessCompare(getStringData(), other->getStringData(), compareLength);
         if (result == 0)
         {
             if (length > other->length)
@@ -595,7 +650,7 @@ class RexxString : public RexxObject
                 compareLength = stringLength;
             }
 
-            result = memcmp(stringData + startCol, other->stringData + startCol, compareLength);
+            result = memcmp(getStringData() + startCol, other->getStringData() + startCol, compareLength);
             if (result == 0 && stringLength < colLength)
             {
                 if (length > other->length)
@@ -639,7 +694,7 @@ class RexxString : public RexxObject
                 compareLength = stringLength;
             }
 
-            result = StringUtil::caselessCompare(stringData + startCol, other->stringData + startCol, compareLength);
+            result = StringUtil::caselessCompare(getStringData() + startCol, other->getStringData() + startCol, compareLength);
             if (result == 0 && stringLength < colLength)
             {
                 if (length > other->length)
@@ -674,6 +729,7 @@ class RexxString : public RexxObject
 
     static RexxString *newString(const char *, size_t);
     static RexxString *rawString(size_t);
+    static RexxString *newTailView(RexxString *, size_t);
     static RexxString *newUpperString(const char *, size_t);
     static RexxString *newString(double d);
     static RexxString *newString(double d, size_t precision);
@@ -686,6 +742,13 @@ class RexxString : public RexxObject
     static RexxClass *classInstance;
 
     // Strip method options
+    // strings shorter than this are scanned for each word operation
+    static const size_t WORD_INDEX_THRESHOLD = 256;
+    // tails shorter than this are always copied
+    static const size_t TAIL_VIEW_MINIMUM = 256;
+    // a tail view must cover at least 1/TAIL_VIEW_RATIO of the string holding the data
+    static const size_t TAIL_VIEW_RATIO = 4;
+
     static const char STRIP_BOTH =              'B';
     static const char STRIP_LEADING =           'L';
     static const char STRIP_TRAILING =          'T';
@@ -735,11 +798,42 @@ class RexxString : public RexxObject
     HashCode hashValue;                      // stored has value
     size_t length;                           // string length
     NumberString *numberStringValue;         // lookaside information
+    BufferClass  *wordTable;                 // lazily built word offsets for long strings
     FlagSet<StringFlag, 32> attributes;      // string attributes
     char stringData[4];                      // Start of the string data part
 };
 
 
+/**
+ * A string sharing the trailing data of another string.  A tail
+ * view has no data of its own, so the reference to the string
+ * holding the data follows the string fields.  Flat strings don't
+ * carry this field at all.
+ */
+class StringTailView : public RexxString
+{
+    friend class RexxString;
+
+ protected:
+
+    RexxString *viewParent;                  // string holding the shared data
+};
+
+
+inline RexxString *RexxString::getViewParent() const
+{
+    return ((const StringTailView *)this)->viewParent;
+}
+
+
+inline const char *RexxString::tailViewData() const
+{
+    // views always reference the string actually holding the data
+    RexxString *parent = getViewParent();
+    return parent->stringData + (parent->length - length);
+}
+
+
 // String creation inline functions
 
 inline RexxString *new_string(const char *s, size_t l)
@@ -45,6 +45,7 @@
 #include "RexxCore.h"
 #include "StringClass.hpp"
 #include "MethodArguments.hpp"
+#include "StringUtil.hpp"
 
 
 /**
@@ -99,18 +100,10 @@ RexxString *RexxString::bitAnd(RexxString *string2, RexxString *pad)
     memcpy(target, padString, maxLength);
 
     // now peform the AND operation between the two strings
-    while (minLength--)
-    {
-        *target = *target & *source++;
-        target++;
-    }
+    StringUtil::bitOperation(StringUtil::BIT_AND, target, source, minLength);
 
     // now do the end part with the pad character
-    while (padLength--)
-    {
-        *target = *target & padChar;
-        target++;
-    }
+    StringUtil::bitOperation(StringUtil::BIT_AND, target + minLength, padChar, padLength);
 
     return retval;
 }
@@ -168,18 +161,10 @@ RexxString *RexxString::bitOr(RexxString *string2, RexxString *pad)
     memcpy(target, padString, maxLength);
 
     // now peform the AND operation between the two strings
-    while (minLength--)
-    {
-        *target = *target | *source++;
-        target++;
-    }
+    StringUtil::bitOperation(StringUtil::BIT_OR, target, source, minLength);
 
     // now do the end part with the pad character
-    while (padLength--)
-    {
-        *target = *target | padChar;
-        target++;
-    }
+    StringUtil::bitOperation(StringUtil::BIT_OR, target + minLength, padChar, padLength);
 
     return retval;
 }
@@ -235,18 +220,10 @@ RexxString *RexxString::bitXor(RexxString *string2, RexxString *pad)
     memcpy(target, padString, maxLength);
 
     // now peform the XOR operation between the two strings
-    while (minLength--)
-    {
-        *target = *target ^ *source++;
-        target++;
-    }
+    StringUtil::bitOperation(StringUtil::BIT_XOR, target, source, minLength);
 
     // now do the end part with the pad character
-    while (padLength--)
-    {
-        *target = *target ^ padChar;
-        target++;
-    }
+    StringUtil::bitOperation(StringUtil::BIT_XOR, target + minLength, padChar, padLength);
 
     return retval;
 }
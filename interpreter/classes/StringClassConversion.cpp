@@ -50,6 +50,15 @@
 #include "MethodArguments.hpp"
 #include "NumberStringClass.hpp"
 
+// the X2B expansion of each hex digit value
+static const char NIBBLE_BITS[16][4] =
+{
+    {'0','0','0','0'}, {'0','0','0','1'}, {'0','0','1','0'}, {'0','0','1','1'},
+    {'0','1','0','0'}, {'0','1','0','1'}, {'0','1','1','0'}, {'0','1','1','1'},
+    {'1','0','0','0'}, {'1','0','0','1'}, {'1','0','1','0'}, {'1','0','1','1'},
+    {'1','1','0','0'}, {'1','1','0','1'}, {'1','1','1','0'}, {'1','1','1','1'},
+};
+
 
 /**
  * Convert the character string into the same string with the
@@ -86,56 +95,32 @@ RexxString *RexxString::encodeBase64()
 
     char *destination = retval->getWritableData();
 
-    // loop through the entire string
-    while (inputLength > 0)
+    // encode all of the complete 3 character groups.  Each 24 bits of
+    // input is broken up into four 6-bit base64 digits.
+    for (; inputLength >= 3; inputLength -= 3)
     {
-        size_t inc[3];    // digit accumulator
-        int buflen = 0;
-        // the encoding is done 3 characters at a time.
-        for (int i = 0; i < 3; i++)
-        {
-            // we always do 3 characters, even at the end
-            // of the string.  If we still have characters
-            // left, grab that characters into our accumulator
-            // buffer
-            if (inputLength > 0)
-            {
-                // make sure we just get 8 bits
-                inc[i] = *source & 0xff;
-                inputLength--;
-                source++;
-                buflen++;
-            }
-            // this piece is just zero.  We also
-            // do not add this to the buffer length
-            else
-            {
-                inc[i] = '\0';
-            }
-        }
-        if (buflen > 0)
+        unsigned int group = ((unsigned char)source[0] << 16) | ((unsigned char)source[1] << 8) | (unsigned char)source[2];
+        destination[0] = DIGITS_BASE64[group >> 18];
+        destination[1] = DIGITS_BASE64[(group >> 12) & 0x3f];
+        destination[2] = DIGITS_BASE64[(group >> 6) & 0x3f];
+        destination[3] = DIGITS_BASE64[group & 0x3f];
+        source += 3;
+        destination += 4;
+    }
+
+    // a final partial group is encoded with zero bits for the missing
+    // characters, and "=" placeholders for the unused digits.
+    if (inputLength > 0)
+    {
+        unsigned int group = (unsigned char)source[0] << 16;
+        if (inputLength > 1)
         {
-            // now perform the base64 conversion to the next 4 output string chars.
-            // we are picking up 6 bits at a time from the 24 bits of input characters
-            // and converting those bits to a single base-64 digit.
-
-            // 6 bits from first character
-            *destination = DIGITS_BASE64[ inc[0] >> 2 ];
-            destination++;
-
-            // remaining 2 bits from first character, plus 4 bits from the second character
-            *destination = DIGITS_BASE64[ ((inc[0] & 0x03) << 4) | ((inc[1] & 0xf0) >> 4) ];
-            destination++;
-
-            // remaining bits from second char, plus 2 bits from the last character.  If we don't have
-            // a character here, use "="
-            *destination = (char) (buflen > 1 ? DIGITS_BASE64[ ((inc[1] & 0x0f) << 2) | ((inc[2] & 0xc0) >> 6) ] : '=');
-            destination++;
-
-            // the final 6 bits...again, using "=" if we did not have a character here at the end.
-            *destination = (char) (buflen > 2 ? DIGITS_BASE64[ inc[2] & 0x3f ] : '=');
-            destination++;
+            group |= (unsigned char)source[1] << 8;
         }
+        destination[0] = DIGITS_BASE64[group >> 18];
+        destination[1] = DIGITS_BASE64[(group >> 12) & 0x3f];
+        destination[2] = inputLength > 1 ? DIGITS_BASE64[(group >> 6) & 0x3f] : '=';
+        destination[3] = '=';
     }
     return retval;
 }
@@ -189,11 +174,11 @@ RexxString *RexxString::decodeBase64()
         {
             char ch = *source++;
 
-            // first, find the matching character
-            const char *match = strchr(DIGITS_BASE64, ch);
-            // if we did not find a match, this could be
+            // first, get the digit value
+            int digitValue = StringUtil::base64DigitValue(ch);
+            // if this is not a digit, this could be
             // an end of buffer filler characters
-            if (match == NULL)
+            if (digitValue < 0)
             {
                 // if this is '=' and we're looking at
                 // one of the last two digits, we've hit the
@@ -207,9 +192,6 @@ RexxString *RexxString::decodeBase64()
                 reportException(Error_Incorrect_method_invbase64);
             }
 
-            // get the reduced digit value
-            int digitValue = (int)(match - DIGITS_BASE64);
-
             // digit value is the binary value of this digit.  Now, based
             // on which digit of the input set we're working on, we update
             // the values in the output buffer.  We only have 6 bits of
@@ -270,19 +252,8 @@ RexxString *RexxString::c2x()
 
     char *destination = retval->getWritableData();
 
-    // process the entire string length
-    while (inputLength--)
-    {
-        char ch = *source++;
-        // get upper nibble after shifting out lower nibble and do
-        // logical ANDING with F to convert to integer then convert
-        // to hex value and put it in destination
-        *destination++ = intToHexDigit((ch>>4) & 0xF);
-
-        // logical AND with F to convert lower nibble to integer
-        // then convert to hex value and put it in destination
-        *destination++ = intToHexDigit(ch  & 0xF);
-    }
+    // each character expands into a pair of hex digits
+    StringUtil::encodeHex(source, inputLength, destination);
 
     return retval;
 }
@@ -406,7 +377,7 @@ RexxString *RexxString::x2dC2d(RexxInteger *_length, bool type )
     // in question, so we need a non-constant pointer to the data.  We will be
     // performing the operation on a copy of the string (either a packed hex string
     // or just a temporary copy we will discard).
-    char *stringPtr = getWritableData();
+    char *stringPtr = const_cast<char *>(getStringData());
     // assume an even nibble position
     size_t nibblePosition = 0;
 
@@ -621,42 +592,33 @@ RexxString *RexxString::b2x()
     }
 
     // validate the string content, getting a bit count back.
-    size_t bits = StringUtil::validateSet(getStringData(), getLength(), "01", 4, false);
+    size_t bits = StringUtil::validateSet(getStringData(), getLength(), 4, false);
     // every 4 bits will be one hex character in the result
     RexxString *retval = raw_string((bits + 3) / 4);
 
     char *destination = retval->getWritableData();
     const char *source = getStringData();
-    size_t length = getLength();
 
     // we know the string conforms to the rules for the string, so we just
-    // need to process all of the bits and convert
-    while (bits > 0)
+    // need to accumulate the bits, skipping any whitespace.  The first
+    // nibble gets any excess bits, the rest are complete groups of 4.
+    size_t nibbleBits = bits % 4 == 0 ? 4 : bits % 4;
+    int nibble = 0;
+    for (; bits > 0; source++)
     {
-        char nibble[4];
-        // this will really on impact the first nibble, since we will be working
-        // in groups of 4 after that.  Find out how many bit digits we need to
-        // process for the next nibble
-        size_t excess = bits % 4;
-        // zero means we have a full nibble to process
-        if (excess == 0)
-        {
-            excess = 4;
-        }
-        // fill the nibble with zero bits for the non-used ones
-        else
+        char ch = *source;
+        if (ch == '0' || ch == '1')
         {
-            memset(nibble, '0', 4);
+            nibble = (nibble << 1) | (ch - '0');
+            bits--;
+            // once we have a full nibble, insert into the destination as a hex character
+            if (--nibbleBits == 0)
+            {
+                *destination++ = intToHexDigit(nibble);
+                nibble = 0;
+                nibbleBits = 4;
+            }
         }
-        size_t jump;        // string movement offset
-        // get the next nibble worth of characters
-        StringUtil::chGetSm(&nibble[0] + (4 - excess), source, length, excess, "01", jump);
-        // insert into the destination as a hex character
-        *destination++ = StringUtil::packNibble(nibble);
-        source += jump;
-        length -= jump;
-        // we should be working with multiples of 4 after the first one.
-        bits -= excess;
     }
     return retval;
 }
@@ -675,7 +637,7 @@ RexxString *RexxString::x2b()
         return GlobalNames::NULLSTRING;
     }
     // validate the content and grouping of the string, returning the count of set characters
-    size_t nibbles = StringUtil::validateSet(getStringData(), getLength(), "0123456789ABCDEFabcdef", 2, true);
+    size_t nibbles = StringUtil::validateSet(getStringData(), getLength(), 2, true);
     // every hex nibble will expand to 4 bit characters
     RexxString *retval = raw_string(nibbles * 4);
 
@@ -689,9 +651,8 @@ RexxString *RexxString::x2b()
         char ch = *source++;
         if (ch != ch_SPACE && ch != ch_TAB)
         {
-            // convert to a decimal number first, then unpack that into the nibble
-            int val = StringUtil::hexDigitToInt(ch);
-            StringUtil::unpackNibble(val, destination);
+            // each digit value expands directly into 4 bit characters
+            memcpy(destination, NIBBLE_BITS[StringUtil::hexDigitValue(ch)], 4);
             destination += 4;
             nibbles--;
         }
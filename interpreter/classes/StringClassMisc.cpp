@@ -703,44 +703,13 @@ RexxString *RexxString::translate(RexxString *tableo, RexxString *tablei, RexxSt
     // get a new string using the original string data.  We'll make
     // changes in place in the new string
     RexxString *retval = new_string(getStringData(), getLength());
-    char *scanPtr = retval->getWritableData() + startPos - 1;
-    size_t scanLength = range;
 
-    // now scan the range section
-    while (scanLength--)
-    {
-        char ch = *scanPtr;
-
-        size_t position;
-        // if we have a real input table, then scan for the
-        // character.
-        if (tablei != GlobalNames::NULLSTRING)
-        {
-            // search for the character
-            position = StringUtil::memPos(inTable, inTableLength, ch);
-        }
-        // the position is the character itself
-        else
-        {
-            // no input table, so the position is the character itself
-            position = ((size_t)ch) & 0xff;
-        }
-
-        if (position != (size_t)(-1))
-        {
-            // if the output table is large enough, use the table value, otherwise
-            // use the pad character.
-            if (position < outTableLength)
-            {
-                *scanPtr = *(outTable + position);
-            }
-            else
-            {
-                *scanPtr = padChar;
-            }
-        }
-        scanPtr++;
-    }
+    // resolve the tables into a single mapping table so that each character
+    // is a simple lookup.  The null string default for the input table means
+    // the position is the character itself.
+    char mapping[256];
+    StringUtil::buildTranslateTable(mapping, outTable, outTableLength, inTable, inTableLength, tablei != GlobalNames::NULLSTRING, padChar);
+    StringUtil::translateCharacters(retval->getWritableData() + startPos - 1, range, mapping);
     return retval;
 }
 
@@ -488,6 +488,12 @@ RexxString *RexxString::right(RexxInteger *_length, RexxString  *pad)
         return this;
     }
 
+    // no padding needed, so this is just the tail of the string
+    if (size < sourceLength)
+    {
+        return extractTail(sourceLength - size);
+    }
+
     RexxString *retval = raw_string(size);
     StringBuilder builder(retval);
 
@@ -562,6 +568,11 @@ RexxString *RexxString::strip(RexxString *optionString, RexxString *stripchar)
     // if there is anything left, extract the remaining part
     if (length > 0)
     {
+        // nothing removed from the end means this is the tail of the string
+        if (front + length == getStringData() + getLength())
+        {
+            return extractTail(front - getStringData());
+        }
         return new_string(front, length);
     }
     else
@@ -584,7 +595,7 @@ RexxString *RexxString::strip(RexxString *optionString, RexxString *stripchar)
 RexxString *RexxString::substr(RexxInteger *position, RexxInteger *_length, RexxString  *pad)
 {
     // use the common code shared with MutableBuffer
-    return StringUtil::substr(getStringData(), getLength(), position, _length, pad);
+    return StringUtil::substr(getStringData(), getLength(), position, _length, pad, this);
 }
 
 
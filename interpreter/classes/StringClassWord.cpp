@@ -45,6 +45,7 @@
 #include "StringClass.hpp"
 #include "StringUtil.hpp"
 #include "MethodArguments.hpp"
+#include "BufferClass.hpp"
 
 
 /**
@@ -75,7 +76,7 @@ RexxString *RexxString::delWord(RexxInteger *position, RexxInteger *plength)
     }
 
     // create an iterator for traversing the words
-    WordIterator iterator(this);
+    WordIterator iterator(getStringData(), getLength(), wordOffsets());
 
     // to the given word position...if we don't get there,
     // there is nothing to delete so we can just return the
@@ -179,7 +180,7 @@ RexxString *RexxString::space(RexxInteger *space_count, RexxString *pad)
 /******************************************************************************/
 RexxString *RexxString::subWord(RexxInteger *position, RexxInteger *plength)
 {
-    return StringUtil::subWord(getStringData(), getLength(), position, plength);
+    return StringUtil::subWord(getStringData(), getLength(), position, plength, wordOffsets(), this);
 }
 
 
@@ -199,7 +200,7 @@ RexxString *RexxString::subWord(RexxInteger *position, RexxInteger *plength)
  */
 ArrayClass *RexxString::subWords(RexxInteger *position, RexxInteger *plength)
 {
-    return StringUtil::subWords(getStringData(), getLength(), position, plength);
+    return StringUtil::subWords(getStringData(), getLength(), position, plength, wordOffsets());
 }
 
 
@@ -213,7 +214,7 @@ ArrayClass *RexxString::subWords(RexxInteger *position, RexxInteger *plength)
  */
 RexxString *RexxString::word(RexxInteger *position)
 {
-    return StringUtil::word(getStringData(), getLength(), position);
+    return StringUtil::word(getStringData(), getLength(), position, wordOffsets());
 }
 
 
@@ -227,7 +228,7 @@ RexxString *RexxString::word(RexxInteger *position)
  */
 RexxInteger *RexxString::wordIndex(RexxInteger *position)
 {
-    return StringUtil::wordIndex(getStringData(), getLength(), position);
+    return StringUtil::wordIndex(getStringData(), getLength(), position, wordOffsets());
 }
 
 
@@ -241,7 +242,7 @@ RexxInteger *RexxString::wordIndex(RexxInteger *position)
  */
 RexxInteger *RexxString::wordLength(RexxInteger *position)
 {
-    return StringUtil::wordLength(getStringData(), getLength(), position);
+    return StringUtil::wordLength(getStringData(), getLength(), position, wordOffsets());
 }
 
 
@@ -255,7 +256,7 @@ RexxInteger *RexxString::wordLength(RexxInteger *position)
  */
 RexxInteger *RexxString::wordPos(RexxString  *phrase, RexxInteger *pstart)
 {
-    return new_integer(StringUtil::wordPos(getStringData(), getLength(), phrase, pstart));
+    return new_integer(StringUtil::wordPos(getStringData(), getLength(), phrase, pstart, wordOffsets()));
 }
 
 
@@ -269,7 +270,7 @@ RexxInteger *RexxString::wordPos(RexxString  *phrase, RexxInteger *pstart)
  */
 RexxObject *RexxString::containsWord(RexxString  *phrase, RexxInteger *pstart)
 {
-    return booleanObject(StringUtil::wordPos(getStringData(), getLength(), phrase, pstart) > 0);
+    return booleanObject(StringUtil::wordPos(getStringData(), getLength(), phrase, pstart, wordOffsets()) > 0);
 }
 
 
@@ -283,7 +284,7 @@ RexxObject *RexxString::containsWord(RexxString  *phrase, RexxInteger *pstart)
  */
 RexxInteger *RexxString::caselessWordPos(RexxString  *phrase, RexxInteger *pstart)
 {
-    return new_integer(StringUtil::caselessWordPos(getStringData(), getLength(), phrase, pstart));
+    return new_integer(StringUtil::caselessWordPos(getStringData(), getLength(), phrase, pstart, wordOffsets()));
 }
 
 
@@ -297,7 +298,7 @@ RexxInteger *RexxString::caselessWordPos(RexxString  *phrase, RexxInteger *pstar
  */
 RexxObject *RexxString::caselessContainsWord(RexxString  *phrase, RexxInteger *pstart)
 {
-    return booleanObject(StringUtil::caselessWordPos(getStringData(), getLength(), phrase, pstart)  > 0);
+    return booleanObject(StringUtil::caselessWordPos(getStringData(), getLength(), phrase, pstart, wordOffsets())  > 0);
 }
 
 
@@ -308,8 +309,46 @@ RexxObject *RexxString::caselessContainsWord(RexxString  *phrase, RexxInteger *p
  */
 RexxInteger *RexxString::words()
 {
-    size_t tempCount = StringUtil::wordCount(getStringData(), getLength());
+    const size_t *offsets = wordOffsets();
+    size_t tempCount = offsets != NULL ? offsets[0] : StringUtil::wordCount(getStringData(), getLength());
     return new_integer(tempCount);
 }
 
 
+/**
+ * Return the word index for this string, building it on first
+ * use.  The index is an array of offsets, with the count of
+ * words in the first slot followed by the offset of each word.
+ * Short strings are cheap to scan and don't get an index.
+ *
+ * @return A pointer to the index data, or NULL if this string
+ *         does not use an index.
+ */
+const size_t *RexxString::wordOffsets()
+{
+    if (wordTable == OREF_NULL)
+    {
+        if (getLength() < WORD_INDEX_THRESHOLD)
+        {
+            return NULL;
+        }
+
+        size_t count = StringUtil::wordCount(getStringData(), getLength());
+        BufferClass *index = new_buffer((count + 1) * sizeof(size_t));
+        size_t *offsets = (size_t *)index->getData();
+        offsets[0] = count;
+
+        WordIterator iterator(this);
+        for (size_t i = 1; iterator.next(); i++)
+        {
+            offsets[i] = iterator.wordPointer() - getStringData();
+        }
+
+        setField(wordTable, index);
+        // we now have a reference to mark
+        setHasReferences();
+    }
+    return (const size_t *)wordTable->getData();
+}
+
+
@@ -233,7 +233,7 @@ void CompoundVariableTail::buildTail(RexxInternalObject **tails, size_t count)
  */
 void CompoundVariableTail::buildTail(RexxString *_tail)
 {
-    tail = _tail->getWritableData();
+    tail = const_cast<char *>(_tail->getStringData());
     length = _tail->getLength();
     remainder = 0;
     value = _tail;
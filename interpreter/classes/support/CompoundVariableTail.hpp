@@ -180,7 +180,7 @@ class CompoundVariableTail
    inline void useStringValue(RexxString *rep)
    {
        // point directly to the value and the length
-       tail = rep->getWritableData();
+       tail = const_cast<char *>(rep->getStringData());
        length = rep->getLength();
        remainder = 0;                       // belt and braces...this will force a reallocation if we append
        value = rep;                         // save this reference in case we're asked for it later
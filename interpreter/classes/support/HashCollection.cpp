@@ -104,14 +104,9 @@ void HashCollection::expandContents(size_t capacity )
 {
     size_t bucketSize = calculateBucketSize(capacity);
     Protected<HashContents> newContents = allocateContents(bucketSize, bucketSize * 2);
-    // copy all of the items into the new table
-    contents->reMerge(newContents);
-    // if this is a contents item in the old space, we need to
-    // empty this so any old-to-new table entries in the contents can get updated.
-    if (contents->isOldSpace())
-    {
-        contents->empty();
-    }
+    // the new contents take over the old items, moving them over as
+    // new items get added.
+    newContents->migrateFrom(contents);
     // replace the contents
 
     setField(contents, (HashContents *)newContents);
@@ -691,7 +686,8 @@ ArrayClass *HashCollection::uniqueIndexes()
  */
 RexxObject *HashCollection::emptyRexx()
 {
-    contents->empty();
+    // use the virtual version so subclasses with additional state get cleared too
+    empty();
     return OREF_NULL;
 }
 
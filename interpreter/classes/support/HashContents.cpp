@@ -173,6 +173,7 @@ void HashContents::initializeFreeChain()
  */
 void HashContents::live(size_t liveMark)
 {
+    memory_mark(migrationSource);
     for (size_t i = 0; i < totalSize; i++)
     {
         memory_mark(entries[i].index);
@@ -188,6 +189,7 @@ void HashContents::live(size_t liveMark)
  */
 void HashContents::liveGeneral(MarkReason reason)
 {
+    memory_mark_general(migrationSource);
     for (size_t i = 0; i < totalSize; i++)
     {
         memory_mark_general(entries[i].index);
@@ -204,6 +206,7 @@ void HashContents::liveGeneral(MarkReason reason)
 void HashContents::flatten(Envelope *envelope)
 {
     setUpFlatten(HashContents)
+    flattenRef(migrationSource);
     for (size_t i = 0; i < totalSize; i++)
     {
         flattenRef(entries[i].index);
@@ -213,6 +216,80 @@ void HashContents::flatten(Envelope *envelope)
 }
 
 
+/**
+ * Check the links of a hash contents object from a flattened
+ * buffer.  Every chain must stay inside the entries and end
+ * before it could loop, and a pending migration source must be
+ * the same kind of contents.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if the links can be followed safely.
+ */
+bool HashContents::isValidFlattened(ValidatingMarkHandler &image)
+{
+    if (bucketSize == 0 || bucketSize > totalSize || itemCount > totalSize ||
+        !fitsInObject(entries, totalSize, sizeof(ContentEntry)))
+    {
+        return false;
+    }
+
+    for (ItemLink position = 0; position < totalSize; position++)
+    {
+        if (entries[position].next != NoMore && entries[position].next >= totalSize)
+        {
+            return false;
+        }
+    }
+
+    // all links are in range now, so just make sure none of the chains loop
+    for (ItemLink bucket = 0; bucket < bucketSize; bucket++)
+    {
+        size_t count = 0;
+        for (ItemLink position = bucket; position != NoMore && !isAvailable(position); position = entries[position].next)
+        {
+            if (++count > totalSize)
+            {
+                return false;
+            }
+        }
+    }
+    size_t count = 0;
+    for (ItemLink position = freeChain; position != NoMore; position = entries[position].next)
+    {
+        if (position >= totalSize || ++count > totalSize)
+        {
+            return false;
+        }
+    }
+
+    if (migrationSource != OREF_NULL)
+    {
+        if (image.typeOf(migrationSource) != image.typeOf(image.offsetOf(this)))
+        {
+            return false;
+        }
+        HashContents *source = (HashContents *)image.resolve(migrationSource);
+        return migrationBucket <= source->bucketSize;
+    }
+    return true;
+}
+
+
+/**
+ * Copy a contents object.  Any migration in progress is
+ * completed first, since the copy cannot share the source
+ * entries with us.
+ *
+ * @return A copy of the contents.
+ */
+RexxInternalObject *HashContents::copy()
+{
+    finishMigration();
+    return RexxInternalObject::copy();
+}
+
+
 /**
  * Put an item into the hashtable.  Default behavior is
  * to replace any existing items.
@@ -228,13 +305,16 @@ void HashContents::put(RexxInternalObject *value, RexxInternalObject *index)
     // NOTE:  This depends on the caller to make sure there is
     // room in the table for this item!
 
+    migrateForInsert(index);
+
     // calculate the bucket position
-    ItemLink position = hashIndex(index);
+    HashCode hash = indexHash(index);
+    ItemLink position = bucketPosition(hash);
 
     // if the hash slot is empty, we can just fill this in right here
     if (isAvailable(position))
     {
-        setEntry(position, value, index);
+        setEntry(position, value, index, hash);
         // new item, so bump the count
         itemCount++;
         return;
@@ -247,7 +327,7 @@ void HashContents::put(RexxInternalObject *value, RexxInternalObject *index)
     do
     {
         // if we got a hit, just change the slot position
-        if (isIndex(position, index))
+        if (isIndex(position, index, hash))
         {
             // everything worked, we have room.  No additional items added to
             // this table.
@@ -261,7 +341,7 @@ void HashContents::put(RexxInternalObject *value, RexxInternalObject *index)
     } while (position != NoMore);
 
     // append a new value.
-    append(value, index, previous);
+    append(value, index, hash, previous);
 }
 
 
@@ -270,9 +350,10 @@ void HashContents::put(RexxInternalObject *value, RexxInternalObject *index)
  *
  * @param value    The value to add.
  * @param index    The index value.
+ * @param hash     The hash code of the index.
  * @param position The position of the last link in the chain.
  */
-void HashContents::append(RexxInternalObject *value, RexxInternalObject * index, ItemLink position)
+void HashContents::append(RexxInternalObject *value, RexxInternalObject * index, HashCode hash, ItemLink position)
 {
     // we keep all of the free items in a chain, so we can just pull
     // the first entry off of the chain.  In theory, we've already checked
@@ -292,7 +373,7 @@ void HashContents::append(RexxInternalObject *value, RexxInternalObject * index,
     freeChain = entries[newEntry].next;
 
     // set the entry
-    setEntry(newEntry, value, index);
+    setEntry(newEntry, value, index, hash);
     // add this to the end of the chain
     setNext(position, newEntry);
     setNext(newEntry, NoMore);
@@ -308,9 +389,10 @@ void HashContents::append(RexxInternalObject *value, RexxInternalObject * index,
  *
  * @param value    The value to add.
  * @param index    The index value.
+ * @param hash     The hash code of the index.
  * @param position The position of the chain anchor.
  */
-void HashContents::insert(RexxInternalObject *value, RexxInternalObject * index, ItemLink position)
+void HashContents::insert(RexxInternalObject *value, RexxInternalObject * index, HashCode hash, ItemLink position)
 {
     // we keep all of the free items in a chain, so we can just pull
     // the first entry off of the chain.  In theory, we've already checked
@@ -331,7 +413,7 @@ void HashContents::insert(RexxInternalObject *value, RexxInternalObject * index,
     copyEntry(newEntry, position);
 
     // set the anchor item to the new values
-    setEntry(position, value, index);
+    setEntry(position, value, index, hash);
     // and chain the new entry off of this.
     setNext(position, newEntry);
 
@@ -419,8 +501,11 @@ void HashContents::removeChainLink(ItemLink &position, ItemLink previous)
  */
 bool HashContents::locateEntry(RexxInternalObject *index, ItemLink &position, ItemLink &previous)
 {
+    migrateIndex(index);
+
     // get the bucket position to start searching
-    position = hashIndex(index);
+    HashCode hash = indexHash(index);
+    position = bucketPosition(hash);
     previous = NoLink;
 
     // ok, run the chain searching for an index match.
@@ -428,7 +513,7 @@ bool HashContents::locateEntry(RexxInternalObject *index, ItemLink &position, It
     {
         // have a match? return to the caller.  All of the position
         // stuff should be set now
-        if (isIndex(position, index))
+        if (isIndex(position, index, hash))
         {
             return true;
         }
@@ -459,6 +544,9 @@ void HashContents::nextMatch(RexxInternalObject *index, ItemLink &position)
         return;
     }
 
+    // the current position is a match, so it has the index hash code
+    HashCode hash = entries[position].hash;
+
     // step to the next position
     position = nextEntry(position);
 
@@ -466,7 +554,7 @@ void HashContents::nextMatch(RexxInternalObject *index, ItemLink &position)
     while (position != NoMore)
     {
         // if this is a match, we're done
-        if (isIndex(position, index))
+        if (isIndex(position, index, hash))
         {
             return;
         }
@@ -663,8 +751,11 @@ void HashContents::locatePreviousEntry(ItemLink &position, ItemLink currentBucke
  */
 bool HashContents::locateEntry(RexxInternalObject *index, RexxInternalObject *item, ItemLink &position, ItemLink &previous)
 {
+    migrateIndex(index);
+
     // get the bucket position to start searching
-    position = hashIndex(index);
+    HashCode hash = indexHash(index);
+    position = bucketPosition(hash);
     previous = NoLink;
 
     // ok, run the chain searching for an index match.
@@ -672,7 +763,7 @@ bool HashContents::locateEntry(RexxInternalObject *index, RexxInternalObject *it
     {
         // have a match? return to the caller.  All of the position
         // stuff should be set now
-        if (isItem(position, index, item))
+        if (isItem(position, index, hash, item))
         {
             return true;
         }
@@ -704,6 +795,8 @@ bool HashContents::locateItem(RexxInternalObject *item, ItemLink &position, Item
     // since this does not scan any of the entries on the free chain, this method
     // could be faster than a brute force table search.
 
+    finishMigration();
+
     for (size_t i = 0; i < bucketSize; i++)
     {
         // the current bucket is the search start, and we always
@@ -887,6 +980,8 @@ RexxInternalObject *HashContents::removeItem(RexxInternalObject *item)
  */
 RexxInternalObject *HashContents::nextItem(RexxInternalObject *value, RexxInternalObject *index)
 {
+    migrateIndex(index);
+
     ItemLink position = hashIndex(index);
 
     // loop the chain until we
@@ -1027,15 +1122,18 @@ ArrayClass  *HashContents::getAll(RexxInternalObject *index)
  */
 size_t HashContents::countAllIndex(RexxInternalObject *index, ItemLink &anchorPosition)
 {
+    migrateIndex(index);
+
     size_t count = 0;
     // make sure we pass the anchor position back
-    anchorPosition = hashIndex(index);
+    HashCode hash = indexHash(index);
+    anchorPosition = bucketPosition(hash);
     ItemLink position = anchorPosition;
 
     while (position != NoMore && isInUse(position))
     {
         // compare the index values
-        if (isIndex(position, index))
+        if (isIndex(position, index, hash))
         {
             count++;
         }
@@ -1060,6 +1158,8 @@ size_t HashContents::countAllItem(RexxInternalObject *item)
     // since this does not scan any of the entries on the free chain, this method
     // could be faster than a brute force table search.
 
+    finishMigration();
+
     size_t count = 0;
 
     for (size_t i = 0; i < bucketSize; i++)
@@ -1170,6 +1270,7 @@ RexxInternalObject *HashContents::getIndex(RexxInternalObject *item)
  */
 void HashContents::merge(HashCollection *target)
 {
+    finishMigration();
 
     // since adding any item to the target collection might cause a size
     // expansion, let's give the target some notice about how many items
@@ -1204,6 +1305,7 @@ void HashContents::merge(HashCollection *target)
  */
 void HashContents::putAll(HashCollection *target)
 {
+    finishMigration();
 
     // since adding any item to the target collection might cause a size
     // expansion, let's give the target some notice about how many items
@@ -1230,47 +1332,90 @@ void HashContents::putAll(HashCollection *target)
 
 
 /**
- * Merge a hash table into another hash table after a table
- * expansion.
+ * Start moving the entries of a smaller contents object into
+ * this one after a table expansion.  For large tables, the
+ * entries are moved a few buckets at a time as new items get
+ * added, so a single expansion does not need to rehash the
+ * entire table.  Until the move completes, lookups check the
+ * source bucket for the index first.
+ *
+ * @param source The contents we're replacing.
+ */
+void HashContents::migrateFrom(HashContents *source)
+{
+    // the source might still be in the middle of its own migration.
+    source->finishMigration();
+
+    setField(migrationSource, source);
+    migrationBucket = 0;
+
+    // not worth spreading out the work for smaller tables.
+    if (source->items() < IncrementalMigrationThreshold)
+    {
+        finishMigration();
+    }
+}
+
+
+/**
+ * Move all entries of a single migration source bucket into
+ * this contents.
  *
- * @param newHash The target new table.
+ * @param bucket The source bucket position.
  */
-void HashContents::reMerge(HashContents *newHash)
+void HashContents::migrateBucket(ItemLink bucket)
 {
-    // one important aspect of a merge operation is keeping
-    // values with identical indexes in the same relative order
-    // after the merge (very important when merging MethodDirectories,
-    // for example.  We process the merge by running each bucket chain,
-    // and it is important that the target collection's mergeItem
-    // method adds this to the end of the chain rather than to the beginning.
+    HashContents *source = migrationSource;
 
-    // NOTE:  this merger is being doing under the assumption that the
-    // hew hash contents is larger than the current.
+    // nothing to do if this bucket has already been moved
+    if (source->isAvailable(bucket))
+    {
+        return;
+    }
 
-    // loop through all of the bucket items
-    for (size_t i = 0; i < bucketSize; i++)
+    // one important aspect of this is keeping values with identical
+    // indexes in the same relative order after the move (very important
+    // for MethodDictionaries, for example).  All entries for a given
+    // index are in the same source bucket, so we just run the chain and
+    // add each item to the end of the target chain.  The saved hash code
+    // saves us from needing to hash each index again.
+    ItemLink position = bucket;
+    do
     {
-        // the current bucket is the search start, and we always
-        // clear out the previous value for each chain start
-        ItemLink position = i;
+        ItemLink next = source->nextEntry(position);
+        addEntry(source->entryValue(position), source->entryIndex(position), source->entries[position].hash);
+        // the clear also takes care of any old-to-new references if the
+        // source is in the old space.
+        source->clearEntry(position);
+        source->itemCount--;
+        position = next;
+    } while (position != NoMore);
+}
 
-        // ok, run the chain searching for an index match.
-        while (position != NoMore && isInUse(position))
-        {
-            // poke this item into the other table.  We don't know
-            // the characteristics of the target, so we might have
-            // multiple hits on any given index.  We need to perform
-            // this merge A) without losing any items in the collection and
-            // B) keeping the relative order of duplicate indexes (very
-            // important for MethodDictionaries, for example, which are
-            // dependent on ordering of items in the table).  Therefore,
-            // we do the merge by running each bucket chain and
-            // using the add() method to add each additional item to the
-            // end of the chain.
-            newHash->add(entryValue(position), entryIndex(position));
-            // step to the next link in the chain
-            position = nextEntry(position);
-        }
+
+/**
+ * Move the next set of buckets from the migration source.
+ * Once the source has been completely emptied, the reference
+ * to it is released.
+ *
+ * @param count  The number of source buckets to move.
+ */
+void HashContents::migrateNext(size_t count)
+{
+    HashContents *source = migrationSource;
+    size_t sourceBuckets = source->hashBucket();
+
+    while (count > 0 && migrationBucket < sourceBuckets)
+    {
+        migrateBucket(migrationBucket++);
+        count--;
+    }
+
+    // all done?  We no longer need the source.
+    if (migrationBucket >= sourceBuckets)
+    {
+        setField(migrationSource, OREF_NULL);
+        migrationBucket = 0;
     }
 }
 
@@ -1304,13 +1449,16 @@ void HashContents::mergePut(RexxInternalObject *item, RexxInternalObject *index)
 {
     // NOTE:  This depends on the caller having checked that there is space.
 
+    migrateForInsert(index);
+
     // calculate the bucket position
-    ItemLink position = hashIndex(index);
+    HashCode hash = indexHash(index);
+    ItemLink position = bucketPosition(hash);
 
     // if the hash slot is empty, we can just fill this in right here
     if (isAvailable(position))
     {
-        setEntry(position, item, index);
+        setEntry(position, item, index, hash);
         // new item, so bump the count
         itemCount++;
         return;
@@ -1323,7 +1471,7 @@ void HashContents::mergePut(RexxInternalObject *item, RexxInternalObject *index)
     do
     {
         // if we got a hit, just change the slot position
-        if (isIndex(position, index))
+        if (isIndex(position, index, hash))
         {
             // nothing added, but this "worked"
             return;
@@ -1335,7 +1483,7 @@ void HashContents::mergePut(RexxInternalObject *item, RexxInternalObject *index)
     } while (position != NoMore);
 
     // This was not already in the table, so add a new value to the chain
-    append(item, index, previous);
+    append(item, index, hash, previous);
 }
 
 
@@ -1346,6 +1494,8 @@ void HashContents::mergePut(RexxInternalObject *item, RexxInternalObject *index)
  */
 ArrayClass  *HashContents::allItems()
 {
+    finishMigration();
+
     // get an array to hold the result
     ArrayClass *result = new_array(itemCount);
 
@@ -1387,6 +1537,14 @@ ArrayClass  *HashContents::allItems()
  */
 void HashContents::empty()
 {
+    // anything still waiting to be moved goes away too
+    if (migrationSource != OREF_NULL)
+    {
+        migrationSource->empty();
+        setField(migrationSource, OREF_NULL);
+        migrationBucket = 0;
+    }
+
     for (size_t i = 0; i < bucketSize; i++)
     {
         // if the first item of this bucket is in use
@@ -1416,6 +1574,8 @@ void HashContents::empty()
  */
 ArrayClass *HashContents::allIndexes()
 {
+    finishMigration();
+
     // get an array to hold the result
     ArrayClass *result = new_array(itemCount);
 
@@ -1463,6 +1623,7 @@ ArrayClass *HashContents::uniqueIndexes()
     // for tables with no duplicates, this is the same as allIndexes.
     // however, this method is only exposed for relations/bags, so we'll
     // leave the implementation in the base
+    finishMigration();
     Protected<TableClass> indexSet = new_table(items());
 
     for (size_t i = 0; i < bucketSize; i++)
@@ -1492,6 +1653,8 @@ ArrayClass *HashContents::uniqueIndexes()
  */
 SupplierClass *HashContents::supplier()
 {
+    finishMigration();
+
     // get out target count and get arrays for both the values and indexes
     size_t count = itemCount;
 
@@ -1572,6 +1735,8 @@ SupplierClass *HashContents::supplier(RexxInternalObject *index)
  */
 void HashContents::reHash(HashContents *newHash)
 {
+    finishMigration();
+
     for (size_t i = 0; i < bucketSize; i++)
     {
         // the current bucket is the search start, and we always
@@ -1607,13 +1772,28 @@ void HashContents::add(RexxInternalObject *item, RexxInternalObject *index)
 {
     // NOTE:  This depends on the caller having checked that there is space.
 
+    migrateForInsert(index);
+    addEntry(item, index, indexHash(index));
+}
+
+
+/**
+ * Add an entry to the end of the bucket chain for a
+ * previously calculated hash code.
+ *
+ * @param item   The value to add.
+ * @param index  The index this will be added under.
+ * @param hash   The hash code of the index.
+ */
+void HashContents::addEntry(RexxInternalObject *item, RexxInternalObject *index, HashCode hash)
+{
     // calculate the bucket position
-    ItemLink position = hashIndex(index);
+    ItemLink position = bucketPosition(hash);
 
     // if the hash slot is empty, we can just fill this in right here
     if (isAvailable(position))
     {
-        setEntry(position, item, index);
+        setEntry(position, item, index, hash);
         // new item, so bump the count
         itemCount++;
         return;
@@ -1630,7 +1810,7 @@ void HashContents::add(RexxInternalObject *item, RexxInternalObject *index)
     } while (position != NoMore);
 
     // append a new value.
-    append(item, index, previous);
+    append(item, index, hash, previous);
 }
 
 
@@ -1651,20 +1831,23 @@ void HashContents::addFront(RexxInternalObject *item, RexxInternalObject *index)
 {
     // NOTE:  This depends on the caller having checked that there is space.
 
+    migrateForInsert(index);
+
     // calculate the bucket position
-    ItemLink position = hashIndex(index);
+    HashCode hash = indexHash(index);
+    ItemLink position = bucketPosition(hash);
 
     // if the hash slot is empty, we can just fill this in right here
     if (isAvailable(position))
     {
-        setEntry(position, item, index);
+        setEntry(position, item, index, hash);
         // new item, so bump the count
         itemCount++;
         return;
     }
 
     // insert at the front of the bucket.
-    insert(item, index, position);
+    insert(item, index, hash, position);
 }
 
 
@@ -1673,6 +1856,8 @@ void HashContents::addFront(RexxInternalObject *item, RexxInternalObject *index)
  */
 void HashContents::copyValues()
 {
+    finishMigration();
+
     for (size_t i = 0; i < bucketSize; i++)
     {
         // the current bucket is the search start, and we always
@@ -1696,11 +1881,13 @@ void HashContents::copyValues()
  * @param position The table position.
  * @param value    The value to set.
  * @param index    The index to set.
+ * @param hash     The hash code of the index.
  */
-void HashContents::setEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index)
+void HashContents::setEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index, HashCode hash)
 {
     setField(entries[position].value, value);
     setField(entries[position].index, index);
+    entries[position].hash = hash;
 }
 
 
@@ -1760,6 +1947,9 @@ HashContents::IndexIterator HashContents::iterator(RexxInternalObject *index)
  */
 HashContents::TableIterator HashContents::iterator()
 {
+    // iteration needs all of the entries in one place
+    finishMigration();
+
     ItemLink position = NoMore;
     ItemLink nextBucket = 0;
 
@@ -1779,6 +1969,8 @@ HashContents::TableIterator HashContents::iterator()
  */
 HashContents::ReverseTableIterator HashContents::reverseIterator()
 {
+    finishMigration();
+
     ItemLink position = NoMore;
     ItemLink currentBucket = 0;
 
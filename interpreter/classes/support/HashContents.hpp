@@ -169,14 +169,22 @@ public:
         RexxInternalObject *index;           // item index object
         RexxInternalObject *value;           // item value object
         ItemLink next;                       // next item in overflow bucket
+        HashCode hash;                       // full hash code of the index
     };
 
+    // number of source buckets moved by each insertion during a migration
+    static const size_t MigrationBatch = 16;
+    // contents with fewer items than this are migrated in one step
+    static const size_t IncrementalMigrationThreshold = 1024;
+
     inline HashContents() { ; };
            HashContents(size_t entries, size_t total);
 
     virtual void live(size_t);
     virtual void liveGeneral(MarkReason reason);
     virtual void flatten(Envelope *);
+    virtual RexxInternalObject *copy();
+    virtual bool isValidFlattened(ValidatingMarkHandler &);
 
 
     // default index comparison method
@@ -194,15 +202,27 @@ public:
     }
 
     // default index hashing method.  bypass the hash() method and directly use the hash value
-    virtual ItemLink hashIndex(RexxInternalObject *index)
+    virtual HashCode indexHash(RexxInternalObject *index)
+    {
+        return index->getHashValue();
+    }
+
+    // map a full hash code to a bucket position
+    inline ItemLink bucketPosition(HashCode hash)
+    {
+        return (ItemLink)(hash % bucketSize);
+    }
+
+    // calculate the bucket position for an index
+    inline ItemLink hashIndex(RexxInternalObject *index)
     {
-        return (ItemLink)(index->getHashValue() % bucketSize);
+        return bucketPosition(indexHash(index));
     }
 
     void initializeFreeChain();
 
     // set the entry values for a position
-    void setEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index);
+    void setEntry(ItemLink position, RexxInternalObject *value, RexxInternalObject *index, HashCode hash);
 
     // clear and entry in the chain
     void clearEntry(ItemLink position);
@@ -214,7 +234,7 @@ public:
     inline void copyEntry(ItemLink target, ItemLink source)
     {
         // copy all of the information
-        setEntry(target, entryValue(source), entryIndex(source));
+        setEntry(target, entryValue(source), entryIndex(source), entries[source].hash);
         entries[target].next = entries[source].next;
     }
 
@@ -246,6 +266,13 @@ public:
         return isIndexEqual(index, entries[position].index);
     }
 
+    // perform an index comparison for a position, using the stored hash
+    // code to avoid the full comparison for most non-matching entries.
+    inline bool isIndex(ItemLink position, RexxInternalObject *index, HashCode hash)
+    {
+        return entries[position].hash == hash && isIndexEqual(index, entries[position].index);
+    }
+
     // perform an item comparison for a position
     inline bool isItem(ItemLink position, RexxInternalObject *item)
     {
@@ -253,9 +280,9 @@ public:
     }
 
     // perform an entry comparison for a position using both index and item value
-    inline bool isItem(ItemLink position, RexxInternalObject *index, RexxInternalObject *item)
+    inline bool isItem(ItemLink position, RexxInternalObject *index, HashCode hash, RexxInternalObject *item)
     {
-        return isIndexEqual(index, entries[position].index) && isItemEqual(item, entries[position].value);
+        return isIndex(position, index, hash) && isItemEqual(item, entries[position].value);
     }
 
     // check if an entry is availabe
@@ -297,7 +324,37 @@ public:
     // check if this table can hold an additional number of items (usually used on merge operations)
     inline bool hasCapacity(size_t count)
     {
-        return totalSize - itemCount > count;
+        return totalSize - items() > count;
+    }
+
+    // make sure any entries for an index have been moved out of
+    // a contents object we're still migrating from.
+    inline void migrateIndex(RexxInternalObject *index)
+    {
+        if (migrationSource != OREF_NULL)
+        {
+            migrateBucket(migrationSource->hashIndex(index));
+        }
+    }
+
+    // migrate the bucket for an index we're about to add, then move a few
+    // more buckets along.
+    inline void migrateForInsert(RexxInternalObject *index)
+    {
+        if (migrationSource != OREF_NULL)
+        {
+            migrateBucket(migrationSource->hashIndex(index));
+            migrateNext(MigrationBatch);
+        }
+    }
+
+    // move everything remaining in the migration source into this contents
+    inline void finishMigration()
+    {
+        if (migrationSource != OREF_NULL)
+        {
+            migrateNext(migrationSource->hashBucket());
+        }
     }
 
     // test if a position is a bucket anchor position.
@@ -328,10 +385,11 @@ public:
     // override put() and change the replace vs. add semantics.
     virtual void put(RexxInternalObject *value, RexxInternalObject *index);
 
-    inline size_t items() { return itemCount; }
-    inline bool isEmpty() { return itemCount == 0; }
-    void append(RexxInternalObject *value, RexxInternalObject * index, ItemLink position);
-    void insert(RexxInternalObject *value, RexxInternalObject * index, ItemLink position);
+    inline size_t items() { return migrationSource == OREF_NULL ? itemCount : itemCount + migrationSource->itemCount; }
+    inline bool isEmpty() { return items() == 0; }
+    void append(RexxInternalObject *value, RexxInternalObject * index, HashCode hash, ItemLink position);
+    void insert(RexxInternalObject *value, RexxInternalObject * index, HashCode hash, ItemLink position);
+    void addEntry(RexxInternalObject *value, RexxInternalObject * index, HashCode hash);
     RexxInternalObject *remove(RexxInternalObject *index);
     void removeChainLink(ItemLink &position, ItemLink previous);
     bool locateEntry(RexxInternalObject *index, ItemLink &position, ItemLink &previous);
@@ -358,7 +416,9 @@ public:
     RexxInternalObject *getIndex(RexxInternalObject *item);
     void merge(HashCollection *target);
     void putAll(HashCollection *target);
-    void reMerge(HashContents *newHash);
+    void migrateFrom(HashContents *source);
+    void migrateBucket(ItemLink bucket);
+    void migrateNext(size_t count);
     void mergeItem(RexxInternalObject *, RexxInternalObject *index);
     void mergePut(RexxInternalObject *item, RexxInternalObject *index);
     ArrayClass  *allItems();
@@ -383,6 +443,8 @@ protected:
     size_t   totalSize;                 // total size of the table, including the overflow area
     size_t   itemCount;                 // total number of items in the table
     ItemLink freeChain;                 // first free element
+    HashContents *migrationSource;      // smaller contents we're still moving entries out of
+    ItemLink migrationBucket;           // next source bucket to migrate
     ContentEntry entries[1];            // hash table entries
 };
 
@@ -433,9 +495,9 @@ public:
     }
 
     // Use the full hash() method processing to determine this.
-    virtual ItemLink hashIndex(RexxInternalObject *index)
+    virtual HashCode indexHash(RexxInternalObject *index)
     {
-        return (ItemLink)(index->hash() % bucketSize);
+        return index->hash();
     }
 };
 
@@ -486,9 +548,9 @@ public:
 
     // Take advantage of the knowledge that indexes are all strings and
     // do directly to the string hash method, which might be inlined.
-    virtual ItemLink hashIndex(RexxInternalObject *index)
+    virtual HashCode indexHash(RexxInternalObject *index)
     {
-        return (ItemLink)(((RexxString *)index)->getStringHash() % bucketSize);
+        return ((RexxString *)index)->getStringHash();
     }
 };
 
@@ -188,6 +188,16 @@ void ListContents::live(size_t liveMark)
  */
 void ListContents::liveGeneral(MarkReason reason)
 {
+    // the links of a flattened list have not been checked yet, so this
+    // scans the entire content area in order.  Unused entries are always cleared.
+    if (reason == VALIDATINGOBJECT)
+    {
+        for (size_t position = 0; position < totalSize; position++)
+        {
+            memory_mark_general(entries[position].value);
+        }
+        return;
+    }
     // we only mark the active items rather than scanning the entire content area.
     for (size_t position = firstItem; position != NoMore; position = nextEntry(position))
     {
@@ -205,16 +215,65 @@ void ListContents::flatten(Envelope *envelope)
 {
     setUpFlatten(ListContents)
 
-    // we only mark the active items rather than scanning the entire content area.
-    for (size_t position = firstItem; position != NoMore; position = nextEntry(position))
+    // we only flatten the active items rather than scanning the entire content area.
+    // NOTE:  the buffer can be reallocated by each flattenRef(), so the links need
+    // to be followed using the updated copy.
+    for (size_t position = newThis->firstItem; position != NoMore; position = newThis->nextEntry(position))
     {
-        memory_mark_general(entries[position].value);
+        flattenRef(entries[position].value);
     }
 
     cleanUpFlatten
 }
 
 
+/**
+ * Check the links of a list contents object from a flattened
+ * buffer.  The item chain must only reach entries that are in
+ * use and must end after itemCount items, the free chain can
+ * only reach entries that are not in use, and every other link
+ * must stay inside the entries.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if the links can be followed safely.
+ */
+bool ListContents::isValidFlattened(ValidatingMarkHandler &image)
+{
+    if (itemCount > totalSize || !fitsInObject(entries, totalSize, sizeof(ListEntry)))
+    {
+        return false;
+    }
+
+    size_t count = 0;
+    for (ItemLink position = firstItem; position != NoMore; position = entries[position].next)
+    {
+        if (position >= totalSize || count == itemCount || entries[position].isAvailable() ||
+            (entries[position].previous != NoMore && entries[position].previous >= totalSize))
+        {
+            return false;
+        }
+        count++;
+    }
+    if (count != itemCount || (lastItem != NoMore && lastItem >= totalSize))
+    {
+        return false;
+    }
+
+    // the free chain can't be longer than the unused entries
+    count = 0;
+    for (ItemLink position = freeChain; position != NoMore; position = entries[position].next)
+    {
+        if (position >= totalSize || count == totalSize - itemCount || entries[position].isInUse())
+        {
+            return false;
+        }
+        count++;
+    }
+    return true;
+}
+
+
 /**
  * Merge the list maintained in this contents object into
  * a target one after an expansion has occurred.  Note that this
@@ -81,6 +81,7 @@ class ListContents : public RexxInternalObject
     virtual void live(size_t);
     virtual void liveGeneral(MarkReason reason);
     virtual void flatten(Envelope *);
+    virtual bool isValidFlattened(ValidatingMarkHandler &);
 
     void initializeFreeChain();
     void prepareForMerge();
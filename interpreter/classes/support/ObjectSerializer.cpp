@@ -0,0 +1,282 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 1995, 2004 IBM Corporation. All rights reserved.             */
+/* Copyright (c) 2005-2026 Rexx Language Association. All rights reserved.    */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* http://www.oorexx.org/license.html                                         */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/******************************************************************************/
+/* REXX Kernel                                                                */
+/*                                                                            */
+/* Native object graph serialization                                          */
+/*                                                                            */
+/******************************************************************************/
+
+#include "RexxCore.h"
+#include "ObjectSerializer.hpp"
+#include "BufferClass.hpp"
+#include "PackageClass.hpp"
+#include "Interpreter.hpp"
+#include "ActivityManager.hpp"
+#include "ProtectedObject.hpp"
+
+#include <stdio.h>
+
+
+const char *serializedHeader = "/**/@RO";
+
+
+/**
+ * Initialize a header for a serialized image.
+ *
+ * @param size   The size of the flattened image data.
+ */
+ObjectSerializer::ObjectSerializer(size_t size)
+{
+    // the tag fills the field, including the terminator
+    memcpy(fileTag, serializedHeader, sizeof(fileTag));
+    magicNumber = MAGICNUMBER;
+    formatVersion = FORMATVERSION;
+    wordSize = Interpreter::getWordSize();
+    bigEndian = Interpreter::isBigEndian();
+    // the flattened form follows the internal object layouts, so this
+    // is only usable by the same interpreter version
+    interpreterVersion = REXX_CURRENT_INTERPRETER_VERSION;
+    reserved = 0;
+    imageSize = size;
+}
+
+
+/**
+ * Validate that a serialized image can be restored by this
+ * interpreter.
+ *
+ * @return true if this is good data, false otherwise.
+ */
+bool ObjectSerializer::validate()
+{
+    return memcmp(fileTag, serializedHeader, sizeof(fileTag)) == 0 && magicNumber == MAGICNUMBER &&
+        formatVersion == FORMATVERSION && wordSize == Interpreter::getWordSize() &&
+        (bigEndian != 0) == Interpreter::isBigEndian() && interpreterVersion == REXX_CURRENT_INTERPRETER_VERSION &&
+        imageSize <= Memory::MaximumObjectSize - MemoryObject::ValidationPadding - sizeof(BufferClass);
+}
+
+
+/**
+ * Flatten an object graph into an image buffer.
+ *
+ * @param object The root of the object graph.
+ *
+ * @return The flattened image (without a header).
+ */
+BufferClass *ObjectSerializer::pack(RexxInternalObject *object)
+{
+    Protected<Envelope> envelope = new Envelope;
+    return envelope->serialize(object);
+}
+
+
+/**
+ * Restore an object graph from a flattened image buffer.
+ *
+ * @param image   The buffer holding the image data, followed by the
+ *                padding needed for validating the data.
+ * @param package The package used to resolve class references.
+ *
+ * @return The root of the restored graph.
+ */
+RexxObject *ObjectSerializer::unpack(BufferClass *image, PackageClass *package)
+{
+    // the header only tells us who wrote the data.  The objects are
+    // unflattened in place, so their structure must be checked first.
+    if (!memoryObject.validateObjectBuffer(image->getData(), image->getDataLength()))
+    {
+        reportException(Error_Execution_user_defined, "Serialized object data is damaged");
+    }
+
+    Protected<Envelope> envelope = new Envelope;
+    envelope->deserialize(image, image->getData(), image->getDataLength(), package);
+    return (RexxObject *)envelope->getReceiver();
+}
+
+
+/**
+ * Allocate the buffer an image gets restored into.
+ *
+ * @param size   The size of the flattened image (already checked by
+ *               validate()).
+ *
+ * @return A buffer with the data length set to the image size.
+ */
+BufferClass *ObjectSerializer::newImageBuffer(uint64_t size)
+{
+    // the image gets validated before the unflatten, which needs some
+    // working space after the data.
+    BufferClass *image = new_buffer((size_t)size + MemoryObject::ValidationPadding);
+    image->setDataLength((size_t)size);
+    return image;
+}
+
+
+/**
+ * Serialize an object graph into a buffer, including the
+ * format header.
+ *
+ * @param object The root object of the graph.
+ *
+ * @return A buffer containing the header and the flattened graph.
+ */
+BufferClass *ObjectSerializer::serialize(RexxInternalObject *object)
+{
+    Protected<BufferClass> image = pack(object);
+    ObjectSerializer header(image->getDataLength());
+
+    BufferClass *result = new_buffer(header.getHeaderSize() + image->getDataLength());
+    memcpy(result->getData(), &header, header.getHeaderSize());
+    memcpy(result->getData() + header.getHeaderSize(), image->getData(), image->getDataLength());
+    return result;
+}
+
+
+/**
+ * Restore an object graph from serialized data.
+ *
+ * @param data    The serialized data, including the header.
+ * @param length  The length of the data.
+ * @param package The package used to resolve class references.
+ *
+ * @return The root of the restored graph.
+ */
+RexxObject *ObjectSerializer::deserialize(const char *data, size_t length, PackageClass *package)
+{
+    ObjectSerializer header;
+
+    // copy the header out so we don't depend on the alignment of the source data
+    if (length < header.getHeaderSize())
+    {
+        reportException(Error_Execution_user_defined, "Data is not a serialized object");
+    }
+    memcpy(&header, data, header.getHeaderSize());
+    if (!header.validate() || header.imageSize > length - header.getHeaderSize())
+    {
+        reportException(Error_Execution_user_defined, "Data is not a serialized object or was created by a different interpreter version");
+    }
+
+    // the image is restored in place, so it needs its own buffer
+    Protected<BufferClass> image = newImageBuffer(header.imageSize);
+    memcpy(image->getData(), data + header.getHeaderSize(), (size_t)header.imageSize);
+    return unpack(image, package);
+}
+
+
+/**
+ * Serialize an object graph directly to a file.
+ *
+ * @param object   The root of the object graph.
+ * @param fileName The name of the target file.
+ */
+void ObjectSerializer::save(RexxInternalObject *object, RexxString *fileName)
+{
+    Protected<BufferClass> image = pack(object);
+    ObjectSerializer header(image->getDataLength());
+
+    bool written = false;
+    {
+        UnsafeBlock releaser;
+
+        FILE *handle = fopen(fileName->getStringData(), "wb");
+        if (handle != NULL)
+        {
+            written = fwrite(&header, 1, header.getHeaderSize(), handle) == header.getHeaderSize() &&
+                fwrite(image->getData(), 1, image->getDataLength(), handle) == image->getDataLength();
+            written = (fclose(handle) == 0) && written;
+        }
+    }
+
+    if (!written)
+    {
+        reportException(Error_Program_unreadable_output_error, fileName);
+    }
+}
+
+
+/**
+ * Restore an object graph from a file written by save().
+ *
+ * @param fileName The name of the source file.
+ * @param package  The package used to resolve class references.
+ *
+ * @return The root of the restored graph.
+ */
+RexxObject *ObjectSerializer::restore(RexxString *fileName, PackageClass *package)
+{
+    ObjectSerializer header;
+    FILE *handle;
+    bool valid = false;
+
+    {
+        UnsafeBlock releaser;
+
+        handle = fopen(fileName->getStringData(), "rb");
+        if (handle != NULL)
+        {
+            valid = fread(&header, 1, header.getHeaderSize(), handle) == header.getHeaderSize() && header.validate();
+        }
+    }
+
+    if (handle == NULL)
+    {
+        reportException(Error_Program_unreadable_name, fileName);
+    }
+    if (!valid)
+    {
+        fclose(handle);
+        reportException(Error_Execution_user_defined, "File does not contain a serialized object or was created by a different interpreter version");
+    }
+
+    BufferClass *image = newImageBuffer(header.imageSize);
+    ProtectedObject p(image);
+
+    size_t bytesRead;
+    {
+        UnsafeBlock releaser;
+
+        bytesRead = fread(image->getData(), 1, (size_t)header.imageSize, handle);
+        fclose(handle);
+    }
+
+    if (bytesRead != header.imageSize)
+    {
+        reportException(Error_Program_unreadable_name, fileName);
+    }
+    return unpack(image, package);
+}
@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 1995, 2004 IBM Corporation. All rights reserved.             */
+/* Copyright (c) 2005-2026 Rexx Language Association. All rights reserved.    */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* http://www.oorexx.org/license.html                                         */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+#ifndef ObjectSerializer_Included
+#define ObjectSerializer_Included
+
+class BufferClass;
+class PackageClass;
+
+/**
+ * Native serialization of arbitrary object graphs.  The graph
+ * is flattened with an Envelope and written out behind a
+ * small header that identifies the data format and the
+ * interpreter that created it.  The object structure of
+ * restored data is checked before it gets unflattened, but the
+ * code of restored routines and methods runs as it was
+ * written, so only restore those from trusted sources.
+ */
+class ObjectSerializer
+{
+public:
+    ObjectSerializer(size_t);
+    ObjectSerializer() { }
+
+    static BufferClass *serialize(RexxInternalObject *);
+    static RexxObject  *deserialize(const char *, size_t, PackageClass *);
+    static void         save(RexxInternalObject *, RexxString *);
+    static RexxObject  *restore(RexxString *, PackageClass *);
+
+protected:
+    static BufferClass *pack(RexxInternalObject *);
+    static RexxObject  *unpack(BufferClass *, PackageClass *);
+    static BufferClass *newImageBuffer(uint64_t);
+
+    size_t getHeaderSize() { return sizeof(*this); }
+    bool validate();
+
+    enum
+    {
+        MAGICNUMBER = 0x524F,          // remains constant from release-to-release
+        FORMATVERSION = 1              // gets updated when the serialized form changes
+    };
+
+    char           fileTag[8];         // special header for file tagging
+    unsigned short magicNumber;        // special tag to indicate good data
+    unsigned short formatVersion;      // version of the serialized form
+    unsigned short wordSize;           // size of a word
+    unsigned short bigEndian;          // true if this is a big-endian platform
+    uint32_t       interpreterVersion; // the interpreter that created the data
+    uint32_t       reserved;           // keeps the header a multiple of 8 bytes
+    uint64_t       imageSize;          // size of the flattened image
+};
+
+#endif
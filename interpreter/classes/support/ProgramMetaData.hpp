@@ -65,7 +65,7 @@ protected:
     enum
     {
         MAGICNUMBER = 11111,           // remains constant from release-to-release
-        METAVERSION = 41               // gets updated when internal form changes
+        METAVERSION = 44               // gets updated when internal form changes
     };
 
 
@@ -60,11 +60,13 @@
  * @param _position The position argument for the starting position.
  * @param _length   The substring length argument.
  * @param pad       The padding argument.
+ * @param source    The string object holding the data, if any.  A
+ *                  substring running to the end of it can share its data.
  *
  * @return The extracted substring.
  */
 RexxString *StringUtil::substr(const char *string, size_t stringLength, RexxInteger *_position,
-    RexxInteger *_length, RexxString  *pad)
+    RexxInteger *_length, RexxString  *pad, RexxString *source)
 {
     size_t position = positionArgument(_position, ARG_ONE) - 1;
     // assume nothing is pulled from this string
@@ -101,6 +103,13 @@ RexxString *StringUtil::substr(const char *string, size_t stringLength, RexxInte
         substrLength = Numerics::minVal(length, stringLength - position);
         padCount = length - substrLength;
     }
+
+    // the rest of a string object can be shared rather than copied
+    if (source != OREF_NULL && padCount == 0 && position + substrLength == stringLength)
+    {
+        return source->extractTail(position);
+    }
+
     RexxString *retval = raw_string(length);
     RexxString::StringBuilder builder(retval);
 
@@ -669,17 +678,8 @@ int  StringUtil::caselessCompare(const char *string1, const char *string2, size_
  */
 int StringUtil::hexDigitToInt(char  ch)
 {
-    // for digits, just subtract the character zero
-    if (isdigit(ch))
-    {
-        return ch - '0';
-    }
-    // for the alpha digits, subtract A to get the relative value, then
-    // add 10 to that result
-    else
-    {
-        return toupper(ch) - 'A' + 10;
-    }
+    // this is only used with validated digits, so a straight lookup is fine
+    return hexDigitValue(ch);
 }
 
 
@@ -769,14 +769,13 @@ char StringUtil::packByte2(const char *bytes)
  *
  * @param String  The string to validate.
  * @param Length  The string length.
- * @param Set     The valid characters in the set.
  * @param Modulus The size of the smallest allowed grouping.
- * @param Hex     Indicates this is a hex or binary string.  Used for issuing
- *                the correct error type.
+ * @param Hex     Indicates this is a hex string rather than a binary string.
+ *                This selects both the valid digits and the error type.
  *
  * @return The number of valid digits found.
  */
-size_t StringUtil::validateSet(const char *string, size_t length, const char *set, int modulus, bool hex)
+size_t StringUtil::validateSet(const char *string, size_t length, int modulus, bool hex)
 {
     // leading whitespace not permitted
     if (*string == RexxString::ch_SPACE || *string == RexxString::ch_TAB)
@@ -797,7 +796,7 @@ size_t StringUtil::validateSet(const char *string, size_t length, const char *se
         ch = *current++;
 
         // if this is in the set, then add in the count of digits
-        if (ch != '\0' && strchr(set, ch) != NULL)
+        if (hex ? hexDigitValue(ch) >= 0 : (ch == '0' || ch == '1'))
         {
             count++;
         }
@@ -908,34 +907,55 @@ RexxString *StringUtil::packHex(const char *string, size_t stringLength)
         return GlobalNames::NULLSTRING;
     }
 
-    const char *source = string;
-    // perform the validation and get a character cound
-    size_t nibbles = validateSet(source, stringLength, "0123456789ABCDEFabcdef", 2, true);
+    // perform the validation and get a character count
+    size_t nibbles = validateSet(string, stringLength, 2, true);
     // get a result string, with rounding in case we have an odd number of digits
     RexxString *retval = raw_string((nibbles + 1) / 2);
 
     char *destination = retval->getWritableData();
 
-    // process all of the nibbles
-    while (nibbles > 0)
+    // without any blanks, the digits can be converted a pair at a time
+    if (nibbles == stringLength)
     {
-        char     buf[8];
-        // we do this two characters at a time, but the first group might
-        // only be one digit if we have an odd number
-        size_t b = nibbles % 2 == 0 ? 2 : 1;
-        // if we have an odd number, pad the buffer with zeros
-        if (b == 1)
+        const char *source = string;
+        // an odd number of digits means the first byte only gets a single digit
+        if (nibbles % 2 != 0)
+        {
+            *destination++ = (char)hexDigitValue(*source++);
+            nibbles--;
+        }
+        for (; nibbles > 0; nibbles -= 2)
         {
-            memset(buf, '0', 2);
+            *destination++ = (char)((hexDigitValue(source[0]) << 4) | hexDigitValue(source[1]));
+            source += 2;
+        }
+        return retval;
+    }
+
+    // the string is known to contain only digits and whitespace, so we just
+    // skip the whitespace and pack the digits.  If we have an odd number of digits,
+    // the first digit fills in the low nibble of the first byte.
+    bool highNibble = nibbles % 2 == 0;
+    if (!highNibble)
+    {
+        *destination = '\0';
+    }
+    for (const char *source = string; nibbles > 0; source++)
+    {
+        int value = hexDigitValue(*source);
+        if (value >= 0)
+        {
+            if (highNibble)
+            {
+                *destination = (char)(value << 4);
+            }
+            else
+            {
+                *destination++ |= (char)value;
+            }
+            highNibble = !highNibble;
+            nibbles--;
         }
-        size_t scanned;
-        // copy the digits into out buffer...we're copying either 1 or 2 characters
-        chGetSm(buf + 2 - b, source, stringLength, b, "0123456789ABCDEFabcdef", scanned);
-        // now convert this into a single character and insert into the destination string
-        *destination++ = packByte2(buf);
-        source += scanned;
-        stringLength -= scanned;
-        nibbles -= b;
     }
     return retval;
 }
@@ -1351,10 +1371,12 @@ RexxInteger *StringUtil::verify(const char *data, size_t stringLen, RexxString
  * @param length   The length of the buffer
  * @param position The starting word position.
  * @param plength  the count of words to return.
+ * @param offsets  An optional word index for the data.
+ * @param source   The string object holding the data, if any.
  *
  * @return The string containing the indicated subwords.
  */
-RexxString *StringUtil::subWord(const char *data, size_t length, RexxInteger *position, RexxInteger *plength)
+RexxString *StringUtil::subWord(const char *data, size_t length, RexxInteger *position, RexxInteger *plength, const size_t *offsets, RexxString *source)
 {
     size_t wordPos = positionArgument(position, ARG_ONE);
     // get num of words to extract.  The default is a "very large number
@@ -1367,7 +1389,7 @@ RexxString *StringUtil::subWord(const char *data, size_t length, RexxInteger *po
     }
 
     // get an iterator
-    RexxString::WordIterator iterator(data, length);
+    RexxString::WordIterator iterator(data, length, offsets);
 
     // try to skip ahead to the target word...if we don't have that many words,
     // return a null string
@@ -1384,6 +1406,12 @@ RexxString *StringUtil::subWord(const char *data, size_t length, RexxInteger *po
 
     const char *wordEnd = iterator.wordEndPointer();
 
+    // the trailing words of a string object can share its data
+    if (source != OREF_NULL && wordEnd == data + length)
+    {
+        return source->extractTail(wordStart - data);
+    }
+
     // get the substring
     return new_string(wordStart, wordEnd - wordStart);
 }
@@ -1396,10 +1424,11 @@ RexxString *StringUtil::subWord(const char *data, size_t length, RexxInteger *po
  * @param length   The length of the buffer
  * @param position The starting word position.
  * @param plength  the count of words to return.
+ * @param offsets  An optional word index for the data.
  *
  * @return The array containing the indicated subwords.
  */
-ArrayClass *StringUtil::subWords(const char *data, size_t length, RexxInteger *position, RexxInteger *plength)
+ArrayClass *StringUtil::subWords(const char *data, size_t length, RexxInteger *position, RexxInteger *plength, const size_t *offsets)
 {
     size_t wordPos = optionalPositionArgument(position, 1, ARG_ONE);
     // get num of words to extract.  The default is a "very large number
@@ -1412,7 +1441,7 @@ ArrayClass *StringUtil::subWords(const char *data, size_t length, RexxInteger *p
     }
 
     // get an iterator
-    RexxString::WordIterator iterator(data, length);
+    RexxString::WordIterator iterator(data, length, offsets);
     // try to skip ahead to the target word...if we don't have that many words,
     // return an empty array
     if (!iterator.skipWords(wordPos))
@@ -1443,10 +1472,11 @@ ArrayClass *StringUtil::subWords(const char *data, size_t length, RexxInteger *p
  * @param data     The data pointer
  * @param length   the length of the data buffer.
  * @param position the target word position.
+ * @param offsets  An optional word index for the data.
  *
  * @return The string value of the word at the indicated position.
  */
-RexxString *StringUtil::word(const char *data, size_t length, RexxInteger *position)
+RexxString *StringUtil::word(const char *data, size_t length, RexxInteger *position, const size_t *offsets)
 {
     size_t wordPos = positionArgument(position, ARG_ONE);
 
@@ -1456,7 +1486,7 @@ RexxString *StringUtil::word(const char *data, size_t length, RexxInteger *posit
     }
 
     // get an iterator
-    RexxString::WordIterator iterator(data, length);
+    RexxString::WordIterator iterator(data, length, offsets);
     // try to skip ahead to the target word...if we don't have that many words,
     // return a null string
     if (!iterator.skipWords(wordPos))
@@ -1500,15 +1530,16 @@ ArrayClass *StringUtil::words(const char *data, size_t length)
  * @param data     The data containing the words
  * @param length   The length of the data buffer
  * @param position The target word position
+ * @param offsets  An optional word index for the data.
  *
  * @return The offset of the start of the indicated word.
  */
-RexxInteger *StringUtil::wordIndex(const char *data, size_t length, RexxInteger *position)
+RexxInteger *StringUtil::wordIndex(const char *data, size_t length, RexxInteger *position, const size_t *offsets)
 {
     size_t wordPos = positionArgument(position, ARG_ONE);
 
     // get an iterator
-    RexxString::WordIterator iterator(data, length);
+    RexxString::WordIterator iterator(data, length, offsets);
     // try to skip ahead to the target word...if we don't have that many words,
     // return zero
     if (!iterator.skipWords(wordPos))
@@ -1527,16 +1558,17 @@ RexxInteger *StringUtil::wordIndex(const char *data, size_t length, RexxInteger
  * @param data     The data containing the word list.
  * @param length   The length of the data buffer
  * @param position The target word position.
+ * @param offsets  An optional word index for the data.
  *
  * @return The length of the given word at the target index.  Returns
  *         0 if no word is found.
  */
-RexxInteger *StringUtil::wordLength(const char *data, size_t length, RexxInteger *position)
+RexxInteger *StringUtil::wordLength(const char *data, size_t length, RexxInteger *position, const size_t *offsets)
 {
     size_t wordPos = positionArgument(position , ARG_ONE);
 
     // get an iterator
-    RexxString::WordIterator iterator(data, length);
+    RexxString::WordIterator iterator(data, length, offsets);
     // try to skip ahead to the target word...if we don't have that many words,
     // return zero
     if (!iterator.skipWords(wordPos))
@@ -1556,10 +1588,11 @@ RexxInteger *StringUtil::wordLength(const char *data, size_t length, RexxInteger
  * @param length the length of the buffer
  * @param phrase the search phrase.
  * @param pstart the starting position.
+ * @param offsets an optional word index for the data.
  *
  * @return the location of the start of the search phrase.
  */
-size_t StringUtil::wordPos(const char *data, size_t length, RexxString  *phrase, RexxInteger *pstart)
+size_t StringUtil::wordPos(const char *data, size_t length, RexxString  *phrase, RexxInteger *pstart, const size_t *offsets)
 {
     phrase = stringArgument(phrase, ARG_ONE);
     size_t needleLength = phrase->getLength();
@@ -1572,7 +1605,7 @@ size_t StringUtil::wordPos(const char *data, size_t length, RexxString  *phrase,
     // cound the words in both the needle and the haystack
     size_t needleWords = wordCount(needle, needleLength);
 
-    size_t haystackWords = wordCount(haystack, haystackLength);
+    size_t haystackWords = offsets != NULL ? offsets[0] : wordCount(haystack, haystackLength);
 
     // if search phrase is longer or no words in search
     // or count is longer, then this is a failure
@@ -1584,7 +1617,7 @@ size_t StringUtil::wordPos(const char *data, size_t length, RexxString  *phrase,
     // we know how many potential search attempts we can make.
     size_t searchCount = (haystackWords - needleWords - count) + 2;
 
-    RexxString::WordIterator haystackIterator(haystack, haystackLength);
+    RexxString::WordIterator haystackIterator(haystack, haystackLength, offsets);
 
     // skip the haystack ahead to the target word.  We know we have at least
     // count words already
@@ -1642,10 +1675,11 @@ size_t StringUtil::wordPos(const char *data, size_t length, RexxString  *phrase,
  * @param length the length of the buffer
  * @param phrase the search phrase.
  * @param pstart the starting position.
+ * @param offsets an optional word index for the data.
  *
  * @return the location of the start of the search phrase.
  */
-size_t StringUtil::caselessWordPos(const char *data, size_t length, RexxString  *phrase, RexxInteger *pstart)
+size_t StringUtil::caselessWordPos(const char *data, size_t length, RexxString  *phrase, RexxInteger *pstart, const size_t *offsets)
 {
     phrase = stringArgument(phrase, ARG_ONE);
     size_t needleLength = phrase->getLength();
@@ -1658,7 +1692,7 @@ size_t StringUtil::caselessWordPos(const char *data, size_t length, RexxString
     // cound the words in both the needle and the haystack
     size_t needleWords = wordCount(needle, needleLength);
 
-    size_t haystackWords = wordCount(haystack, haystackLength);
+    size_t haystackWords = offsets != NULL ? offsets[0] : wordCount(haystack, haystackLength);
 
     // if search phrase is longer or no words in search
     // or count is longer, then this is a failure
@@ -1670,7 +1704,7 @@ size_t StringUtil::caselessWordPos(const char *data, size_t length, RexxString
     // we know how many potential search attempts we can make.
     size_t searchCount = (haystackWords - needleWords - count) + 2;
 
-    RexxString::WordIterator haystackIterator(haystack, haystackLength);
+    RexxString::WordIterator haystackIterator(haystack, haystackLength, offsets);
 
     // skip the haystack ahead to the target word.  We know we have at least
     // count words already
@@ -1719,3 +1753,443 @@ size_t StringUtil::caselessWordPos(const char *data, size_t length, RexxString
     }
     return 0;                          // not found
 }
+
+
+// character lookup tables used by the conversion kernels below
+signed char StringUtil::hexDigitValues[256];
+signed char StringUtil::base64DigitValues[256];
+char StringUtil::hexDigitPairs[256][2];
+
+
+/**
+ * Fills in the StringUtil lookup tables.  A single static
+ * instance of this builds the tables when the interpreter is
+ * loaded.
+ */
+class ConversionTableBuilder
+{
+ public:
+    ConversionTableBuilder()
+    {
+        const char *hexDigits = "0123456789ABCDEF";
+
+        for (int i = 0; i < 256; i++)
+        {
+            StringUtil::hexDigitValues[i] = -1;
+            StringUtil::base64DigitValues[i] = -1;
+            StringUtil::hexDigitPairs[i][0] = hexDigits[i >> 4];
+            StringUtil::hexDigitPairs[i][1] = hexDigits[i & 0xf];
+        }
+
+        // hex digits are accepted in either case
+        for (int i = 0; i < 16; i++)
+        {
+            StringUtil::hexDigitValues[(unsigned char)hexDigits[i]] = (signed char)i;
+            StringUtil::hexDigitValues[tolower(hexDigits[i])] = (signed char)i;
+        }
+
+        for (int i = 0; i < 64; i++)
+        {
+            StringUtil::base64DigitValues[(unsigned char)RexxString::DIGITS_BASE64[i]] = (signed char)i;
+        }
+    }
+};
+
+static ConversionTableBuilder conversionTableBuilder;
+
+
+// the bulk kernels process the data eight characters at a time
+const uint64_t LOW_BYTES = 0x0101010101010101ULL;
+const uint64_t HIGH_BITS = 0x8080808080808080ULL;
+
+
+/**
+ * Locate the characters of a word that fall within a range.  All of the
+ * characters in the word must be 7-bit values.
+ *
+ * @param word   The eight characters to test.
+ * @param low    The low end of the range.
+ * @param high   The high end of the range.
+ *
+ * @return A word with the high bit set for each character in the range.
+ */
+static inline uint64_t characterRangeMask(uint64_t word, unsigned char low, unsigned char high)
+{
+    // adding these biases to a 7-bit character sets its high bit
+    // if the character is >= low or > high, respectively.
+    uint64_t aboveLow = word + (0x80 - low) * LOW_BYTES;
+    uint64_t aboveHigh = word + (0x80 - high - 1) * LOW_BYTES;
+    return aboveLow & ~aboveHigh & HIGH_BITS;
+}
+
+
+/**
+ * Expand a character buffer into its hex representation (the C2X
+ * operation).
+ *
+ * @param source      The source characters.
+ * @param length      The number of source characters.
+ * @param destination The output location (2 * length characters).
+ */
+void StringUtil::encodeHex(const char *source, size_t length, char *destination)
+{
+    for (; length > 0; length--)
+    {
+        memcpy(destination, hexDigitPairs[(unsigned char)*source++], 2);
+        destination += 2;
+    }
+}
+
+
+/**
+ * Test if a character buffer contains any lowercase characters.
+ *
+ * @param data   The data to test.
+ * @param length The data length.
+ *
+ * @return true if there are characters that uppercasing would change.
+ */
+bool StringUtil::hasLowerCase(const char *data, size_t length)
+{
+    // 7-bit data can be checked eight characters at a time, anything else
+    // goes through toupper() a character at a time.
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t), data += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        if ((word & HIGH_BITS) == 0)
+        {
+            if (characterRangeMask(word, 'a', 'z') != 0)
+            {
+                return true;
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < sizeof(uint64_t); i++)
+            {
+                if (data[i] != toupper(data[i]))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    for (; length > 0; length--, data++)
+    {
+        if (*data != toupper(*data))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * Test if a character buffer contains any uppercase characters.
+ *
+ * @param data   The data to test.
+ * @param length The data length.
+ *
+ * @return true if there are characters that lowercasing would change.
+ */
+bool StringUtil::hasUpperCase(const char *data, size_t length)
+{
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t), data += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        if ((word & HIGH_BITS) == 0)
+        {
+            if (characterRangeMask(word, 'A', 'Z') != 0)
+            {
+                return true;
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < sizeof(uint64_t); i++)
+            {
+                if (data[i] != tolower(data[i]))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    for (; length > 0; length--, data++)
+    {
+        if (*data != tolower(*data))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * Uppercase a character buffer.  The source and destination
+ * may be the same location.
+ *
+ * @param source      The source characters.
+ * @param destination The output location.
+ * @param length      The number of characters.
+ */
+void StringUtil::upperCase(const char *source, char *destination, size_t length)
+{
+    // 7-bit data is converted eight characters at a time by flipping the
+    // case bit of each lowercase letter.  Anything else goes through
+    // toupper() so the results match the single character conversion.
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, source, sizeof(word));
+        if ((word & HIGH_BITS) == 0)
+        {
+            word ^= characterRangeMask(word, 'a', 'z') >> 2;
+            memcpy(destination, &word, sizeof(word));
+        }
+        else
+        {
+            for (size_t i = 0; i < sizeof(uint64_t); i++)
+            {
+                destination[i] = toupper(source[i]);
+            }
+        }
+        source += sizeof(uint64_t);
+        destination += sizeof(uint64_t);
+    }
+
+    for (; length > 0; length--)
+    {
+        *destination++ = toupper(*source++);
+    }
+}
+
+
+/**
+ * Lowercase a character buffer.  The source and destination
+ * may be the same location.
+ *
+ * @param source      The source characters.
+ * @param destination The output location.
+ * @param length      The number of characters.
+ */
+void StringUtil::lowerCase(const char *source, char *destination, size_t length)
+{
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, source, sizeof(word));
+        if ((word & HIGH_BITS) == 0)
+        {
+            word ^= characterRangeMask(word, 'A', 'Z') >> 2;
+            memcpy(destination, &word, sizeof(word));
+        }
+        else
+        {
+            for (size_t i = 0; i < sizeof(uint64_t); i++)
+            {
+                destination[i] = tolower(source[i]);
+            }
+        }
+        source += sizeof(uint64_t);
+        destination += sizeof(uint64_t);
+    }
+
+    for (; length > 0; length--)
+    {
+        *destination++ = tolower(*source++);
+    }
+}
+
+
+/**
+ * Build the 256 character mapping table for a TRANSLATE
+ * operation, so the translation itself is a single lookup per
+ * character.
+ *
+ * @param table      The table to fill in (256 characters).
+ * @param outTable   The output table data.
+ * @param outTableLength
+ *                   The output table length.
+ * @param inTable    The input table data.
+ * @param inTableLength
+ *                   The input table length.
+ * @param useInTable false if there is no input table, which makes each
+ *                   character's position its own value.
+ * @param pad        The pad character used for positions beyond the
+ *                   output table.
+ */
+void StringUtil::buildTranslateTable(char *table, const char *outTable, size_t outTableLength,
+    const char *inTable, size_t inTableLength, bool useInTable, char pad)
+{
+    if (useInTable)
+    {
+        // characters not in the input table are left unchanged
+        for (size_t i = 0; i < 256; i++)
+        {
+            table[i] = (char)i;
+        }
+        // we fill this in backwards so that the first occurrence of
+        // a character in the input table is the one that is used.
+        for (size_t position = inTableLength; position > 0; position--)
+        {
+            table[(unsigned char)inTable[position - 1]] = position - 1 < outTableLength ? outTable[position - 1] : pad;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < 256; i++)
+        {
+            table[i] = i < outTableLength ? outTable[i] : pad;
+        }
+    }
+}
+
+
+/**
+ * Translate a character buffer in place using a table built by
+ * buildTranslateTable().
+ *
+ * @param data   The data to translate.
+ * @param length The data length.
+ * @param table  The mapping table.
+ */
+void StringUtil::translateCharacters(char *data, size_t length, const char *table)
+{
+    for (; length > 0; length--, data++)
+    {
+        *data = table[(unsigned char)*data];
+    }
+}
+
+
+// the combining operations for the bit kernels
+struct AndBits
+{
+    template <class T> static inline T apply(T a, T b) { return (T)(a & b); }
+};
+
+struct OrBits
+{
+    template <class T> static inline T apply(T a, T b) { return (T)(a | b); }
+};
+
+struct XorBits
+{
+    template <class T> static inline T apply(T a, T b) { return (T)(a ^ b); }
+};
+
+
+/**
+ * Combine two character buffers, eight characters at a time.
+ *
+ * @param target The target buffer, which is updated in place.
+ * @param source The other operand.
+ * @param length The number of characters to process.
+ */
+template <class Combine> static void combineBits(char *target, const char *source, size_t length)
+{
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t))
+    {
+        uint64_t targetWord;
+        uint64_t sourceWord;
+        memcpy(&targetWord, target, sizeof(targetWord));
+        memcpy(&sourceWord, source, sizeof(sourceWord));
+        targetWord = Combine::apply(targetWord, sourceWord);
+        memcpy(target, &targetWord, sizeof(targetWord));
+        target += sizeof(uint64_t);
+        source += sizeof(uint64_t);
+    }
+
+    for (; length > 0; length--)
+    {
+        *target = Combine::apply(*target, *source++);
+        target++;
+    }
+}
+
+
+/**
+ * Combine a character buffer with a pad character, eight
+ * characters at a time.
+ *
+ * @param target The target buffer, which is updated in place.
+ * @param pad    The pad character.
+ * @param length The number of characters to process.
+ */
+template <class Combine> static void combineBits(char *target, char pad, size_t length)
+{
+    uint64_t padWord = (unsigned char)pad * LOW_BYTES;
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t))
+    {
+        uint64_t targetWord;
+        memcpy(&targetWord, target, sizeof(targetWord));
+        targetWord = Combine::apply(targetWord, padWord);
+        memcpy(target, &targetWord, sizeof(targetWord));
+        target += sizeof(uint64_t);
+    }
+
+    for (; length > 0; length--)
+    {
+        *target = Combine::apply(*target, pad);
+        target++;
+    }
+}
+
+
+/**
+ * Perform one of the BITAND/BITOR/BITXOR operations between two
+ * buffers.
+ *
+ * @param op     The operation to perform.
+ * @param target The target buffer, which is updated in place.
+ * @param source The other operand.
+ * @param length The number of characters to process.
+ */
+void StringUtil::bitOperation(BitOperation op, char *target, const char *source, size_t length)
+{
+    switch (op)
+    {
+        case BIT_AND:
+            combineBits<AndBits>(target, source, length);
+            break;
+        case BIT_OR:
+            combineBits<OrBits>(target, source, length);
+            break;
+        case BIT_XOR:
+            combineBits<XorBits>(target, source, length);
+            break;
+    }
+}
+
+
+/**
+ * Perform one of the BITAND/BITOR/BITXOR operations between a
+ * buffer and a pad character.
+ *
+ * @param op     The operation to perform.
+ * @param target The target buffer, which is updated in place.
+ * @param pad    The pad character.
+ * @param length The number of characters to process.
+ */
+void StringUtil::bitOperation(BitOperation op, char *target, char pad, size_t length)
+{
+    switch (op)
+    {
+        case BIT_AND:
+            combineBits<AndBits>(target, pad, length);
+            break;
+        case BIT_OR:
+            combineBits<OrBits>(target, pad, length);
+            break;
+        case BIT_XOR:
+            combineBits<XorBits>(target, pad, length);
+            break;
+    }
+}
@@ -50,7 +50,15 @@ class ArrayClass;
 class StringUtil
 {
 public:
-    static RexxString *substr(const char *, size_t, RexxInteger *, RexxInteger *, RexxString *);
+    // the operations performed by the bitOperation() kernels
+    typedef enum
+    {
+        BIT_AND,
+        BIT_OR,
+        BIT_XOR,
+    } BitOperation;
+
+    static RexxString *substr(const char *, size_t, RexxInteger *, RexxInteger *, RexxString *, RexxString *source = OREF_NULL);
     static RexxString *substr(const char *, size_t, RexxInteger *, RexxInteger *);
     static RexxInteger *posRexx(const char *stringData, size_t length, RexxString *needle, RexxInteger *pstart, RexxInteger *range);
     static RexxObject *containsRexx(const char *stringData, size_t length, RexxString *needle, RexxInteger *pstart, RexxInteger *range);
@@ -70,7 +78,7 @@ public:
     static char packNibble(const char *String);
     static RexxString *packHex(const char *String, size_t StringLength);
     static size_t chGetSm(char *Destination, const char *Source, size_t Length, size_t Count, const char *Set, size_t &ScannedSize);
-    static size_t validateSet(const char *String, size_t Length, const char *Set, int Modulus, bool Hex);
+    static size_t validateSet(const char *String, size_t Length, int Modulus, bool Hex);
     static char packByte2(const char *Byte);
     static bool validateCharacterSet(const char *String, size_t Length, const char *Set, int Modulus, size_t &PackedSize);
     static const char *memcpbrk(const char *String, const char *Set, size_t Length);
@@ -80,15 +88,40 @@ public:
     static size_t caselessCountStr(const char *hayStack, size_t hayStackLength, RexxString *needle);
     static size_t memPos(const char *string, size_t length, char target);
     static RexxInteger *verify(const char *data, size_t stringLen, RexxString  *ref, RexxString  *option, RexxInteger *_start, RexxInteger *range);
-    static RexxString *subWord(const char *data, size_t length, RexxInteger *position, RexxInteger *plength);
-    static ArrayClass *subWords(const char *data, size_t length, RexxInteger *position, RexxInteger *plength);
-    static RexxString *word(const char *data, size_t length, RexxInteger *position);
-    static RexxInteger *wordIndex(const char *data, size_t length, RexxInteger *position);
-    static RexxInteger *wordLength(const char *data, size_t length, RexxInteger *position);
-    static size_t wordPos(const char *data, size_t length, RexxString  *phrase, RexxInteger *pstart);
-    static size_t caselessWordPos(const char *data, size_t length, RexxString  *phrase, RexxInteger *pstart);
+    static RexxString *subWord(const char *data, size_t length, RexxInteger *position, RexxInteger *plength, const size_t *offsets = NULL, RexxString *source = OREF_NULL);
+    static ArrayClass *subWords(const char *data, size_t length, RexxInteger *position, RexxInteger *plength, const size_t *offsets = NULL);
+    static RexxString *word(const char *data, size_t length, RexxInteger *position, const size_t *offsets = NULL);
+    static RexxInteger *wordIndex(const char *data, size_t length, RexxInteger *position, const size_t *offsets = NULL);
+    static RexxInteger *wordLength(const char *data, size_t length, RexxInteger *position, const size_t *offsets = NULL);
+    static size_t wordPos(const char *data, size_t length, RexxString  *phrase, RexxInteger *pstart, const size_t *offsets = NULL);
+    static size_t caselessWordPos(const char *data, size_t length, RexxString  *phrase, RexxInteger *pstart, const size_t *offsets = NULL);
     static ArrayClass   *words(const char *data, size_t length);
     static const char  *locateSeparator(const char *start, const char *end, const char *sepData, size_t sepLength);
+    static void encodeHex(const char *source, size_t length, char *destination);
+    static bool hasLowerCase(const char *data, size_t length);
+    static bool hasUpperCase(const char *data, size_t length);
+    static void upperCase(const char *source, char *destination, size_t length);
+    static void lowerCase(const char *source, char *destination, size_t length);
+    static void buildTranslateTable(char *table, const char *outTable, size_t outTableLength, const char *inTable, size_t inTableLength, bool useInTable, char pad);
+    static void translateCharacters(char *data, size_t length, const char *table);
+    static void bitOperation(BitOperation op, char *target, const char *source, size_t length);
+    static void bitOperation(BitOperation op, char *target, char pad, size_t length);
+
+    // return the value of a hex digit, or -1 if this is not a hex digit
+    static inline int hexDigitValue(char ch)
+    {
+        return hexDigitValues[(unsigned char)ch];
+    }
+
+    // return the value of a base64 digit, or -1 if this is not a base64 digit
+    static inline int base64DigitValue(char ch)
+    {
+        return base64DigitValues[(unsigned char)ch];
+    }
+
+    static signed char hexDigitValues[256];     // hex digit values, indexed by character
+    static signed char base64DigitValues[256];  // base64 digit values, indexed by character
+    static char hexDigitPairs[256][2];          // the C2X expansion of each character
 
     static inline bool matchCharacter(char ch, const char *charSet, size_t len)
     {
@@ -236,6 +236,19 @@ void Activity::runThread()
         runsem.reset();
         guardsem.reset();
 
+        // a start worker keeps running queued messages rather than
+        // returning to the pool while there is work waiting
+        if (startWorker)
+        {
+            MessageClass *next = instance->nextStart(this);
+            if (next != OREF_NULL)
+            {
+                next->dispatchStart(this);
+                releaseAccess();
+                continue;
+            }
+        }
+
         // try to pool this.  If the ActivityManager doesn't take it,
         // we go into termination mode
         if (!instance->poolActivity(this))
@@ -1844,11 +1857,20 @@ void Activity::waitReserve(RexxInternalObject *resource)
     // clear the run semaphore and save the object we're waiting on
     runsem.reset();
     waitingObject = resource;
+    // a blocked start worker gives its slot to any queued messages
+    if (startWorker)
+    {
+        instance->parkStartWorker(this);
+    }
     // release the interpreter lock and wait for access.  Don't continue
     // until we get the lock back
     releaseAccess();
     runsem.wait();
     requestAccess();
+    if (startWorker)
+    {
+        instance->unparkStartWorker();
+    }
 }
 
 
@@ -1859,9 +1881,17 @@ void Activity::guardWait()
 {
     // we release the access while we are waiting so something
     // can actually run to post the change event.
+    if (startWorker)
+    {
+        instance->parkStartWorker(this);
+    }
     releaseAccess();
     guardsem.wait();
     requestAccess();
+    if (startWorker)
+    {
+        instance->unparkStartWorker();
+    }
 }
 
 
@@ -1916,6 +1946,15 @@ void Activity::relinquish()
     ActivityManager::relinquish(this);
 }
 
+/**
+ * Periodic relinquish check, which only gives up control
+ * once the time slice is used up.
+ */
+void Activity::relinquishTimeSlice()
+{
+    ActivityManager::relinquishTimeSlice(this);
+}
+
 /**
  * Tap the current running activation on this activity to
  * give up control at the next reasonsable boundary.
@@ -2007,8 +2046,9 @@ void Activity::releaseAccess()
  */
 void Activity::requestAccess()
 {
-    // try the fast version first
-    if (ActivityManager::lockKernelImmediate())
+    // try the fast version first, then spin a little in case the holder is
+    // about to release
+    if (ActivityManager::lockKernelImmediate() || ActivityManager::lockKernelSpin())
     {
         // update the current activity pointer and the global numeric settings.
         ActivityManager::currentActivity = this;
@@ -69,6 +69,7 @@ class ActivityDispatcher;
 class CallbackDispatcher;
 class TrappingDispatcher;
 class CommandHandler;
+class CommandIOCapture;
 class ActivationFrame;
 class ActivationBase;
 class NativeActivation;
@@ -172,6 +173,7 @@ class Activity : public RexxInternalObject
     void        kill(DirectoryClass *);
     void        joinKernelQueue();
     void        relinquish();
+    void        relinquishTimeSlice();
     bool        halt(RexxString *);
     bool        setTrace(bool);
     inline void yieldControl() { releaseAccess(); requestAccess(); }
@@ -235,6 +237,8 @@ class Activity : public RexxInternalObject
     inline void setNestedActivity(Activity *a) { nestedActivity = a; }
     inline Activity *getNestedActivity() { return nestedActivity; }
     inline bool isAttached() { return attached; }
+    inline bool isStartWorker() { return startWorker; }
+    inline void setStartWorker(bool w) { startWorker = w; }
            void validateThread();
 
     SecurityManager *getEffectiveSecurityManager();
@@ -285,6 +289,8 @@ class Activity : public RexxInternalObject
     }
 
     inline DirectoryClass *getCurrentCondition() { return conditionobj; }
+    inline CommandIOCapture *getCommandCapture() { return commandCapture; }
+    inline void setCommandCapture(CommandIOCapture *c) { commandCapture = c; }
     inline void           clearCurrentCondition() { conditionobj = OREF_NULL; }
     void setExitHandler(int exitNum, REXXPFN e) { getExitHandler(exitNum).setEntryPoint(e); }
     void setExitHandler(int exitNum, const char *e) { getExitHandler(exitNum).resolve(e); }
@@ -345,6 +351,7 @@ class Activity : public RexxInternalObject
     bool     suspended;                 // the suspension flag
     bool     interpreterRoot;           // This is the root activity for an interpreter instance
     bool     attached;                  // this is attached to an instance (vs. created directly)
+    bool     startWorker;               // running started messages for the instance start scheduler
     size_t   nestedCount;               // extent of the nesting
     size_t   attachCount;               // extent of nested attaches
     char       *stackBase;              // pointer to base of C stack
@@ -353,6 +360,7 @@ class Activity : public RexxInternalObject
     ProtectedBase *protectedObjects;    // list of stack-based object protectors
     ActivationFrame *activationFrames;  // list of stack-based object protectors
     Activity *nestedActivity;       // used to push down activities in threads with more than one instance
+    CommandIOCapture *commandCapture;   // output capture for the command handler currently running
 
     // structures containing the various interface vectors
     static RexxThreadInterface threadContextFunctions;
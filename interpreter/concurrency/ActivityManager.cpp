@@ -74,6 +74,11 @@ SysMutex ActivityManager::kernelSemaphore;
 // the termination complete semaphore
 SysSemaphore ActivityManager::terminationSem;
 
+// kernel lock sharing policy
+bool ActivityManager::fairKernelLock = true;
+uint64_t ActivityManager::timeSlice = ActivityManager::DEFAULT_TIME_SLICE;
+uint64_t ActivityManager::sliceStart = 0;
+
 
 /**
  * Initialize the activity manager when the interpreter starts up.
@@ -155,11 +160,12 @@ void ActivityManager::addWaitingActivity(Activity *waitingAct, bool release )
         sentinel = false;
         // if we are the current kernel semaphore owner, time to release this
         // so other waiters can
+        // the head of the queue has already been posted and is waiting on the
+        // kernel lock, so releasing it hands the lock straight over.
         if (release)
         {
             unlockKernel();
         }
-        SysActivity::yield();            // yield the thread
         waitingAct->waitForDispatch();   // wait for this thread to get dispatched again
     }
 
@@ -555,6 +561,7 @@ void ActivityManager::exit(int retcode)
 void ActivityManager::lockKernel()
 {
     kernelSemaphore.request();
+    sliceStart = 0;
 }
 
 
@@ -606,10 +613,41 @@ void ActivityManager::closeLocks()
 bool ActivityManager::lockKernelImmediate()
 {
     // don't give this up if we have activities in the
-    // dispatch queue
-    if (waitingActivities.empty())
+    // dispatch queue, unless new requesters are allowed to barge in
+    if (waitingActivities.empty() || !fairKernelLock)
+    {
+        if (kernelSemaphore.requestImmediate())
+        {
+            sliceStart = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * Spin briefly on a busy kernel lock before joining the
+ * waiting queue.  The lock is frequently released after a
+ * short hold (an activity dropping it around a system call), so
+ * this avoids parking the thread on its run semaphore.
+ *
+ * @return true if the kernel lock was obtained.
+ */
+bool ActivityManager::lockKernelSpin()
+{
+    for (size_t i = 0; i < KERNEL_SPIN_LIMIT; i++)
     {
-        return kernelSemaphore.requestImmediate();
+        // with a fair lock, there's no point spinning once somebody is in line
+        if (fairKernelLock && hasWaiters())
+        {
+            return false;
+        }
+        SysActivity::relax();
+        if (lockKernelImmediate())
+        {
+            return true;
+        }
     }
     return false;
 }
@@ -818,6 +856,39 @@ void ActivityManager::relinquish(Activity *activity)
 }
 
 
+/**
+ * Periodic version of relinquish used between instructions and
+ * method calls.  Without a time slice timer, we're called after a
+ * fixed number of instructions, so hold on to the lock until a full
+ * time slice has passed since the waiters were first noticed.  This
+ * keeps two busy threads from switching every few clauses.
+ *
+ * @param activity The current active activity.
+ */
+void ActivityManager::relinquishTimeSlice(Activity *activity)
+{
+    if (hasWaiters())
+    {
+#ifndef FIXEDTIMERS
+        if (timeSlice != 0)
+        {
+            uint64_t now = SysActivity::getMicroseconds();
+            if (sliceStart == 0)
+            {
+                sliceStart = now;
+                return;
+            }
+            if (now - sliceStart < timeSlice)
+            {
+                return;
+            }
+        }
+#endif
+        addWaitingActivity(activity, true);
+    }
+}
+
+
 /**
  * Retrieve a variable from the current local environment
  * object.
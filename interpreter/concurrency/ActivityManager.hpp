@@ -74,6 +74,9 @@ public:
     static void lockKernel();
     static void unlockKernel();
     static bool lockKernelImmediate();
+    static bool lockKernelSpin();
+    static inline void setFairKernelLock(bool f) { fairKernelLock = f; }
+    static inline void setTimeSlice(uint64_t t) { timeSlice = t; }
     static void createLocks();
     static void closeLocks();
     static void init();
@@ -94,6 +97,7 @@ public:
     static void yieldCurrentActivity();
     static void exit(int retcode);
     static void relinquish(Activity *activity);
+    static void relinquishTimeSlice(Activity *activity);
     static Activity *getRootActivity();
     static void returnRootActivity(Activity *activity);
     static Activity *attachThread();
@@ -122,6 +126,10 @@ protected:
 
     // maximum number of activities we'll pool
     static const size_t MAX_THREAD_POOL_SIZE = 5;
+    // number of times to retry a busy kernel lock before waiting in line
+    static const size_t KERNEL_SPIN_LIMIT = 100;
+    // how long (in microseconds) a contended kernel lock is held before relinquishing
+    static const uint64_t DEFAULT_TIME_SLICE = 10000;
 
     static QueueClass       *availableActivities;     // table of available activities
     static QueueClass       *allActivities;           // table of all activities
@@ -132,6 +140,9 @@ protected:
     static SysSemaphore      terminationSem;          // used to signal that everything has shutdown
     static volatile bool sentinel;                    // used to ensure proper ordering of updates
     static std::deque<Activity *>waitingActivities;   // queue of waiting activities
+    static bool              fairKernelLock;          // new requesters may not jump the waiting queue
+    static uint64_t          timeSlice;               // time a contended lock is held (0 is every relinquish)
+    static uint64_t          sliceStart;              // when the lock holder first saw waiters
 };
 
 
@@ -93,8 +93,10 @@ void CommandHandler::resolve(const char *handlerName)
  * @param command    The command string.
  * @param result     The returned RC value.
  * @param condition  A potential returned condition object.
+ * @param capture    Optional output capture buffers.  Only the context
+ *                   style system handlers fill these in.
  */
-void CommandHandler::call(Activity *activity, RexxActivation *activation, RexxString *address, RexxString *command, ProtectedObject &result, ProtectedObject &condition)
+void CommandHandler::call(Activity *activity, RexxActivation *activation, RexxString *address, RexxString *command, ProtectedObject &result, ProtectedObject &condition, CommandIOCapture *capture)
 {
     if (type == REGISTERED_NAME)
     {
@@ -108,11 +110,44 @@ void CommandHandler::call(Activity *activity, RexxActivation *activation, RexxSt
     {
         ContextCommandHandlerDispatcher dispatcher(entryPoint, address, command, result, condition);
 
+        // the handler picks the capture buffers up from the activity
+        activity->setCommandCapture(capture);
         // run this and give back the return code
         activity->run(dispatcher);
+        activity->setCommandCapture(NULL);
     }
 }
 
+
+/**
+ * Append data to a command capture buffer, growing the buffer
+ * as needed.
+ *
+ * @param newData   The data to append.
+ * @param newLength The length of the data.
+ */
+void CommandCaptureBuffer::append(const char *newData, size_t newLength)
+{
+    if (length + newLength > size)
+    {
+        size_t newSize = size == 0 ? 4096 : size;
+        while (newSize < length + newLength)
+        {
+            newSize *= 2;
+        }
+        char *newBuffer = (char *)realloc(data, newSize);
+        // if we can't grow this, the rest of the output is just dropped
+        if (newBuffer == NULL)
+        {
+            return;
+        }
+        data = newBuffer;
+        size = newSize;
+    }
+    memcpy(data + length, newData, newLength);
+    length += newLength;
+}
+
 CommandHandlerDispatcher::CommandHandlerDispatcher(Activity *a, REXXPFN e, RexxString *command)
 {
     activity = a;               // needed for raising conditions
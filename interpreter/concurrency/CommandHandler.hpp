@@ -49,6 +49,42 @@
 
 class Activity;
 
+
+/**
+ * A growable byte buffer used to collect the output of a
+ * command issued with ADDRESS env command WITH OUTPUT/ERROR.
+ * The system command handler fills this while running without
+ * kernel access, so this is plain malloc() storage rather than
+ * a Rexx object.
+ */
+class CommandCaptureBuffer
+{
+public:
+    inline CommandCaptureBuffer() : data(NULL), length(0), size(0), active(false) { }
+    inline ~CommandCaptureBuffer() { if (data != NULL) { free(data); } }
+
+    void append(const char *newData, size_t newLength);
+
+    char  *data;                          // the collected data
+    size_t length;                        // bytes collected so far
+    size_t size;                          // allocated buffer size
+    bool   active;                        // the command stream is to be captured
+};
+
+
+/**
+ * The capture targets for a single command invocation.
+ */
+class CommandIOCapture
+{
+public:
+    inline CommandIOCapture(bool o, bool e) { output.active = o; error.active = e; }
+
+    CommandCaptureBuffer output;          // captured stdout
+    CommandCaptureBuffer error;           // captured stderr
+};
+
+
 class CommandHandler : public RexxInternalObject
 {
 public:
@@ -59,7 +95,7 @@ public:
     inline CommandHandler(REXXPFN e) : entryPoint(e) { type = DIRECT; }
     inline CommandHandler(const char *n) : entryPoint(NULL) { type = UNRESOLVED; resolve(n); }
 
-    void call(Activity *activity, RexxActivation *activation, RexxString *address, RexxString *command, ProtectedObject &rc, ProtectedObject &condition);
+    void call(Activity *activity, RexxActivation *activation, RexxString *address, RexxString *command, ProtectedObject &rc, ProtectedObject &condition, CommandIOCapture *capture);
     void resolve(const char *name);
     inline bool isResolved() { return type != UNRESOLVED; }
 
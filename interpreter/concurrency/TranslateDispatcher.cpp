@@ -39,6 +39,7 @@
 #include "RexxCore.h"
 #include "TranslateDispatcher.hpp"
 #include "RoutineClass.hpp"
+#include "PackageClass.hpp"
 #include "ProtectedObject.hpp"
 #include "NativeActivation.hpp"
 #include "LanguageParser.hpp"
@@ -90,6 +91,11 @@ void TranslateDispatcher::run()
         }
         savedObjects.add(program);
     }
+    // pull the required packages into the image?
+    if (bundleRequires)
+    {
+        program->getPackageObject()->bundleRequires(activity);
+    }
     if (outputName != NULL)              /* want to save this to a file?      */
     {
         /* go save this method               */
@@ -45,7 +45,7 @@
 class TranslateDispatcher : public ActivityDispatcher
 {
 public:
-    inline TranslateDispatcher() : ActivityDispatcher() { ; }
+    inline TranslateDispatcher() : ActivityDispatcher(), bundleRequires(false) { ; }
     virtual ~TranslateDispatcher() { ; }
 
     virtual void run();
@@ -54,6 +54,7 @@ public:
     const char *programName;             /* REXX program to run               */
     PRXSTRING  instore;                  /* Instore array                     */
     const char *outputName;              // optional program output name
+    bool        bundleRequires;          // compile the ::REQUIRES files into the output too
 };
 
 
@@ -111,6 +111,28 @@ void CPPCode::liveGeneral(MarkReason reason)
 }
 
 
+/**
+ * Check a CPPCode object from a flattened buffer.  The
+ * method index gets resolved against the exported methods
+ * table during the unflatten.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if the method index is part of the table.
+ */
+bool CPPCode::isValidFlattened(ValidatingMarkHandler &image)
+{
+    for (size_t i = 0; exportedMethods[i] != NULL; i++)
+    {
+        if (i == methodIndex)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 /**
  * Run (or call) a CPPMethod.
  *
@@ -215,6 +237,7 @@ void *AttributeGetterCode::operator new(size_t size)
 void AttributeGetterCode::live(size_t liveMark)
 {
     memory_mark(attribute);
+    memory_mark(slotScope);
 }
 
 
@@ -225,7 +248,15 @@ void AttributeGetterCode::live(size_t liveMark)
  */
 void AttributeGetterCode::liveGeneral(MarkReason reason)
 {
+    // the slot number is discarded with the scope assignments
+    if (reason == PREPARINGIMAGE)
+    {
+        slotScope = OREF_NULL;
+        variableSlot = 0;
+    }
+
     memory_mark_general(attribute);
+    memory_mark_general(slotScope);
 }
 
 
@@ -239,11 +270,43 @@ void AttributeGetterCode::flatten(Envelope *envelope)
     setUpFlatten(AttributeGetterCode)
 
     flattenRef(attribute);
+    // slot numbers are only meaningful in this process
+    newThis->slotScope = OREF_NULL;
+    newThis->variableSlot = 0;
 
     cleanUpFlatten
 }
 
 
+/**
+ * Get the slot number of the attribute variable in a given
+ * method scope.
+ *
+ * @param scope  The scope of the method.
+ *
+ * @return The variable slot number, or 0 if the variable must be
+ *         accessed by name.
+ */
+size_t AttributeGetterCode::getVariableSlot(RexxClass *scope)
+{
+    // methods not defined by a class have no slot assignments.  Note that
+    // the scope of a method added to a single object is the object itself.
+    if (scope == OREF_NULL || !isOfClassType(Class, scope))
+    {
+        return 0;
+    }
+
+    // the code can be shared between scopes, so recalculate on a scope change
+    if (scope != slotScope)
+    {
+        RexxString *name = attribute->getSlotName();
+        variableSlot = name == OREF_NULL ? 0 : scope->getVariableSlot(name);
+        setField(slotScope, scope);
+    }
+    return variableSlot;
+}
+
+
 /**
  * Execute an attribute-get operation.
  *
@@ -264,17 +327,18 @@ void AttributeGetterCode::run(Activity *activity, MethodClass *method, RexxObjec
     {
         reportException(Error_Incorrect_method_maxarg, (wholenumber_t)0);
     }
+    size_t slot = getVariableSlot(method->getScope());
+    VariableDictionary *objectVariables = receiver->getObjectVariables(method->getScope());
     // this is simplier if the method is not guarded
     if (!method->isGuarded())
     {
-        result = attribute->getValue(receiver->getObjectVariables(method->getScope()));
+        result = slot != 0 ? attribute->getSlotValue(objectVariables, slot) : attribute->getValue(objectVariables);
     }
     else
     {
-        // get the variable pool and get the guard lock
-        VariableDictionary *objectVariables = receiver->getObjectVariables(method->getScope());
+        // get the guard lock
         objectVariables->reserve(activity);
-        result = attribute->getValue(objectVariables);
+        result = slot != 0 ? attribute->getSlotValue(objectVariables, slot) : attribute->getValue(objectVariables);
         // and ensure we release this afterwards
         objectVariables->release(activity);
     }
@@ -320,19 +384,34 @@ void AttributeSetterCode::run(Activity *activity, MethodClass *method, RexxObjec
         missingArgument(ARG_ONE);
     }
 
+    size_t slot = getVariableSlot(method->getScope());
+    VariableDictionary *objectVariables = receiver->getObjectVariables(method->getScope());
     // this is simplier if the method is not guarded
     if (!method->isGuarded())
     {
         // go set the attribue
-        attribute->set(receiver->getObjectVariables(method->getScope()), argPtr[0]);
+        if (slot != 0)
+        {
+            attribute->setSlot(objectVariables, slot, argPtr[0]);
+        }
+        else
+        {
+            attribute->set(objectVariables, argPtr[0]);
+        }
     }
     else
     {
-        // get the variable pool and get the guard lock
-        VariableDictionary *objectVariables = receiver->getObjectVariables(method->getScope());
+        // get the guard lock
         objectVariables->reserve(activity);
         // go set the attribue
-        attribute->set(objectVariables, argPtr[0]);
+        if (slot != 0)
+        {
+            attribute->setSlot(objectVariables, slot, argPtr[0]);
+        }
+        else
+        {
+            attribute->set(objectVariables, argPtr[0]);
+        }
         // and ensure we release this afterwards
         objectVariables->release(activity);
     }
@@ -1187,6 +1266,8 @@ CPPM(RexxInfo::getCaseSensitiveFiles),
 CPPM(RexxInfo::getMajorVersion),
 CPPM(RexxInfo::getRelease),
 CPPM(RexxInfo::getRevision),
+CPPM(RexxInfo::getInterpretCacheHits),
+CPPM(RexxInfo::getInterpretCacheMisses),
 // This NULL terminator is important to mark the end of the table.
 NULL
 };
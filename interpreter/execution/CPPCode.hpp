@@ -61,6 +61,7 @@ public:
 
     virtual void live(size_t mark);
     virtual void liveGeneral(MarkReason reason);
+    virtual bool isValidFlattened(ValidatingMarkHandler &);
 
     virtual void run(Activity *, MethodClass *, RexxObject *, RexxString *, RexxObject **, size_t, ProtectedObject &);
 
@@ -94,8 +95,12 @@ public:
 
     virtual void run(Activity *, MethodClass *, RexxObject *, RexxString *,  RexxObject **, size_t, ProtectedObject &);
 
+    size_t getVariableSlot(RexxClass *scope);
+
 protected:
     RexxVariableBase *attribute;      // method attribute info
+    RexxClass *slotScope;             // the scope the variable slot was assigned for
+    size_t variableSlot;              // the attribute's variable slot in that scope
 };
 
 
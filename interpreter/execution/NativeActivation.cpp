@@ -2379,8 +2379,9 @@ bool NativeActivation::fetchNext(RexxString *&name, RexxObject *&value)
  * @param exception_object
  *                  The exception object containing the specifics of the condition.
  *
- * @return false if this activation takes a pass on the condition.  Does not
- *         return at all if the condition is handled.
+ * @return false if this activation takes a pass on the condition, true if
+ *         a condition raised by an API call is recorded for the caller.  A
+ *         trapped SYNTAX condition does not return at all.
  */
 bool NativeActivation::trap(RexxString *condition, DirectoryClass * exception_object)
 {
@@ -2409,11 +2410,12 @@ bool NativeActivation::trap(RexxString *condition, DirectoryClass * exception_ob
         // pretty much the same deal, but we're only handling conditions, and
         // only one condtion, so reset the trap flag
         trapConditions = false;
-        // record this in case any callers want to know about it.
+        // record this in case any callers want to know about it.  There's
+        // nothing to unwind here, the API call just returns to the native code
+        // and the condition gets raised in our caller's context when the
+        // native code returns.
         setConditionInfo(exception_object);
-        // this will unwind back to the calling level, with the
-        // exception information recorded.
-        throw this;
+        return true;
     }
     return false;                        /* this wasn't handled               */
 }
@@ -2467,8 +2469,8 @@ void NativeActivation::raiseCondition(RexxString *condition, RexxString *descrip
     result = _result;
     activity->raiseCondition(condition, OREF_NULL, description, additional, result);
 
-    // We only return here if no activation above us has trapped this.  If we do return, then
-    // we terminate the call by throw this up the stack.
+    // the condition has been recorded (or nobody was interested in it), so we
+    // terminate the call by throwing this up the stack.
     throw this;
 }
 
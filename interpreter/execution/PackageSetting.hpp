@@ -58,6 +58,7 @@ typedef enum
 {
     NovalueError,
     NoProlog,
+    Optimize,
 } PackageFlags;
 
 
@@ -94,6 +95,9 @@ class PackageSetting
     inline void   enableProlog() { packageOptions[NoProlog] = false; }
     inline void   disableProlog() { packageOptions[NoProlog] = true; }
     inline bool   isPrologEnabled() { return !packageOptions[NoProlog]; }
+    inline void   enableOptimize() { packageOptions[Optimize] = true; }
+    inline void   disableOptimize() { packageOptions[Optimize] = false; }
+    inline bool   isOptimizeEnabled() { return packageOptions[Optimize]; }
 
     NumericSettings numericSettings;       // the package numeric settings
     TraceSetting    traceSettings;         // the package trace setting
@@ -611,7 +611,7 @@ RexxObject * RexxActivation::run(RexxObject *_receiver, RexxString *name, RexxOb
                 // not doing time slicing, so just relinquish every so often.
                 if (++instructionCount > MAX_INSTRUCTIONS)
                 {
-                    activity->relinquish();
+                    activity->relinquishTimeSlice();
                     instructionCount = 0;
                 }
 #endif
@@ -1172,8 +1172,10 @@ void RexxActivation::procedureExpose(RexxVariableBase **variables, size_t count)
  *
  * @param variables The list of variables to expose.
  * @param count     The variable count.
+ * @param slots     The scope slot numbers for the variables, if any.  A zero
+ *                  slot number means the variable is exposed by name.
  */
-void RexxActivation::expose(RexxVariableBase **variables, size_t count)
+void RexxActivation::expose(RexxVariableBase **variables, size_t count, NumberArray *slots)
 {
     // get the object variables for this object (at the current scope)
     VariableDictionary *objectVariables = getObjectVariables();
@@ -1181,7 +1183,15 @@ void RexxActivation::expose(RexxVariableBase **variables, size_t count)
     // now expose each individual variable
     for (size_t i = 0; i < count; i++)
     {
-        variables[i]->expose(this, objectVariables);
+        size_t slot = slots == OREF_NULL ? 0 : slots->get(i + 1);
+        if (slot != 0)
+        {
+            variables[i]->exposeSlot(this, objectVariables, slot);
+        }
+        else
+        {
+            variables[i]->expose(this, objectVariables);
+        }
     }
 }
 
@@ -1516,6 +1526,10 @@ void RexxActivation::raiseExit(RexxString *condition, RexxObject *rc, RexxString
         activity->popStackFrame(false);
         // propagate to the parent
         parent->raiseExit(condition, rc, description, additional, resultObj, conditionobj);
+        // if we get back here, the parent was the top level and has processed the
+        // raise as a return.  Our execution loop is still on the stack, so unwind
+        // back to the parent.
+        throw parent;
     }
 }
 
@@ -1616,9 +1630,10 @@ void RexxActivation::raise(RexxString *condition, RexxObject *rc, RexxString *de
             reportException(Error_Program_interrupted_condition, GlobalNames::HALT);
         }
 
-        // process the return part, then unwind the call stack
+        // process the return part.  This stops our execution loop the same way
+        // a RETURN instruction does, so there is nothing to unwind when we are
+        // the activation running the RAISE.
         returnFrom(resultObj);
-        throw this;
     }
 }
 
@@ -2594,47 +2609,36 @@ RexxObject *RexxActivation::getContextReturnStatus()
 
 
 /**
- * Attempt to call a function stored in the macrospace.
+ * Call a function located in the macrospace.  The caller has
+ * already queried the macrospace and decided this is the right
+ * point in the search order to run it.
  *
- * @param target    The target function name.
- * @param arguments The argument pointer.
- * @param argcount  The count of arguments,
- * @param calltype  The type of call (FUNCTION or SUBROUTINE)
- * @param order     The macrospace order flag.
- * @param result    The function result.
+ * @param target     The target function name.
+ * @param arguments  The argument pointer.
+ * @param argcount   The count of arguments,
+ * @param calltype   The type of call (FUNCTION or SUBROUTINE)
+ * @param generation The macrospace generation returned by the query.
+ * @param result     The function result.
  *
  * @return true if the macrospace function was located and called.
  */
 bool RexxActivation::callMacroSpaceFunction(RexxString *target, RexxObject **arguments,
-    size_t argcount, RexxString *calltype, int order, ProtectedObject &_result)
+    size_t argcount, RexxString *calltype, size_t generation, ProtectedObject &_result)
 {
-    // the located macro search position
-    unsigned short position;
-    const char *macroName = target->getStringData();
-    // did we find the one we want at the right time?
-    if (RexxQueryMacro(macroName, &position) == 0)
-    {
-        // this was not found if the search order was different
-        if (order == position)
-        {
-            return false;
-        }
-        // unflatten the code now
-        Protected<RoutineClass> routine = getMacroCode(target);
+    // get the restored code, reusing an earlier restore if still valid
+    Protected<RoutineClass> routine = PackageManager::getMacroSpaceRoutine(target, generation);
 
-        // not restoreable is a call failure
-        if (routine == OREF_NULL)
-        {
-            return false;
-        }
-        // run as a call
-        routine->call(activity, target, arguments, argcount, calltype, OREF_NULL, EXTERNALCALL, _result);
-        // merge (class) definitions from macro with current settings
-        getPackageObject()->mergeRequired(routine->getPackageObject());
-        // we handled this
-        return true;
+    // not restoreable is a call failure
+    if (routine == OREF_NULL)
+    {
+        return false;
     }
-    return false;
+    // run as a call
+    routine->call(activity, target, arguments, argcount, calltype, OREF_NULL, EXTERNALCALL, _result);
+    // merge (class) definitions from macro with current settings
+    getPackageObject()->mergeRequired(routine->getPackageObject());
+    // we handled this
+    return true;
 }
 
 
@@ -2824,17 +2828,29 @@ RexxClass *RexxActivation::findClass(RexxString *name)
  * @return The resolved class, or OREF_NULL if not found.
  */
 RexxObject *RexxActivation::resolveDotVariable(RexxString *name)
+{
+    return getResolutionPackage()->findClass(name);
+}
+
+
+/**
+ * Return the package used to resolve environment symbols in
+ * this activation's context.
+ *
+ * @return The package object of the original source context.
+ */
+PackageClass *RexxActivation::getResolutionPackage()
 {
     // if not an interpret, then resolve directly.
     if (!isInterpret())
     {
-        return getPackageObject()->findClass(name);
+        return getPackageObject();
     }
     else
     {
         // otherwise, send this up the call chain and resolve in the
         // original source context
-        return parent->resolveDotVariable(name);
+        return parent->getResolutionPackage();
     }
 }
 
@@ -3857,10 +3873,12 @@ void RexxActivation::traceClause(RexxInstruction *clause, TracePrefix prefix)
  * @param commandString
  *                The command to issue
  * @param address The target address
+ * @param capture Optional buffers for capturing the command output
+ *                (ADDRESS env command WITH OUTPUT/ERROR).
  *
  * @return The return code object
  */
-void RexxActivation::command(RexxString *address, RexxString *commandString)
+void RexxActivation::command(RexxString *address, RexxString *commandString, CommandIOCapture *capture)
 {
     // if we are tracing command instructions, then we need to add some
     // additional trace information afterward.  Also, if we're tracing errors or
@@ -3877,7 +3895,7 @@ void RexxActivation::command(RexxString *address, RexxString *commandString)
         CommandHandler *handler = activity->resolveCommandHandler(address);
         if (handler != OREF_NULL)
         {
-            handler->call(activity, this, address, commandString, commandResult, condition);
+            handler->call(activity, this, address, commandString, commandResult, condition, capture);
         }
         else
         {
@@ -63,6 +63,8 @@ class SupplierClass;
 class PackageClass;
 class StackFrameClass;
 class RequiresDirective;
+class CommandIOCapture;
+class NumberArray;
 
 
 /**
@@ -172,7 +174,7 @@ class RexxActivation : public ActivationBase
    void              returnFrom(RexxObject *result);
    void              exitFrom(RexxObject *);
    void              procedureExpose(RexxVariableBase **variables, size_t count);
-   void              expose(RexxVariableBase **variables, size_t count);
+   void              expose(RexxVariableBase **variables, size_t count, NumberArray *slots);
    void              autoExpose(RexxVariableBase **variables, size_t count);
    void              setTrace(const TraceSetting &);
    void              setTrace(RexxString *);
@@ -200,12 +202,13 @@ class RexxActivation : public ActivationBase
    RexxObject      * externalCall(RexxString *, RexxObject **, size_t, RexxString *, ProtectedObject &);
    RexxObject      * internalCall(RexxString *, RexxInstruction *, RexxObject **, size_t, ProtectedObject &);
    RexxObject      * internalCallTrap(RexxString *, RexxInstruction *, DirectoryClass *, ProtectedObject &);
-   bool              callMacroSpaceFunction(RexxString *, RexxObject **, size_t, RexxString *, int, ProtectedObject &);
+   bool              callMacroSpaceFunction(RexxString *, RexxObject **, size_t, RexxString *, size_t, ProtectedObject &);
    static RoutineClass* getMacroCode(RexxString *macroName);
    RexxString       *resolveProgramName(RexxString *name);
    RexxClass        *findClass(RexxString *name);
    RexxObject       *resolveDotVariable(RexxString *name);
-   void              command(RexxString *, RexxString *);
+   PackageClass     *getResolutionPackage();
+   void              command(RexxString *, RexxString *, CommandIOCapture *capture = NULL);
    int64_t           getElapsed();
    RexxDateTime      getTime();
    RexxInteger     * random(RexxInteger *, RexxInteger *, RexxInteger *);
@@ -280,6 +283,7 @@ class RexxActivation : public ActivationBase
        DoBlock *temp = doStack;
        doStack = temp->getPrevious();
        settings.traceIndent = temp->getIndent();
+       temp->endBlock();
        temp->setHasNoReferences();
    }
 
@@ -295,6 +299,7 @@ class RexxActivation : public ActivationBase
    inline void              addBlockInstruction()    { blockNest++; indent(); };
    inline bool              hasActiveBlockInstructions() { return blockNest != 0; }
    inline bool              inMethod()  {return activationContext == METHODCALL; }
+   inline RexxClass        *getScope() { return scope; }
    inline void              indent() {settings.traceIndent++; };
    inline void              unindent() {if (settings.traceIndent > 0) settings.traceIndent--; };
    inline void              unindentTwice() {if (settings.traceIndent > 1) settings.traceIndent -= 2; };
@@ -49,6 +49,12 @@
 #include "ActivityManager.hpp"
 #include "RexxActivation.hpp"
 #include "LanguageParser.hpp"
+#include "StringTableClass.hpp"
+
+
+// INTERPRET translation cache statistics
+size_t RexxCode::interpretCacheHits = 0;
+size_t RexxCode::interpretCacheMisses = 0;
 
 
 /**
@@ -100,6 +106,7 @@ void RexxCode::live(size_t liveMark)
     memory_mark(package);
     memory_mark(start);
     memory_mark(labels);
+    memory_mark(interpretCache);
 }
 
 
@@ -117,11 +124,14 @@ void RexxCode::liveGeneral(MarkReason reason)
     if (reason == PREPARINGIMAGE)
     {
         package = TheRexxPackage;
+        // translated interpret strings are not saved
+        interpretCache = OREF_NULL;
     }
 
     memory_mark_general(package);
     memory_mark_general(start);
     memory_mark_general(labels);
+    memory_mark_general(interpretCache);
 }
 
 
@@ -137,6 +147,8 @@ void RexxCode::flatten(Envelope * envelope)
     flattenRef(package);
     flattenRef(start);
     flattenRef(labels);
+    // the interpret cache is just a runtime optimization
+    newThis->interpretCache = OREF_NULL;
 
     cleanUpFlatten
 }
@@ -208,8 +220,8 @@ void RexxCode::run(Activity *activity, MethodClass *method, RexxObject *receiver
     activity->pushStackFrame(newacta);
     // run the method.  The result is returned via the ProtectedObject reference.
     newacta->run(receiver, msgname, argPtr, argcount, OREF_NULL, result);
-    // yield control now.
-    activity->relinquish();
+    // yield control now if we've had our time slice.
+    activity->relinquishTimeSlice();
 }
 
 
@@ -262,5 +274,47 @@ RexxObject *RexxCode::setSecurityManager(RexxObject *manager)
  */
 RexxCode *RexxCode::interpret(RexxString *source, size_t lineNumber)
 {
-    return LanguageParser::translateInterpret(source, package, labels, lineNumber);
+    // The same string interpreted from the same line always translates to
+    // the same code, and interpreted code resolves its variables dynamically
+    // in the caller's context, so a recent translation can be reused.
+    if (interpretCache != OREF_NULL)
+    {
+        RexxCode *cached = (RexxCode *)interpretCache->get(source);
+        if (cached != OREF_NULL && cached->interpretLine == lineNumber)
+        {
+            interpretCacheHits++;
+            cached->interpretUsed = interpretCacheHits + interpretCacheMisses;
+            return cached;
+        }
+    }
+
+    interpretCacheMisses++;
+    Protected<RexxCode> newCode = LanguageParser::translateInterpret(source, package, labels, lineNumber);
+    newCode->interpretLine = lineNumber;
+    newCode->interpretUsed = interpretCacheHits + interpretCacheMisses;
+
+    if (interpretCache == OREF_NULL)
+    {
+        StringTable *cache = new_string_table();
+        setField(interpretCache, cache);
+    }
+    // full up?  Make room by dropping the least recently used entry, unless
+    // we're just replacing this string's translation for a different line.
+    else if (interpretCache->items() >= INTERPRET_CACHE_SIZE && interpretCache->get(source) == OREF_NULL)
+    {
+        RexxInternalObject *oldest = OREF_NULL;
+        size_t oldestUsed = SIZE_MAX;
+        for (HashContents::TableIterator iterator = interpretCache->iterator(); iterator.isAvailable(); iterator.next())
+        {
+            RexxCode *entry = (RexxCode *)iterator.value();
+            if (entry->interpretUsed < oldestUsed)
+            {
+                oldestUsed = entry->interpretUsed;
+                oldest = iterator.index();
+            }
+        }
+        interpretCache->remove(oldest);
+    }
+    interpretCache->put(newCode, source);
+    return newCode;
 }
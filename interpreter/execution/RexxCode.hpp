@@ -99,6 +99,12 @@ class RexxCode : public BaseCode
    inline void        mergeRequired(PackageClass *s) { package->mergeRequired(s); }
           RexxCode *interpret(RexxString *source, size_t lineNumber);
 
+   // maximum number of interpreted strings cached for each code object
+   static const size_t INTERPRET_CACHE_SIZE = 32;
+
+   static size_t interpretCacheHits;    // interpret strings found already translated
+   static size_t interpretCacheMisses;  // interpret strings that needed translating
+
 
 protected:
 
@@ -107,5 +113,8 @@ protected:
     StringTable     *labels;            // list of labels in this code block
     size_t           maxStack;          // maximum stack depth
     size_t           vdictSize;         // size of variable dictionary
+    StringTable     *interpretCache;    // recently interpreted strings and their translated code
+    size_t           interpretLine;     // for interpreted code, the line it was translated for
+    size_t           interpretUsed;     // for interpreted code, when the cache last returned it
 };
 #endif
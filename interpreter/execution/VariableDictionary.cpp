@@ -111,6 +111,7 @@ void VariableDictionary::live(size_t liveMark)
     memory_mark(waitingActivities);
     memory_mark(nextDictionary);
     memory_mark(scope);
+    memory_mark(variableSlots);
 }
 
 
@@ -121,11 +122,19 @@ void VariableDictionary::live(size_t liveMark)
  */
 void VariableDictionary::liveGeneral(MarkReason reason)
 {
+    // the slot numbers are assigned by the scope class, which
+    // discards them when the image is saved.
+    if (reason == PREPARINGIMAGE)
+    {
+        variableSlots = OREF_NULL;
+    }
+
     memory_mark_general(contents);
     memory_mark_general(reservingActivity);
     memory_mark_general(waitingActivities);
     memory_mark_general(nextDictionary);
     memory_mark_general(scope);
+    memory_mark_general(variableSlots);
 }
 
 
@@ -146,6 +155,8 @@ void VariableDictionary::flatten(Envelope *envelope)
     // if flattened.  Clear them out now.
     newThis->reservingActivity = OREF_NULL;
     newThis->waitingActivities = OREF_NULL;
+    // slot numbers are only meaningful in this process
+    newThis->variableSlots = OREF_NULL;
 
     cleanUpFlatten
 }
@@ -203,14 +214,9 @@ void VariableDictionary::expandContents(size_t capacity )
 {
     size_t bucketSize = HashCollection::calculateBucketSize(capacity);
     Protected<StringHashContents> newContents = allocateContents(bucketSize, bucketSize * 2);
-    // copy all of the items into the new table
-    contents->reMerge(newContents);
-    // if this is a contents item in the old space, we need to
-    // empty this so any old-to-new table entries in the contents can get updated.
-    if (contents->isOldSpace())
-    {
-        contents->empty();
-    }
+    // the new contents take over the old items, moving them over as
+    // new items get added.
+    newContents->migrateFrom(contents);
     // replace the contents
 
     setField(contents, newContents);
@@ -259,6 +265,8 @@ RexxInternalObject *VariableDictionary::copy()
     Protected<VariableDictionary> copyObj = (VariableDictionary *)clone();
     // now copy the contents
     copyObj->contents =  (StringHashContents *)contents->copy();
+    // the copy gets new variable objects, so the slots get rebuilt
+    copyObj->variableSlots = OREF_NULL;
     // copy all of the values in the table and return
     copyObj->copyValues();
     return copyObj;
@@ -498,6 +506,75 @@ void VariableDictionary::set(RexxString *name, RexxObject *value)
 }
 
 
+/**
+ * Get a variable using the slot number assigned by the
+ * dictionary scope.  The slots cache the same variable objects
+ * held in the dictionary, so access by name sees the same
+ * variables.
+ *
+ * @param slot   The slot number for the variable.
+ * @param name   The variable name, used to create the slot entry
+ *               if it is not filled in yet.
+ *
+ * @return The variable object.
+ */
+RexxVariable *VariableDictionary::getSlotVariable(size_t slot, RexxString *name)
+{
+    if (variableSlots != OREF_NULL && slot <= variableSlots->size())
+    {
+        RexxVariable *variable = (RexxVariable *)variableSlots->get(slot);
+        if (variable != OREF_NULL)
+        {
+            return variable;
+        }
+    }
+    return setSlotVariable(slot, getVariable(name));
+}
+
+
+/**
+ * Get a stem variable using the slot number assigned by the
+ * dictionary scope.
+ *
+ * @param slot     The slot number for the variable.
+ * @param stemName The stem variable name.
+ *
+ * @return The stem variable object.
+ */
+RexxVariable *VariableDictionary::getSlotStemVariable(size_t slot, RexxString *stemName)
+{
+    if (variableSlots != OREF_NULL && slot <= variableSlots->size())
+    {
+        RexxVariable *variable = (RexxVariable *)variableSlots->get(slot);
+        if (variable != OREF_NULL)
+        {
+            return variable;
+        }
+    }
+    return setSlotVariable(slot, getStemVariable(stemName));
+}
+
+
+/**
+ * Fill in a variable slot entry.
+ *
+ * @param slot     The target slot number.
+ * @param variable The variable for that slot.
+ *
+ * @return The variable object.
+ */
+RexxVariable *VariableDictionary::setSlotVariable(size_t slot, RexxVariable *variable)
+{
+    if (variableSlots == OREF_NULL)
+    {
+        ArrayClass *slots = new_array(slot);
+        setField(variableSlots, slots);
+    }
+    variableSlots->put(variable, slot);
+    return variable;
+}
+
+
 /**
  * Reserve a scope on an object, waiting for completion if this
  * is already reserved by another activity
@@ -189,9 +189,12 @@ class VariableDictionary : public RexxInternalObject
     void dropCompoundVariable(RexxString *stemName, RexxInternalObject **tail, size_t tailCount);
     StringTable *getAllVariables();
     DirectoryClass *getVariableDirectory();
-    inline void remove(RexxString *n) { contents->remove(n); }
+    inline void remove(RexxString *n) { contents->remove(n); variableSlots = OREF_NULL; }
 
     void         set(RexxString *, RexxObject *);
+    RexxVariable *getSlotVariable(size_t slot, RexxString *name);
+    RexxVariable *getSlotStemVariable(size_t slot, RexxString *stemName);
+    RexxVariable *setSlotVariable(size_t slot, RexxVariable *variable);
     void         drop(RexxString *);
     void         dropStemVariable(RexxString *);
     void         reserve(Activity *);
@@ -226,6 +229,7 @@ protected:
     unsigned short reserveCount;         // number of times reserved
     VariableDictionary *nextDictionary;  // chained object dictionary
     RexxClass *scope;                    // scopy of this object dictionary
+    ArrayClass *variableSlots;           // variables cached by their scope slot number
 };
 
 inline VariableDictionary *new_variableDictionary(size_t s) { return new VariableDictionary(s); }
@@ -65,6 +65,13 @@ class RexxVariableBase : public RexxInternalObject
     virtual void clearGuard(RexxActivation *) {;}
     virtual void expose(RexxActivation *, VariableDictionary *) {;}
     virtual void procedureExpose(RexxActivation *, RexxActivation *) {;}
+
+    // object variable access using scope slot numbers.  Variable types that
+    // don't have a slot name always use the dictionary directly.
+    virtual RexxString *getSlotName() { return OREF_NULL; }
+    virtual void exposeSlot(RexxActivation *context, VariableDictionary *dictionary, size_t slot) { expose(context, dictionary); }
+    virtual RexxObject *getSlotValue(VariableDictionary *dictionary, size_t slot) { return getValue(dictionary); }
+    virtual void setSlot(VariableDictionary *dictionary, size_t slot, RexxObject *value) { set(dictionary, value); }
 };
 
 #endif
@@ -45,6 +45,9 @@
 #include "StringClass.hpp"
 #include "RexxActivation.hpp"
 #include "ExpressionDotVariable.hpp"
+#include "PackageClass.hpp"
+#include "DirectoryClass.hpp"
+#include "ActivityManager.hpp"
 
 
 /**
@@ -80,6 +83,9 @@ RexxDotVariable::RexxDotVariable(RexxString *variable_name )
 void RexxDotVariable::live(size_t liveMark)
 {
     memory_mark(variableName);
+    memory_mark(cachedValue);
+    memory_mark(cachedPackage);
+    memory_mark(cachedLocal);
 }
 
 
@@ -92,7 +98,18 @@ void RexxDotVariable::live(size_t liveMark)
  */
 void RexxDotVariable::liveGeneral(MarkReason reason)
 {
+    // resolved values are not saved in the image
+    if (reason == PREPARINGIMAGE)
+    {
+        cachedValue = OREF_NULL;
+        cachedPackage = OREF_NULL;
+        cachedLocal = OREF_NULL;
+    }
+
     memory_mark_general(variableName);
+    memory_mark_general(cachedValue);
+    memory_mark_general(cachedPackage);
+    memory_mark_general(cachedLocal);
 }
 
 
@@ -106,6 +123,10 @@ void RexxDotVariable::flatten(Envelope * envelope)
     setUpFlatten(RexxDotVariable)
 
     flattenRef(variableName);
+    // the resolution cache is just a runtime optimization
+    newThis->cachedValue = OREF_NULL;
+    newThis->cachedPackage = OREF_NULL;
+    newThis->cachedLocal = OREF_NULL;
 
     cleanUpFlatten
 }
@@ -122,7 +143,7 @@ void RexxDotVariable::flatten(Envelope * envelope)
 RexxObject * RexxDotVariable::evaluate(RexxActivation *context, ExpressionStack *stack )
 {
     // try first from the environment
-    RexxObject *result = context->resolveDotVariable(variableName);
+    RexxObject *result = resolve(context);
     if (result == OREF_NULL)
     {
         // might be a special rexx name
@@ -153,7 +174,7 @@ RexxObject * RexxDotVariable::evaluate(RexxActivation *context, ExpressionStack
 RexxObject * RexxDotVariable::getValue(RexxActivation *context)
 {
     // try first from the environment
-    RexxObject *result = context->resolveDotVariable(variableName);
+    RexxObject *result = resolve(context);
     if (result == OREF_NULL)
     {
         // might be a special rexx name
@@ -169,3 +190,52 @@ RexxObject * RexxDotVariable::getValue(RexxActivation *context)
     return result;
 }
 
+
+
+/**
+ * Resolve the symbol through the package class tables and the
+ * environment directories, reusing the last resolution when none
+ * of the tables involved have changed since.
+ *
+ * @param context The current execution context.
+ *
+ * @return The resolved value, or OREF_NULL if the name is not found.
+ */
+RexxObject *RexxDotVariable::resolve(RexxActivation *context)
+{
+    PackageClass *package = context->getResolutionPackage();
+    DirectoryClass *local = ActivityManager::getLocal();
+
+    // a security manager needs to see every lookup
+    if (package->getSecurityManager() != OREF_NULL || local == OREF_NULL)
+    {
+        return package->findClass(variableName);
+    }
+
+    // the change counters only ever increase, so any change to one of
+    // the tables produces a different sum.
+    size_t version = PackageClass::getClassTableVersion() + local->getModifications() +
+        TheEnvironment->getModifications();
+
+    if (cachedValue != OREF_NULL && cachedVersion == version && cachedPackage == package && cachedLocal == local)
+    {
+        return cachedValue;
+    }
+
+    RexxObject *result = package->findClass(variableName);
+    // names that are not found fall through to the special variables, which
+    // depend on the activation, and directory entries backed by methods
+    // compute a new value each time, so neither can be kept.
+    if (result != OREF_NULL)
+    {
+        RexxString *internalName = variableName->upper();
+        if (!local->isComputedEntry(internalName) && !TheEnvironment->isComputedEntry(internalName))
+        {
+            setField(cachedValue, result);
+            setField(cachedPackage, package);
+            setField(cachedLocal, local);
+            cachedVersion = version;
+        }
+    }
+    return result;
+}
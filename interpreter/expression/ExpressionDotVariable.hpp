@@ -46,6 +46,9 @@
 
 #include "ExpressionBaseVariable.hpp"
 
+class PackageClass;
+class DirectoryClass;
+
 /**
  * Expression element for a "dot variable" or environment
  * symbol of the form ".name".
@@ -69,7 +72,13 @@ class RexxDotVariable : public RexxVariableBase
 
  protected:
 
-    RexxString *variableName;     // name of the environment symbol
+    RexxObject *resolve(RexxActivation *context);
+
+    RexxString     *variableName;   // name of the environment symbol
+    RexxObject     *cachedValue;    // last resolved value (runtime cache)
+    PackageClass   *cachedPackage;  // package the cached value was resolved in
+    DirectoryClass *cachedLocal;    // .local directory in effect for the resolution
+    size_t          cachedVersion;  // combined change stamp of the lookup tables
 
 };
 #endif
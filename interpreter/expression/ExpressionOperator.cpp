@@ -44,6 +44,8 @@
 #include "RexxCore.h"
 #include "RexxActivation.hpp"
 #include "ExpressionOperator.hpp"
+#include "IntegerClass.hpp"
+#include "NumberStringClass.hpp"
 
 // Table for transforming an operator back into its
 // string name.  These strings must match the operator subclass
@@ -136,6 +138,7 @@ void RexxExpressionOperator::live(size_t liveMark)
 {
     memory_mark(left_term);
     memory_mark(right_term);
+    memory_mark(constantValue);
 }
 
 /**
@@ -149,6 +152,7 @@ void RexxExpressionOperator::liveGeneral(MarkReason reason)
 {
   memory_mark_general(left_term);
   memory_mark_general(right_term);
+  memory_mark_general(constantValue);
 }
 
 
@@ -163,11 +167,331 @@ void RexxExpressionOperator::flatten(Envelope *envelope)
 
    flattenRef(left_term);
    flattenRef(right_term);
+   flattenRef(constantValue);
 
    cleanUpFlatten
 }
 
 
+/**
+ * Test if the constant folded for this operator at translation
+ * time can be used as the result of an evaluation.  Tracing
+ * intermediates requires the full evaluation, and a constant
+ * that depends on the numeric settings is only good for the
+ * settings it was folded with.
+ *
+ * @param context The current execution context.
+ *
+ * @return true if the constant value is the operation result.
+ */
+inline bool RexxExpressionOperator::constantApplies(RexxActivation *context)
+{
+    if (constantValue == OREF_NULL || context->tracingIntermediates())
+    {
+        return false;
+    }
+    return !numericConstant || (Numerics::digits() == constantDigits &&
+        Numerics::fuzz() == constantFuzz && Numerics::form() == constantForm);
+}
+
+
+/**
+ * Record the folded result of this operation along with the
+ * numeric settings in effect when it was calculated.
+ *
+ * @param value   The constant result.
+ * @param numeric true if the result depends on the numeric settings.
+ */
+void RexxExpressionOperator::setConstant(RexxObject *value, bool numeric)
+{
+    setField(constantValue, value);
+    numericConstant = numeric;
+    constantDigits = Numerics::digits();
+    constantFuzz = Numerics::fuzz();
+    constantForm = Numerics::form();
+}
+
+
+/**
+ * Get the constant value of an expression term, if it has
+ * one.  Literal strings and integers are used directly as
+ * terms, and operators may have been folded already.
+ *
+ * @param term    The expression term.
+ * @param numeric Set to true if the term's value depends on the
+ *                numeric settings.
+ *
+ * @return The constant value, or OREF_NULL if the term is not a
+ *         constant.
+ */
+RexxObject *RexxExpressionOperator::constantTerm(RexxInternalObject *term, bool &numeric)
+{
+    if (isString(term) || isInteger(term))
+    {
+        return (RexxObject *)term;
+    }
+    if (isOfClass(BinaryOperatorTerm, term) || isOfClass(UnaryOperatorTerm, term))
+    {
+        RexxExpressionOperator *op = (RexxExpressionOperator *)term;
+        if (op->isConstant())
+        {
+            numeric = numeric || op->numericConstant;
+            return op->constantValue;
+        }
+    }
+    return OREF_NULL;
+}
+
+
+/**
+ * Test if an operator's result depends on the numeric
+ * settings.  This is all of the arithmetic operators and the
+ * non-strict comparisons.
+ *
+ * @param op     The operator.
+ *
+ * @return true if the NUMERIC settings can change the result.
+ */
+bool RexxExpressionOperator::isNumericOperator(TokenSubclass op)
+{
+    switch (op)
+    {
+        case OPERATOR_PLUS:
+        case OPERATOR_SUBTRACT:
+        case OPERATOR_MULTIPLY:
+        case OPERATOR_DIVIDE:
+        case OPERATOR_INTDIV:
+        case OPERATOR_REMAINDER:
+        case OPERATOR_POWER:
+        case OPERATOR_EQUAL:
+        case OPERATOR_BACKSLASH_EQUAL:
+        case OPERATOR_GREATERTHAN:
+        case OPERATOR_BACKSLASH_GREATERTHAN:
+        case OPERATOR_LESSTHAN:
+        case OPERATOR_BACKSLASH_LESSTHAN:
+        case OPERATOR_GREATERTHAN_EQUAL:
+        case OPERATOR_LESSTHAN_EQUAL:
+        case OPERATOR_LESSTHAN_GREATERTHAN:
+        case OPERATOR_GREATERTHAN_LESSTHAN:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+
+/**
+ * Test if a constant is a number we can use in a folded
+ * operation without any risk of an exponent overflow.  Integer
+ * literals always qualify, other values must be short numbers
+ * written without an exponent.
+ *
+ * @param value  The constant value.
+ *
+ * @return true if this is a number safe for folding.
+ */
+bool RexxExpressionOperator::isSimpleNumber(RexxObject *value)
+{
+    if (isInteger(value))
+    {
+        return true;
+    }
+    if (value->numberString() == OREF_NULL)
+    {
+        return false;
+    }
+    RexxString *string = value->stringValue();
+    size_t length = string->getLength();
+    const char *data = string->getStringData();
+    return length <= MaxFoldedNumberLength && memchr(data, 'E', length) == NULL && memchr(data, 'e', length) == NULL;
+}
+
+
+/**
+ * Test if a constant is a valid logical value.
+ *
+ * @param value  The constant value.
+ *
+ * @return true if this is exactly '0' or '1'.
+ */
+bool RexxExpressionOperator::isLogical(RexxObject *value)
+{
+    logical_t result;
+    return value->logicalValue(result);
+}
+
+
+/**
+ * Convert a literal operand to its numeric form ahead of time
+ * so the conversion is not part of the first evaluation.  The
+ * string caches the result (or the fact it is not a number).
+ *
+ * @param term   The operand term.
+ */
+void RexxExpressionOperator::convertLiteral(RexxInternalObject *term)
+{
+    if (isString(term))
+    {
+        ((RexxString *)term)->numberString();
+    }
+}
+
+
+/**
+ * Optimize a binary operator after the package has been
+ * translated.  Numeric literal operands are converted to number
+ * form, and an operation on constant terms that cannot raise an
+ * error is folded into a constant result.  The current numeric
+ * settings are those of the package.
+ */
+void RexxBinaryOperator::optimize()
+{
+    bool numeric = isNumericOperator(oper);
+    if (numeric)
+    {
+        convertLiteral(left_term);
+        convertLiteral(right_term);
+    }
+
+    RexxObject *left = constantTerm(left_term, numeric);
+    RexxObject *right = constantTerm(right_term, numeric);
+    if (left == OREF_NULL || right == OREF_NULL)
+    {
+        return;
+    }
+
+    switch (oper)
+    {
+        // concatenations and strict comparisons always work
+        case OPERATOR_ABUTTAL:
+        case OPERATOR_CONCATENATE:
+        case OPERATOR_BLANK:
+        case OPERATOR_STRICT_EQUAL:
+        case OPERATOR_STRICT_BACKSLASH_EQUAL:
+        case OPERATOR_STRICT_GREATERTHAN:
+        case OPERATOR_STRICT_BACKSLASH_GREATERTHAN:
+        case OPERATOR_STRICT_LESSTHAN:
+        case OPERATOR_STRICT_BACKSLASH_LESSTHAN:
+        case OPERATOR_STRICT_GREATERTHAN_EQUAL:
+        case OPERATOR_STRICT_LESSTHAN_EQUAL:
+            break;
+
+        // a numeric comparison subtracts the values, so both numbers need to
+        // be safe.  String comparisons always work.
+        case OPERATOR_EQUAL:
+        case OPERATOR_BACKSLASH_EQUAL:
+        case OPERATOR_GREATERTHAN:
+        case OPERATOR_BACKSLASH_GREATERTHAN:
+        case OPERATOR_LESSTHAN:
+        case OPERATOR_BACKSLASH_LESSTHAN:
+        case OPERATOR_GREATERTHAN_EQUAL:
+        case OPERATOR_LESSTHAN_EQUAL:
+        case OPERATOR_LESSTHAN_GREATERTHAN:
+        case OPERATOR_GREATERTHAN_LESSTHAN:
+            if (left->numberString() != OREF_NULL && right->numberString() != OREF_NULL &&
+                (!isSimpleNumber(left) || !isSimpleNumber(right)))
+            {
+                return;
+            }
+            break;
+
+        case OPERATOR_PLUS:
+        case OPERATOR_SUBTRACT:
+        case OPERATOR_MULTIPLY:
+            if (!isSimpleNumber(left) || !isSimpleNumber(right))
+            {
+                return;
+            }
+            break;
+
+        case OPERATOR_DIVIDE:
+            if (!isSimpleNumber(left) || !isSimpleNumber(right) || right->numberString()->isZero())
+            {
+                return;
+            }
+            break;
+
+        // integer division fails if the quotient needs more digits than
+        // we have, so we only fold integer literals, which are within the
+        // default digits.
+        case OPERATOR_INTDIV:
+        case OPERATOR_REMAINDER:
+            if (!isInteger(left) || !isInteger(right) || ((RexxInteger *)right)->getValue() == 0 ||
+                Numerics::digits() < Numerics::DEFAULT_DIGITS)
+            {
+                return;
+            }
+            break;
+
+        case OPERATOR_POWER:
+            if (!isSimpleNumber(left) || !isInteger(right) || ((RexxInteger *)right)->getValue() < 0 ||
+                ((RexxInteger *)right)->getValue() > MaxFoldedPower)
+            {
+                return;
+            }
+            break;
+
+        case OPERATOR_AND:
+        case OPERATOR_OR:
+        case OPERATOR_XOR:
+            if (!isLogical(left) || !isLogical(right))
+            {
+                return;
+            }
+            break;
+
+        default:
+            return;
+    }
+
+    setConstant(left->callOperatorMethod(oper, right), numeric);
+}
+
+
+/**
+ * Check if this operation adds an integer literal to (or
+ * subtracts one from) a given variable, the "x = x + 1" idiom.
+ *
+ * @param target The assignment target variable.
+ * @param op     Returns the operator.
+ *
+ * @return The integer amount, or OREF_NULL if this is not an
+ *         increment of the target.
+ */
+RexxObject *RexxBinaryOperator::incrementAmount(RexxInternalObject *target, TokenSubclass &op)
+{
+    if ((oper == OPERATOR_PLUS || oper == OPERATOR_SUBTRACT) && left_term == target && isInteger(right_term))
+    {
+        op = oper;
+        return (RexxObject *)right_term;
+    }
+    return OREF_NULL;
+}
+
+
+/**
+ * Optimize a unary operator after the package has been
+ * translated, folding the prefix operation on a constant term.
+ */
+void RexxUnaryOperator::optimize()
+{
+    bool numeric = oper != OPERATOR_BACKSLASH;
+    if (numeric)
+    {
+        convertLiteral(left_term);
+    }
+
+    RexxObject *term = constantTerm(left_term, numeric);
+    if (term == OREF_NULL || (numeric ? !isSimpleNumber(term) : !isLogical(term)))
+    {
+        return;
+    }
+
+    setConstant(term->callOperatorMethod(oper, OREF_NULL), numeric);
+}
+
+
 /**
  * Evaluate an operator expression term
  *
@@ -178,6 +502,12 @@ void RexxExpressionOperator::flatten(Envelope *envelope)
  */
 RexxObject *RexxBinaryOperator::evaluate(RexxActivation *context, ExpressionStack *stack )
 {
+    // folded at translation time?
+    if (constantApplies(context))
+    {
+        stack->push(constantValue);
+        return constantValue;
+    }
     // evaluate both expression terms
     RexxObject *left = left_term->evaluate(context, stack);
     RexxObject *right = right_term->evaluate(context, stack);
@@ -202,6 +532,12 @@ RexxObject *RexxBinaryOperator::evaluate(RexxActivation *context, ExpressionStac
  */
 RexxObject *RexxUnaryOperator::evaluate(RexxActivation *context, ExpressionStack *stack )
 {
+    // folded at translation time?
+    if (constantApplies(context))
+    {
+        stack->push(constantValue);
+        return constantValue;
+    }
     // we only have a single term to evaluate
     RexxObject *term = left_term->evaluate(context, stack);
     // and forward to the operator type
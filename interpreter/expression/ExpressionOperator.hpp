@@ -58,14 +58,35 @@ class RexxExpressionOperator : public RexxInternalObject
     virtual void   flatten(Envelope *);
 
     inline const char *operatorName() { return operatorNames[oper]; }
+    inline bool        isConstant() { return constantValue != OREF_NULL; }
+
+    static RexxObject *constantTerm(RexxInternalObject *term, bool &numeric);
 
 protected:
     // table of operator names
     static const char *operatorNames[];
 
+    inline bool constantApplies(RexxActivation *);
+           void setConstant(RexxObject *value, bool numeric);
+
+    // the longest number we'll fold (arithmetic on these can't overflow the exponent)
+    static const size_t MaxFoldedNumberLength = 64;
+    // the largest power we'll fold
+    static const wholenumber_t MaxFoldedPower = 999;
+
+    static bool isNumericOperator(TokenSubclass op);
+    static bool isSimpleNumber(RexxObject *value);
+    static bool isLogical(RexxObject *value);
+    static void convertLiteral(RexxInternalObject *term);
+
     TokenSubclass  oper;                 // operation to perform
     RexxInternalObject *right_term;      // right term of the operator
     RexxInternalObject *left_term;       // left term of the operator
+    RexxObject    *constantValue;        // result folded at translation time
+    wholenumber_t  constantDigits;       // numeric settings used to fold the constant
+    wholenumber_t  constantFuzz;
+    bool           constantForm;
+    bool           numericConstant;      // the folded result depends on the numeric settings
 };
 
 class RexxBinaryOperator : public RexxExpressionOperator
@@ -79,6 +100,9 @@ class RexxBinaryOperator : public RexxExpressionOperator
     inline RexxBinaryOperator(RESTORETYPE restoreType) { ; };
 
     virtual RexxObject *evaluate(RexxActivation *, ExpressionStack *);
+
+    void optimize();
+    RexxObject *incrementAmount(RexxInternalObject *target, TokenSubclass &op);
 };
 
 
@@ -92,5 +116,7 @@ class RexxUnaryOperator : public RexxExpressionOperator {
     inline RexxUnaryOperator(RESTORETYPE restoreType) { ; };
 
     virtual RexxObject *evaluate(RexxActivation *, ExpressionStack *);
+
+    void optimize();
 };
 #endif
@@ -319,6 +319,20 @@ void RexxStemVariable::expose(RexxActivation *context, VariableDictionary *objec
 }
 
 
+/**
+ * Expose a stem variable using its scope slot number.
+ *
+ * @param context The current execution context.
+ * @param object_dictionary
+ *                The source object scope variable dictionary.
+ * @param slot    The slot number assigned to the stem by the scope.
+ */
+void RexxStemVariable::exposeSlot(RexxActivation *context, VariableDictionary *object_dictionary, size_t slot)
+{
+    context->putLocalVariable(object_dictionary->getSlotStemVariable(slot, stemName), stemIndex);
+}
+
+
 /**
  * Set a GUARD WHEN watch on a stem variable.
  *
@@ -82,6 +82,8 @@ class RexxStemVariable : public RexxVariableBase
     virtual void clearGuard(RexxActivation *);
     virtual void expose(RexxActivation *, VariableDictionary *);
     virtual void procedureExpose(RexxActivation *, RexxActivation *);
+    virtual RexxString *getSlotName() { return stemName; }
+    virtual void exposeSlot(RexxActivation *, VariableDictionary *, size_t);
 
     // class-specific methods
     bool sort(RexxActivation *context, RexxString *prefix, int order, int type, size_t start, size_t end, size_t firstcol, size_t lastcol);
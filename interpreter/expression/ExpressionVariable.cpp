@@ -143,6 +143,30 @@ RexxObject *RexxSimpleVariable::evaluate(RexxActivation *context, ExpressionStac
 }
 
 
+/**
+ * Apply an increment operation directly to the variable's
+ * value for an "x = x + n" assignment.
+ *
+ * @param context The current execution context.
+ * @param op      The operator to apply (plus or minus).
+ * @param amount  The increment amount.
+ *
+ * @return false if the variable has no value, which needs the
+ *         full evaluation path.
+ */
+bool RexxSimpleVariable::increment(RexxActivation *context, TokenSubclass op, RexxObject *amount)
+{
+    RexxVariable *variable = context->getLocalVariable(variableName, index);
+    RexxObject *value = variable->getVariableValue();
+    if (value == OREF_NULL)
+    {
+        return false;
+    }
+    variable->set(value->callOperatorMethod(op, amount));
+    return true;
+}
+
+
 /**
  * retrieve a simple variable's value (notready condition will
  * not be raised)
@@ -349,6 +373,54 @@ void RexxSimpleVariable::expose(RexxActivation *context, VariableDictionary *obj
 }
 
 
+/**
+ * Expose a simple object variable using its scope slot number.
+ *
+ * @param context The current execution context.
+ * @param object_dictionary
+ *                The target variable dictionary from the method scope.
+ * @param slot    The slot number assigned to the variable by the scope.
+ */
+void RexxSimpleVariable::exposeSlot(RexxActivation *context, VariableDictionary *object_dictionary, size_t slot)
+{
+    context->putLocalVariable(object_dictionary->getSlotVariable(slot, variableName), index);
+}
+
+
+/**
+ * Retrieve an object variable value using its scope slot
+ * number.
+ *
+ * @param dictionary The source variable dictionary.
+ * @param slot       The slot number assigned to the variable.
+ *
+ * @return The variable value.
+ */
+RexxObject *RexxSimpleVariable::getSlotValue(VariableDictionary *dictionary, size_t slot)
+{
+    RexxObject *value = dictionary->getSlotVariable(slot, variableName)->getVariableValue();
+    // if no variable yet, return the name.
+    if (value == OREF_NULL)
+    {
+        value = variableName;
+    }
+    return value;
+}
+
+
+/**
+ * Set an object variable using its scope slot number.
+ *
+ * @param dictionary The target variable dictionary.
+ * @param slot       The slot number assigned to the variable.
+ * @param value      The new value.
+ */
+void RexxSimpleVariable::setSlot(VariableDictionary *dictionary, size_t slot, RexxObject *value)
+{
+    dictionary->getSlotVariable(slot, variableName)->set(value);
+}
+
+
 /**
  * Return the name of this variable.
  *
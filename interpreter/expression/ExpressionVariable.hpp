@@ -45,6 +45,7 @@
 #define Included_RexxSimpleVariable
 
 #include "ExpressionBaseVariable.hpp"
+#include "Token.hpp"
 
 class RexxSimpleVariable : public RexxVariableBase
 {
@@ -77,8 +78,13 @@ class RexxSimpleVariable : public RexxVariableBase
     virtual void clearGuard(RexxActivation *);
     virtual void expose(RexxActivation *, VariableDictionary *);
     virtual void procedureExpose(RexxActivation *, RexxActivation *);
+    virtual RexxString *getSlotName() { return variableName; }
+    virtual void exposeSlot(RexxActivation *, VariableDictionary *, size_t);
+    virtual RexxObject *getSlotValue(VariableDictionary *, size_t);
+    virtual void setSlot(VariableDictionary *, size_t, RexxObject *);
 
     RexxString *getName();
+    bool increment(RexxActivation *, TokenSubclass, RexxObject *);
 
 protected:
 
@@ -47,6 +47,11 @@
 #include "AddressInstruction.hpp"
 #include "SystemInterpreter.hpp"
 #include "MethodArguments.hpp"
+#include "CommandHandler.hpp"
+#include "ExpressionBaseVariable.hpp"
+#include "StemClass.hpp"
+#include "ArrayClass.hpp"
+#include "MutableBufferClass.hpp"
 
 /**
  * Constructor for an Address instruction object.
@@ -56,14 +61,19 @@
  * @param _environment
  *                 A static environment name.
  * @param _command A command expression to be issued.
+ * @param _output  An optional variable receiving the command output.
+ * @param _error   An optional variable receiving the command error output.
  */
 RexxInstructionAddress::RexxInstructionAddress(RexxInternalObject *_expression,
-    RexxString *_environment, RexxInternalObject *_command)
+    RexxString *_environment, RexxInternalObject *_command,
+    RexxVariableBase *_output, RexxVariableBase *_error)
 {
 
     dynamicAddress = _expression;
     environment = _environment;
     command = _command;
+    outputTarget = _output;
+    errorTarget = _error;
 }
 
 
@@ -79,6 +89,8 @@ void RexxInstructionAddress::live(size_t liveMark)
     memory_mark(dynamicAddress);
     memory_mark(environment);
     memory_mark(command);
+    memory_mark(outputTarget);
+    memory_mark(errorTarget);
 }
 
 
@@ -96,6 +108,8 @@ void RexxInstructionAddress::liveGeneral(MarkReason reason)
     memory_mark_general(dynamicAddress);
     memory_mark_general(environment);
     memory_mark_general(command);
+    memory_mark_general(outputTarget);
+    memory_mark_general(errorTarget);
 }
 
 
@@ -114,6 +128,8 @@ void RexxInstructionAddress::flatten(Envelope *envelope)
     flattenRef(dynamicAddress);
     flattenRef(environment);
     flattenRef(command);
+    flattenRef(outputTarget);
+    flattenRef(errorTarget);
 
     cleanUpFlatten
 }
@@ -151,8 +167,26 @@ void RexxInstructionAddress::execute(RexxActivation *context, ExpressionStack *s
             context->traceResult(_command);
             // validate the address name using system rules
             SystemInterpreter::validateAddressName(environment);
-            // and execute the command
-            context->command(environment, _command);
+            // if we're capturing output, run the command with capture buffers
+            // and hand the results to the target variables afterward.
+            if (outputTarget != OREF_NULL || errorTarget != OREF_NULL)
+            {
+                CommandIOCapture capture(outputTarget != OREF_NULL, errorTarget != OREF_NULL);
+                context->command(environment, _command, &capture);
+                if (outputTarget != OREF_NULL)
+                {
+                    storeCapture(context, outputTarget, capture.output);
+                }
+                if (errorTarget != OREF_NULL)
+                {
+                    storeCapture(context, errorTarget, capture.error);
+                }
+            }
+            else
+            {
+                // and execute the command
+                context->command(environment, _command);
+            }
         }
         // we're just changing the current address target
         else
@@ -180,3 +214,68 @@ void RexxInstructionAddress::execute(RexxActivation *context, ExpressionStack *s
     }
 }
 
+
+
+/**
+ * Store captured command output in a WITH OUTPUT or WITH ERROR
+ * target variable.  A stem target receives one line per tail
+ * with the count in stem.0, an Array or MutableBuffer value
+ * has its contents replaced, and any other variable is
+ * assigned a new array of lines.
+ *
+ * @param context The current execution context.
+ * @param target  The target variable.
+ * @param buffer  The captured data.
+ */
+void RexxInstructionAddress::storeCapture(RexxActivation *context, RexxVariableBase *target, CommandCaptureBuffer &buffer)
+{
+    RexxObject *current = target->getRealValue(context);
+
+    // a buffer gets the raw data, with no line splitting
+    if (current != OREF_NULL && isOfClass(MutableBuffer, current))
+    {
+        MutableBuffer *mutableBuffer = (MutableBuffer *)current;
+        mutableBuffer->setDataLength(0);
+        mutableBuffer->append(buffer.data, buffer.length);
+        return;
+    }
+
+    // everything else is line oriented
+    Protected<ArrayClass> lines = new_array();
+    const char *scan = buffer.data;
+    const char *end = scan + buffer.length;
+    while (scan < end)
+    {
+        const char *lineEnd = (const char *)memchr(scan, '\n', end - scan);
+        const char *next = lineEnd == NULL ? end : lineEnd + 1;
+        if (lineEnd == NULL)
+        {
+            lineEnd = end;
+        }
+        // tolerate CRLF line ends
+        if (lineEnd > scan && *(lineEnd - 1) == '\r')
+        {
+            lineEnd--;
+        }
+        lines->append(new_string(scan, lineEnd - scan));
+        scan = next;
+    }
+
+    if (current != OREF_NULL && isStem(current))
+    {
+        StemClass *stem = (StemClass *)current;
+        stem->empty();
+        stem->setArrayElements(1, lines->messageArgs(), lines->items());
+        stem->setElement((size_t)0, new_integer(lines->items()));
+    }
+    else if (current != OREF_NULL && isArray(current))
+    {
+        ArrayClass *array = (ArrayClass *)current;
+        array->empty();
+        array->appendAll(lines);
+    }
+    else
+    {
+        target->assign(context, lines);
+    }
+}
@@ -46,12 +46,15 @@
 
 #include "RexxInstruction.hpp"
 
+class RexxVariableBase;
+class CommandCaptureBuffer;
+
 class RexxInstructionAddress : public RexxInstruction
 {
  public:
     inline void operator delete(void *) { }
 
-    RexxInstructionAddress(RexxInternalObject *, RexxString *, RexxInternalObject *);
+    RexxInstructionAddress(RexxInternalObject *, RexxString *, RexxInternalObject *, RexxVariableBase *, RexxVariableBase *);
     inline RexxInstructionAddress(RESTORETYPE restoreType) { ; };
 
     virtual void live(size_t);
@@ -60,8 +63,12 @@ class RexxInstructionAddress : public RexxInstruction
 
     virtual void execute(RexxActivation *, ExpressionStack *);
 
+    void storeCapture(RexxActivation *, RexxVariableBase *, CommandCaptureBuffer &);
+
     RexxInternalObject *dynamicAddress;      // ADDRESS VALUE expression
     RexxString *environment;                 // An environment string (static form)
     RexxInternalObject *command;             // A command expression
+    RexxVariableBase *outputTarget;          // WITH OUTPUT capture variable
+    RexxVariableBase *errorTarget;           // WITH ERROR capture variable
 };
 #endif
@@ -43,6 +43,8 @@
 /******************************************************************************/
 #include "RexxCore.h"
 #include "ExpressionBaseVariable.hpp"
+#include "ExpressionVariable.hpp"
+#include "ExpressionOperator.hpp"
 #include "RexxActivation.hpp"
 #include "AssignmentInstruction.hpp"
 
@@ -63,6 +65,7 @@ void RexxInstructionAssignment::live(size_t liveMark)
     memory_mark(nextInstruction);
     memory_mark(variable);
     memory_mark(expression);
+    memory_mark(increment);
 }
 
 
@@ -79,6 +82,7 @@ void RexxInstructionAssignment::liveGeneral(MarkReason reason)
     memory_mark_general(nextInstruction);
     memory_mark_general(variable);
     memory_mark_general(expression);
+    memory_mark_general(increment);
 }
 
 
@@ -94,10 +98,26 @@ void RexxInstructionAssignment::flatten(Envelope *envelope)
     flattenRef(nextInstruction);
     flattenRef(variable);
     flattenRef(expression);
+    flattenRef(increment);
 
     cleanUpFlatten
 }
 
+/**
+ * Optimize an assignment after the package has been translated.
+ * An assignment of the form "x = x + n" (or "x += n") with an
+ * integer literal n is turned into an increment of the variable.
+ */
+void RexxInstructionAssignment::optimize()
+{
+    if (isOfClass(VariableTerm, variable) && isOfClass(BinaryOperatorTerm, expression))
+    {
+        RexxObject *amount = ((RexxBinaryOperator *)expression)->incrementAmount(variable, incrementOperator);
+        setField(increment, amount);
+    }
+}
+
+
 /**
  * Execute a REXX assignment instruction
  * NOTE:  This instruction is implemented using two seperate paths
@@ -123,6 +143,12 @@ void RexxInstructionAssignment::execute(RexxActivation *context, ExpressionStack
         // do debug pause
         context->pauseInstruction();
     }
+    // an increment only needs a single variable lookup.  An unassigned
+    // variable goes through the full evaluation for the NOVALUE handling.
+    else if (increment != OREF_NULL && ((RexxSimpleVariable *)variable)->increment(context, incrementOperator, increment))
+    {
+        return;
+    }
     // fast path for non-traced execution
     else
     {
@@ -58,9 +58,13 @@ class RexxInstructionAssignment : public RexxInstruction
 
     virtual void execute(RexxActivation *, ExpressionStack *);
 
+    void optimize();
+
  protected:
 
     RexxInternalObject *expression;      // assignment expression
     RexxVariableBase *variable;          // assignment target
+    RexxObject       *increment;         // amount for an "x = x + n" increment
+    TokenSubclass     incrementOperator; // plus or minus for an increment
 };
 #endif
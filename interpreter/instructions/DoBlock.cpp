@@ -45,6 +45,7 @@
 #include "DoInstruction.hpp"
 #include "DoBlock.hpp"
 #include "RexxActivation.hpp"
+#include "ListContents.hpp"
 
 
 
@@ -107,6 +108,20 @@ void DoBlock::liveGeneral(MarkReason reason)
 
 
 
+/**
+ * Set up a DO OVER loop over the contents of a list.
+ *
+ * @param contents The list contents, which the list leaves unchanged
+ *                 for us.
+ */
+void DoBlock::setOverList(ListContents *contents)
+{
+    to = (RexxObject *)contents;
+    by = OREF_NULL;
+    overIndex = contents->firstIndex();
+}
+
+
 /**
  * Process an interation of a DO OVER loop.
  *
@@ -118,31 +133,83 @@ void DoBlock::liveGeneral(MarkReason reason)
  */
 bool DoBlock::checkOver(RexxActivation *context, ExpressionStack *stack)
 {
-    // the array was stored in the too field
-    ArrayClass *overArray = (ArrayClass *)to;
-    // are we past the end of the array?
-    if (overArray->lastIndex() < overIndex)
+    RexxObject *result;
+
+    // iterating over a list?  The index is a link to the next item.
+    if (isOfClass(ListContents, to))
     {
-        return false;                    // time to get out of here.
+        ListContents *overList = (ListContents *)to;
+        if (overIndex == ListContents::NoMore)
+        {
+            return false;
+        }
+        result = (RexxObject *)overList->get(overIndex);
+        overIndex = overList->nextIndex(overIndex);
     }
+    // an array iterated in place.  Empty slots are skipped, which gives the
+    // same items as iterating over makeArray() would.
+    else if (by != OREF_NULL)
+    {
+        ArrayClass *overArray = (ArrayClass *)to;
+        // if the array has been changed since the loop started, the
+        // snapshot token holds the original items.
+        if (!overArray->isIterationSnapshot((ArrayClass *)by))
+        {
+            overArray = (ArrayClass *)by;
+        }
 
-    // get the next element  from the array. This should be a
-    // non-sparse array, but we need to double check anyway.
-    RexxObject *result = (RexxObject *)overArray->get(overIndex);
-    // use .nil for any empty slots
-    if (result == OREF_NULL)
+        size_t last = overArray->lastIndex();
+        while (overIndex <= last && overArray->get(overIndex) == OREF_NULL)
+        {
+            overIndex++;
+        }
+        if (overIndex > last)
+        {
+            return false;
+        }
+        result = (RexxObject *)overArray->get(overIndex);
+        overIndex++;
+    }
+    else
     {
-        result = TheNilObject;           /* use .nil instead                  */
+        // the array was stored in the too field
+        ArrayClass *overArray = (ArrayClass *)to;
+        // are we past the end of the array?
+        if (overArray->lastIndex() < overIndex)
+        {
+            return false;                    // time to get out of here.
+        }
+
+        // get the next element  from the array. This should be a
+        // non-sparse array, but we need to double check anyway.
+        result = (RexxObject *)overArray->get(overIndex);
+        // use .nil for any empty slots
+        if (result == OREF_NULL)
+        {
+            result = TheNilObject;           /* use .nil instead                  */
+        }
+        overIndex++;
     }
 
     // assign the control variable and trace this result
     control->assign(context, result);
     context->traceResult(result);
-    overIndex++;
     return true;
 }
 
 
+/**
+ * Hand the snapshot token of a DO OVER loop back to the array
+ * when the loop ends.  Once no loops are using the token, later
+ * changes to the array no longer need to copy its items.
+ */
+void DoBlock::releaseOverArray()
+{
+    ((ArrayClass *)to)->releaseIterationSnapshot((ArrayClass *)by);
+    holdsSnapshot = false;
+}
+
+
 /**
  * Perform control variable checks on a DO/LOOP iteration.
  *
@@ -48,6 +48,7 @@
 #include "Token.hpp"
 
 class RexxBlockInstruction;
+class ListContents;
 class RexxVariableBase;
 
 /**
@@ -75,6 +76,8 @@ class DoBlock : public RexxInternalObject
     inline void setBy(RexxObject * value) {by = value;};
     inline void setFor(size_t value) {forCount = value;};
     inline void setOverIndex(size_t value) {overIndex = value;};
+    inline void setOverArray(ArrayClass *a, ArrayClass *snapshot) { to = a; by = snapshot; overIndex = 1; holdsSnapshot = true; }
+           void setOverList(ListContents *contents);
     inline void setCase(RexxObject * value) {to = value;};
     inline void setSupplier(RexxObject * value) {to = value;};
     inline void setCompare(TokenSubclass value) { compare = value;};
@@ -84,6 +87,8 @@ class DoBlock : public RexxInternalObject
     inline bool checkFor() { return (forCount--) > 0; };
            bool checkControl(RexxActivation *context, ExpressionStack *stack, bool increment);
            bool checkOver(RexxActivation *context, ExpressionStack *stack);
+    inline void endBlock() { if (holdsSnapshot) releaseOverArray(); }
+           void releaseOverArray();
 
 
 protected:
@@ -97,9 +102,10 @@ protected:
     // operations.
     RexxVariableBase  *control;          // control variable for controlled loop
     RexxObject        *to;               // final target TO value
-    RexxObject        *by;               // control increment value
+    RexxObject        *by;               // control increment value (snapshot token for DO OVER)
     size_t             overIndex;        // index position for a DO OVER
     size_t             forCount;         // number of iterations
     TokenSubclass      compare;          // type of comparison
+    bool               holdsSnapshot;    // DO OVER of an array holding a snapshot token
 };
 #endif
@@ -47,6 +47,7 @@
 #include "RexxActivation.hpp"
 #include "MethodArguments.hpp"
 #include "SupplierClass.hpp"
+#include "ListClass.hpp"
 #include "NumberStringClass.hpp"
 
 /**
@@ -224,30 +225,37 @@ void OverLoop::setup( RexxActivation *context,
     doblock->setTo(result);
 
     context->traceResult(result);
-    // if this is already an array item, request the non-sparse version
 
-    ArrayClass *array;
-    if (isArray(result))
+    // arrays and queues are iterated in place.  The array gives us a
+    // snapshot token that only gets filled in if the array is changed
+    // while we're iterating.
+    if (isArray(result) || isOfClass(Queue, result))
     {
-        array = ((ArrayClass *)result)->makeArray();
+        ArrayClass *array = (ArrayClass *)result;
+        doblock->setOverArray(array, array->getIterationSnapshot());
+    }
+    // lists hand us their current contents, which they will not
+    // change while we're using them.
+    else if (isOfClass(List, result))
+    {
+        doblock->setOverList(((ListClass *)result)->getIterationContents());
     }
     else
     {
         // some other type of collection, use the less direct means
         // of requesting an array
-        array = result->requestArray();
+        ArrayClass *array = result->requestArray();
         // raise an error if this did not convert ok, or we got
         // back something other than a real Rexx array.
         if (!isArray(array))
         {
             reportException(Error_Execution_noarray, result);
         }
+        // we use the TO field to store the array, and the for
+        // counter is our index position.
+        doblock->setOverArray(array, OREF_NULL);
     }
 
-    // we use the TO field to store the array, and the for
-    // counter is our index position.
-    doblock->setTo(array);
-    doblock->setOverIndex(1);
     // and don't forget the variable (which of course, I DID forget!)
     doblock->setControl(control);
 }
@@ -46,6 +46,8 @@
 #include "QueueClass.hpp"
 #include "ExposeInstruction.hpp"
 #include "ExpressionBaseVariable.hpp"
+#include "NumberArray.hpp"
+#include "ProtectedObject.hpp"
 
 /**
  * Complete construction of an EXPOSE instruction.
@@ -73,6 +75,8 @@ void RexxInstructionExpose::live(size_t liveMark)
     // must be first one marked
     memory_mark(nextInstruction);
     memory_mark_array(variableCount, variables);
+    memory_mark(slotScope);
+    memory_mark(variableSlots);
 }
 
 
@@ -85,9 +89,18 @@ void RexxInstructionExpose::live(size_t liveMark)
  */
 void RexxInstructionExpose::liveGeneral(MarkReason reason)
 {
+    // the slot numbers are discarded with the scope assignments
+    if (reason == PREPARINGIMAGE)
+    {
+        slotScope = OREF_NULL;
+        variableSlots = OREF_NULL;
+    }
+
     // must be first one marked
     memory_mark_general(nextInstruction);
     memory_mark_general_array(variableCount, variables);
+    memory_mark_general(slotScope);
+    memory_mark_general(variableSlots);
 }
 
 
@@ -102,6 +115,9 @@ void RexxInstructionExpose::flatten(Envelope *envelope)
 
     flattenRef(nextInstruction);
     flattenArrayRefs(variableCount, variables);
+    // slot numbers are only meaningful in this process
+    newThis->slotScope = OREF_NULL;
+    newThis->variableSlots = OREF_NULL;
 
     cleanUpFlatten
 }
@@ -125,9 +141,47 @@ void RexxInstructionExpose::execute(RexxActivation *context, ExpressionStack *st
     }
 
     // the context processeses these
-    context->expose(variables, variableCount);
+    context->expose(variables, variableCount, getVariableSlots(context->getScope()));
 
     // and standare debug pause.
     context->pauseInstruction();
 }
 
+
+/**
+ * Get the slot numbers for the exposed variables in a given
+ * method scope.  These are assigned by the scope class the first
+ * time a scope executes this instruction.
+ *
+ * @param scope  The scope of the executing method.
+ *
+ * @return The slot numbers for the variables, or OREF_NULL if the
+ *         variables must be exposed by name.
+ */
+NumberArray *RexxInstructionExpose::getVariableSlots(RexxClass *scope)
+{
+    // methods not defined by a class have no slot assignments.  Note that
+    // the scope of a method added to a single object is the object itself.
+    if (scope == OREF_NULL || !isOfClassType(Class, scope))
+    {
+        return OREF_NULL;
+    }
+
+    // the same code can be shared by methods in different scopes, so
+    // we recalculate if this is not the scope we used last time.
+    if (scope != slotScope)
+    {
+        Protected<NumberArray> slots = new (variableCount) NumberArray(variableCount);
+        for (size_t i = 0; i < variableCount; i++)
+        {
+            RexxString *name = variables[i]->getSlotName();
+            if (name != OREF_NULL)
+            {
+                slots->put(scope->getVariableSlot(name), i + 1);
+            }
+        }
+        setField(variableSlots, (NumberArray *)slots);
+        setField(slotScope, scope);
+    }
+    return variableSlots;
+}
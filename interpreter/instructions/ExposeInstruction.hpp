@@ -58,8 +58,12 @@ class RexxInstructionExpose : public RexxInstruction
 
     virtual void execute(RexxActivation *, ExpressionStack *);
 
+    NumberArray *getVariableSlots(RexxClass *scope);
+
 protected:
 
+    RexxClass        *slotScope;         // the scope the variable slots were assigned for
+    NumberArray      *variableSlots;     // the scope slot numbers for the variables
     size_t            variableCount;     // number of variables to expose
     RexxVariableBase *variables[1];      // list of variables for EXPOSE
 };
@@ -561,6 +561,12 @@ RexxString *RexxTarget::remainder()
         return string;
     }
 
+    // the rest of the string can share the data of the parsed string
+    if (offset + length == string_length)
+    {
+        return string->extractTail(offset);
+    }
+
     // extract a new string piece
     RexxString *word = string->extract(offset, length);
     return word;
@@ -52,6 +52,9 @@
 #include "MethodClass.hpp"
 #include "ActivityManager.hpp"
 #include "MapTable.hpp"
+#include "PackageClass.hpp"
+#include "ClassClass.hpp"
+#include "DirectoryClass.hpp"
 
 
 /**
@@ -81,6 +84,8 @@ void Envelope::live(size_t liveMark)
     memory_mark(buffer);
     memory_mark(rehashTable);
     memory_mark(flattenStack);
+    memory_mark(package);
+    memory_mark(unresolvedClass);
 }
 
 
@@ -100,6 +105,8 @@ void Envelope::liveGeneral(MarkReason reason)
     memory_mark_general(buffer);
     memory_mark_general(rehashTable);
     memory_mark_general(flattenStack);
+    memory_mark_general(package);
+    memory_mark_general(unresolvedClass);
 }
 
 
@@ -137,8 +144,12 @@ void Envelope::flattenReference(void *newThisVoid, size_t newSelf, void *objRefV
         size_t referenceOffset = (char *)objRef - flattenBuffer;
 
         // if this is a proxied object, we need to convert it to a proxy and
-        // copy that object into the buffer and the reference table
-        if (obj->isProxyObject())
+        // copy that object into the buffer and the reference table.  An object
+        // serialization also proxies the objects flagged as needing a proxy and
+        // any class object it encounters, since these need to be located again
+        // on the restoring side.  Other flattens keep their existing format.
+        if (obj->isProxyObject() ||
+            (serializing && (obj->requiresProxyObject() || isOfClassType(Class, obj))))
         {
             // get a proxy and make sure it's in our protection table
             RexxInternalObject *proxyObj = obj->makeProxy(this);
@@ -160,6 +171,16 @@ void Envelope::flattenReference(void *newThisVoid, size_t newSelf, void *objRefV
         }
         // regardless of how we handle this, add an association for the object to the offset
         associateObject(obj, objOffset);
+        // large object graphs can have more pending objects than the initial stack holds.
+        if (!flattenStack->checkRoom())
+        {
+            LiveStack *newStack = flattenStack->reallocate(2);
+            // this holds offsets rather than object references, so it must not be marked
+            newStack->setHasNoReferences();
+            // the stacks are malloc()ed temporary objects
+            free((void *)flattenStack);
+            flattenStack = newStack;
+        }
         flattenStack->push((RexxInternalObject *)objOffset);
         // if the buffer reallocated, we need to update the updating object pointer too.
         char *newBuffer = bufferStart();
@@ -240,6 +261,10 @@ BufferClass *Envelope::pack(RexxInternalObject *_receiver)
         flattenObj->flatten(this);
     }
 
+    // the flatten stack was allocated outside of the object heap, so release it now.
+    free((void *)flattenStack);
+    flattenStack = OREF_NULL;
+
     // now unwrap the smart buffer and fix the length of the real buffer
     // behind it to the size we've written to it.
     BufferClass *letter = buffer->getBuffer();
@@ -272,11 +297,130 @@ void Envelope::puff(BufferClass *sourceBuffer, char *startPointer, size_t dataLe
     // the unflatten calls.
     memoryObject.unflattenProxyObjects(this, receiver, lastObject);
 
+    // serialized user objects only carry a reference to their class.  This
+    // needs to be resolved before the rehash, which might need to run
+    // hashCode methods.
+    if (serializing)
+    {
+        resolveBehaviours(receiver, lastObject);
+    }
+
     // now rehash any unflattened collection objects that require it.
     rehash();
 }
 
 
+/**
+ * Pack an arbitrary object graph for an object serialization.
+ * This differs from a normal pack in that objects of
+ * non-primitive classes only carry a reference to their class
+ * rather than the class method dictionaries.
+ *
+ * @param _receiver The root of the object graph.
+ *
+ * @return The buffer containing the flattened object graph.
+ */
+BufferClass *Envelope::serialize(RexxInternalObject *_receiver)
+{
+    serializing = true;
+    return pack(_receiver);
+}
+
+
+/**
+ * Unflatten an object graph created by serialize().
+ *
+ * @param sourceBuffer
+ *                   The buffer containing the flattened objects.
+ * @param startPointer
+ *                   The starting data location in the buffer.
+ * @param dataLength The length of the flattened data.
+ * @param p          The package used to resolve class references (can
+ *                   be OREF_NULL, in which case only the environment
+ *                   is searched).
+ */
+void Envelope::deserialize(BufferClass *sourceBuffer, char *startPointer, size_t dataLength, PackageClass *p)
+{
+    serializing = true;
+    package = p;
+    puff(sourceBuffer, startPointer, dataLength);
+}
+
+
+/**
+ * Resolve a proxy object during an unflatten operation.
+ *
+ * NOTE:  This is called while the unflatten mark handler is
+ * active, so failures are only recorded here and get reported
+ * once the unflatten is complete.
+ *
+ * @param name   The proxy name.
+ *
+ * @return The object the proxy stands for.
+ */
+RexxInternalObject *Envelope::resolveProxy(RexxString *name)
+{
+    RexxInternalObject *target = OREF_NULL;
+    // class references are resolved in the context of the
+    // requesting package first
+    if (package != OREF_NULL)
+    {
+        target = package->findClass(name);
+    }
+    if (target == OREF_NULL)
+    {
+        target = TheEnvironment->entry(name);
+    }
+    if (target == OREF_NULL && unresolvedClass == OREF_NULL)
+    {
+        unresolvedClass = name;
+    }
+    return target;
+}
+
+
+/**
+ * Replace the flattened behaviours of the objects restored
+ * by a deserialize with the instance behaviours of their
+ * resolved classes.
+ *
+ * @param firstObject
+ *                  The first unflattened object.
+ * @param endObject The first location past the unflattened objects.
+ */
+void Envelope::resolveBehaviours(RexxInternalObject *firstObject, RexxInternalObject *endObject)
+{
+    // if any class failed to resolve, we can't return a partial graph
+    if (unresolvedClass != OREF_NULL)
+    {
+        reportException(Error_Execution_noclass, unresolvedClass);
+    }
+
+    for (RexxInternalObject *object = firstObject; object < endObject; object = object->nextObject())
+    {
+        // the end of the buffer can contain a dead filler object, which needs to be
+        // skipped the same way the unflatten pass does.
+        if (object->isObjectDead(memoryObject.markWord))
+        {
+            continue;
+        }
+        RexxBehaviour *flattenedBehaviour = object->behaviour;
+        if (flattenedBehaviour->isNonPrimitive())
+        {
+            RexxClass *owningClass = flattenedBehaviour->getOwningClass();
+            // the class we found must create the same kind of primitive object,
+            // otherwise the restored object data is meaningless.
+            if (!isOfClassType(Class, owningClass) ||
+                owningClass->getInstanceBehaviour()->getClassType() != flattenedBehaviour->getClassType())
+            {
+                reportException(Error_Execution_user_defined, "Serialized object data does not match the definition of its class");
+            }
+            object->behaviour = owningClass->getInstanceBehaviour();
+        }
+    }
+}
+
+
 /**
  * Check if an object has already been flattened.
  *
@@ -308,6 +452,14 @@ size_t Envelope::copyBuffer(RexxInternalObject *obj)
     // offset is tagged as being a non-primitive behaviour that needs later inflating.
     if (newObj->behaviour->isNonPrimitive())
     {
+        // a serialization only records the object class, so any instance-specific
+        // methods would be lost on the trip.
+        if (serializing && newObj->behaviour->isEnhanced())
+        {
+            reportException(Error_Execution_user_defined, "Enhanced objects cannot be serialized");
+        }
+        // flag the copy so the unflatten knows the behaviour is an offset
+        newObj->setNonPrimitive();
         void *behavPtr = &newObj->behaviour;
         flattenReference(&newObj, objOffset, (RexxObject **)behavPtr);
     }
@@ -321,6 +473,7 @@ size_t Envelope::copyBuffer(RexxInternalObject *obj)
 
         // just replace the behaviour with its normalized type number.  This will be used
         // to restore it later.
+        newObj->setPrimitive();
         newObj->behaviour = newObj->behaviour->getSavedPrimitiveBehaviour();
     }
     // if we flattened an object from oldspace, we just copied everything.  Make sure
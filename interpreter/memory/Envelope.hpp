@@ -47,6 +47,7 @@
 class SmartBuffer;
 class BufferClass;
 class MapTable;
+class PackageClass;
 
 
 class Envelope : public RexxInternalObject
@@ -64,6 +65,10 @@ class Envelope : public RexxInternalObject
     void flattenReference(void *, size_t, void *);
     BufferClass *pack(RexxInternalObject *);
     void        puff(BufferClass *, char *, size_t length);
+    BufferClass *serialize(RexxInternalObject *);
+    void        deserialize(BufferClass *, char *, size_t length, PackageClass *);
+    RexxInternalObject *resolveProxy(RexxString *);
+    void   resolveBehaviours(RexxInternalObject *, RexxInternalObject *);
     size_t queryObj(RexxInternalObject *);
     size_t copyBuffer(RexxInternalObject *);
     void   rehash();
@@ -76,6 +81,7 @@ class Envelope : public RexxInternalObject
     inline size_t      getCurrentOffset() { return currentOffset; }
     inline MapTable *getDuptable() {return dupTable;}
     inline IdentityTable *getRehashtable() {return rehashTable;}
+    inline bool isSerializing() { return serializing; }
 
     size_t      currentOffset;            // current flattening offset
 
@@ -93,5 +99,8 @@ protected:
     SmartBuffer        *buffer;          // smart buffer wrapper
     IdentityTable      *rehashTable;     // table to rehash
     LiveStack          *flattenStack;    // the flattening stack
+    PackageClass       *package;         // package used to resolve classes when deserializing
+    RexxString         *unresolvedClass; // first class name a deserialize could not resolve
+    bool                serializing;     // true if this is an object serialization
 };
 #endif
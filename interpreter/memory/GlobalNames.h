@@ -67,6 +67,8 @@
   GLOBAL_NAME(BLANK, " ")
   GLOBAL_NAME(BRACKETS, "[]")
   GLOBAL_NAME(CALL, "CALL")
+  GLOBAL_NAME(CaselessComparator, "CASELESSCOMPARATOR")
+  GLOBAL_NAME(CaselessDescendingComparator, "CASELESSDESCENDINGCOMPARATOR")
   GLOBAL_NAME(CHARIN, "CHARIN")
   GLOBAL_NAME(CHAROUT, "CHAROUT")
   GLOBAL_NAME(CHARS, "CHARS")
@@ -75,6 +77,7 @@
   GLOBAL_NAME(COMMAND, "COMMAND")
   GLOBAL_NAME(COMPARE, "COMPARE")
   GLOBAL_NAME(COMPARETO, "COMPARETO")
+  GLOBAL_NAME(Comparator, "COMPARATOR")
   GLOBAL_NAME(CONCATENATE, "||")
   GLOBAL_NAME(ASSIGNMENT_CONCATENATE, "||=")
   GLOBAL_NAME(CONDITION, "CONDITION")
@@ -83,6 +86,7 @@
   GLOBAL_NAME(DEFAULTNAME, "DEFAULTNAME")
   GLOBAL_NAME(DELAY, "DELAY")
   GLOBAL_NAME(DESCRIPTION, "DESCRIPTION")
+  GLOBAL_NAME(DescendingComparator, "DESCENDINGCOMPARATOR")
   GLOBAL_NAME(DIVIDE, "/")
   GLOBAL_NAME(ASSIGNMENT_DIVIDE, "/=")
   GLOBAL_NAME(ENGINEERING, "ENGINEERING")
@@ -132,6 +136,7 @@
   GLOBAL_NAME(NOSTRING, "NOSTRING")
   GLOBAL_NAME(NOVALUE, "NOVALUE")
   GLOBAL_NAME(NULLSTRING, "")
+  GLOBAL_NAME(NumericComparator, "NUMERICCOMPARATOR")
   GLOBAL_NAME(OBJECT, "OBJECT")
   GLOBAL_NAME(OBJECTNAME, "OBJECTNAME")
   GLOBAL_NAME(OFF, "OFF")
@@ -144,6 +149,7 @@
   GLOBAL_NAME(POSITION, "POSITION")
   GLOBAL_NAME(POWER, "**")
   GLOBAL_NAME(ASSIGNMENT_POWER, "**=")
+  GLOBAL_NAME(PRECISION, "PRECISION")
   GLOBAL_NAME(PROGRAM, "PROGRAM")
   // there is a define conflict with the package name on the Mac
   GLOBAL_NAME(PACKAGE_REF, "PACKAGE")
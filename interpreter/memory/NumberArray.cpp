@@ -89,3 +89,16 @@ ArrayClass *NumberArray::toArray()
     }
     return newArray;
 }
+
+
+/**
+ * Check the size of a NumberArray from a flattened buffer.
+ *
+ * @param image  The handler validating the flattened buffer.
+ *
+ * @return true if all of the entries are inside the object.
+ */
+bool NumberArray::isValidFlattened(ValidatingMarkHandler &image)
+{
+    return fitsInObject(entries, totalSize, sizeof(size_t));
+}
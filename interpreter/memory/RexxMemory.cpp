@@ -1251,6 +1251,23 @@ void MemoryObject::tracingMark(RexxInternalObject *root, MarkReason reason)
 }
 
 
+/**
+ * Pass each of the references held by an object to a mark
+ * handler.  This allows the object graph to be walked with the
+ * same liveGeneral() methods used for marking.
+ *
+ * @param object  The object whose references are processed.
+ * @param handler The mark handler to receive the references.
+ * @param reason  The marking reason.
+ */
+void MemoryObject::markReferences(RexxInternalObject *object, MarkHandler *handler, MarkReason reason)
+{
+    setMarkHandler(handler);
+    object->liveGeneral(reason);
+    resetMarkHandler();
+}
+
+
 /**
  * Perform an in-place unflatten operation on an object
  * in a buffer.
@@ -1272,9 +1289,11 @@ RexxInternalObject *MemoryObject::unflattenObjectBuffer(BufferClass *sourceBuffe
     UnflatteningMarkHandler markHandler(startPointer, markWord);
     setMarkHandler(&markHandler);
 
-    // pointer for addressing a location as an object.  This will also
-    // give use the last object we've processed at the end.
+    // pointer for addressing a location as an object.
     RexxInternalObject *puffObject = (RexxInternalObject *)startPointer;
+    // the last object we've processed.  The loop leaves puffObject pointing
+    // at the end of the data, which is not an object.
+    RexxInternalObject *lastObject = puffObject;
 
     // now traverse the buffer fixing all of the behaviour pointers and having the object
     // mark and fix up their references.
@@ -1312,6 +1331,7 @@ RexxInternalObject *MemoryObject::unflattenObjectBuffer(BufferClass *sourceBuffe
         // mark fields in the objects.
         puffObject->liveGeneral(UNFLATTENINGOBJECT);
         // Point to next object in image.
+        lastObject = puffObject;
         puffObject = puffObject->nextObject();
     }
 
@@ -1329,9 +1349,9 @@ RexxInternalObject *MemoryObject::unflattenObjectBuffer(BufferClass *sourceBuffe
     // this is the size of any tailing buffer portion after the last unflattened object.
     size_t tailSize = nextObject - (char *)endPointer;
 
-    // puffObject is the last object we processed.  Add any tail data size on to that object
-    // so we don't create an invalid gap in the heap.
-    puffObject->setObjectSize(puffObject->getObjectSize() + tailSize);
+    // Add any tail data size on to the last object we processed so we don't
+    // create an invalid gap in the heap.
+    lastObject->setObjectSize(lastObject->getObjectSize() + tailSize);
     // now adjust the front portion of the buffer object to reveal all of the
     // unflattened data.  There is a dummy object at the front of the buffer...we want to
     // step to the the first real object
@@ -1341,6 +1361,137 @@ RexxInternalObject *MemoryObject::unflattenObjectBuffer(BufferClass *sourceBuffe
 }
 
 
+/**
+ * Check that a flattened object buffer from an outside source
+ * has a sane structure before it gets unflattened in place.
+ * Each object header must describe an object that fits inside
+ * the data, each behaviour must identify a class that can be
+ * flattened, and each reference must be the offset of another
+ * object in the data.  Classes with data whose layout depends
+ * on stored counts or links check those via isValidFlattened().
+ *
+ * NOTE:  ValidationPadding bytes following the data are
+ * overwritten, so the caller must allocate that space.
+ *
+ * @param startPointer
+ *                   The starting data location in the buffer.
+ * @param dataLength The length of the flattened data.
+ *
+ * @return true if the data can be unflattened, false otherwise.
+ */
+bool MemoryObject::validateObjectBuffer(char *startPointer, size_t dataLength)
+{
+    if (dataLength == 0 || (dataLength % Memory::ObjectGrain) != 0)
+    {
+        return false;
+    }
+
+    // a count in an object can run the marking past the end of the data.  Fill
+    // the padding with non-null values so the mark handler sees anything
+    // that strays past the last object.
+    for (size_t i = 0; i < ValidationPadding / sizeof(uintptr_t); i++)
+    {
+        ((uintptr_t *)(startPointer + dataLength))[i] = UINTPTR_MAX;
+    }
+
+    // we record the class type of each object at its grain location, which
+    // also tells us which offsets are valid object references.
+    size_t grains = dataLength / Memory::ObjectGrain;
+    uint8_t *objectTypes = (uint8_t *)malloc(grains);
+    if (objectTypes == NULL)
+    {
+        reportException(Error_System_resources);
+    }
+    memset(objectTypes, ValidatingMarkHandler::NotAnObject, grains);
+
+    ValidatingMarkHandler markHandler(startPointer, dataLength, objectTypes);
+    bool valid = true;
+
+    // first pass, locate all of the objects and check the primitive behaviours
+    size_t offset = 0;
+    while (offset < dataLength)
+    {
+        RexxInternalObject *object = (RexxInternalObject *)(startPointer + offset);
+        // the header needs to be inside the data before we can look at it.
+        if (dataLength - offset < Memory::MinimumObjectSize)
+        {
+            valid = false;
+            break;
+        }
+        size_t objectSize = object->getObjectSize();
+        if (!Memory::isValidSize(objectSize) || objectSize > dataLength - offset || object->isOldSpace())
+        {
+            valid = false;
+            break;
+        }
+        size_t typeNumber = T_Behaviour;
+        if (object->isPrimitive())
+        {
+            typeNumber = RexxBehaviour::savedPrimitiveClassType(object->behaviour);
+            if (typeNumber == SIZE_MAX)
+            {
+                valid = false;
+                break;
+            }
+        }
+        objectTypes[offset / Memory::ObjectGrain] = (uint8_t)typeNumber;
+        offset += objectSize;
+    }
+
+    // second pass, non-primitive objects have an offset to a flattened
+    // behaviour that gives the class type.
+    for (offset = 0; valid && offset < dataLength; offset += ((RexxInternalObject *)(startPointer + offset))->getObjectSize())
+    {
+        RexxInternalObject *object = (RexxInternalObject *)(startPointer + offset);
+        if (object->isNonPrimitive())
+        {
+            RexxInternalObject *behaviourOffset = (RexxInternalObject *)object->behaviour;
+            if (behaviourOffset == OREF_NULL || markHandler.typeOf(behaviourOffset) != T_Behaviour ||
+                ((RexxInternalObject *)(startPointer + (size_t)behaviourOffset))->isNonPrimitive())
+            {
+                valid = false;
+                break;
+            }
+            RexxBehaviour *objBehav = (RexxBehaviour *)markHandler.resolve(behaviourOffset);
+            if (objBehav->getObjectSize() < sizeof(RexxBehaviour) || (size_t)objBehav->getClassType() > T_Last_Internal_Class)
+            {
+                valid = false;
+                break;
+            }
+            objectTypes[offset / Memory::ObjectGrain] = (uint8_t)objBehav->getClassType();
+        }
+    }
+
+    // third pass, have each object mark its references.  This needs the
+    // virtual function tables, which the unflatten will set up again.
+    setMarkHandler(&markHandler);
+    try
+    {
+        for (offset = 0; valid && offset < dataLength; offset += markHandler.current->getObjectSize())
+        {
+            markHandler.current = (RexxInternalObject *)(startPointer + offset);
+            markHandler.current->setVirtualFunctions(MemoryObject::virtualFunctionTable[objectTypes[offset / Memory::ObjectGrain]]);
+            markHandler.current->liveGeneral(VALIDATINGOBJECT);
+        }
+    }
+    catch (ValidatingMarkHandler *)
+    {
+        valid = false;
+    }
+    resetMarkHandler();
+
+    // and finally, let the objects check any other data that must be consistent
+    for (offset = 0; valid && offset < dataLength; offset += markHandler.current->getObjectSize())
+    {
+        markHandler.current = (RexxInternalObject *)(startPointer + offset);
+        valid = markHandler.current->isValidFlattened(markHandler);
+    }
+
+    free(objectTypes);
+    return valid;
+}
+
+
 /**
  * Run the list of objects in an unflattened buffer calling
  * the unflatten() method to perform any proxy/collection
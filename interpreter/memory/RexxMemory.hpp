@@ -158,6 +158,9 @@ class MemoryObject : public RexxInternalObject
     void        addUninitObject(RexxInternalObject *obj);
     inline void checkUninitQueue() { if (pendingUninits > 0) runUninits(); }
     RexxInternalObject *unflattenObjectBuffer(BufferClass *sourceBuffer, char *startPointer, size_t dataLength);
+    bool        validateObjectBuffer(char *startPointer, size_t dataLength);
+    // writable space validateObjectBuffer() needs after the data
+    static const size_t ValidationPadding = 128 * sizeof(void *);
     void        unflattenProxyObjects(Envelope *envelope, RexxInternalObject *firstObject, RexxInternalObject *endObject);
 
     void        markObjects();
@@ -165,6 +168,7 @@ class MemoryObject : public RexxInternalObject
     void        mark(RexxInternalObject *);
     void        markGeneral(void *);
     void        tracingMark(RexxInternalObject *root, MarkReason reason);
+    void        markReferences(RexxInternalObject *object, MarkHandler *handler, MarkReason reason);
     void        collect();
     inline void removeHold(RexxInternalObject *obj) { saveStack->remove(obj); }
     RexxInternalObject *holdObject(RexxInternalObject *obj);
@@ -365,6 +369,53 @@ public:
 };
 
 
+/**
+ * A marking object used to check the references of a
+ * flattened object buffer from an outside source before it
+ * gets unflattened.  The references are still buffer offsets
+ * at this point, and each one must identify the start of an
+ * object in the buffer.
+ */
+class ValidatingMarkHandler : public MarkHandler
+{
+public:
+    // type table entries for locations that do not start an object
+    static const uint8_t NotAnObject = 0xff;
+
+    ValidatingMarkHandler(char *s, size_t l, uint8_t *t) : start(s), length(l), objectTypes(t), current(OREF_NULL) { }
+
+    // pure virtual method for handling the mark operation.
+    virtual void mark(RexxInternalObject **field, RexxInternalObject *object)
+    {
+        // a bad count in the object can run the marking past the end of the
+        // object, so the field must also be part of the object being checked.
+        if ((char *)field < (char *)current || (char *)field >= (char *)current + current->getObjectSize() ||
+            !isObject(object))
+        {
+            throw this;
+        }
+    }
+
+    inline bool isObject(RexxInternalObject *o)
+    {
+        size_t offset = (size_t)o;
+        return offset < length && (offset % Memory::ObjectGrain) == 0 &&
+            objectTypes[offset / Memory::ObjectGrain] != NotAnObject;
+    }
+
+    // the class type of a non-null reference, with anything that is not
+    // an object reported as NotAnObject
+    inline size_t typeOf(RexxInternalObject *o) { return isObject(o) ? objectTypes[(size_t)o / Memory::ObjectGrain] : NotAnObject; }
+    inline RexxInternalObject *resolve(RexxInternalObject *o) { return (RexxInternalObject *)(start + (size_t)o); }
+    inline RexxInternalObject *offsetOf(RexxInternalObject *o) { return (RexxInternalObject *)((char *)o - start); }
+
+    char    *start;                  // the start of the flattened data
+    size_t   length;                 // the length of the flattened data
+    uint8_t *objectTypes;            // class type for each object grain in the data
+    RexxInternalObject *current;     // the object currently getting checked
+};
+
+
 /**
  * A mark handler for the unflatten phase of envelope
  * restoral.
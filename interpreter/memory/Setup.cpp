@@ -1207,6 +1207,8 @@ StartClassDefinition(RexxInfo)
         AddMethod("MajorVersion", RexxInfo::getMajorVersion, 0);
         AddMethod("Release", RexxInfo::getRelease, 0);
         AddMethod("Revision", RexxInfo::getRevision, 0);
+        AddMethod("InterpretCacheHits", RexxInfo::getInterpretCacheHits, 0);
+        AddMethod("InterpretCacheMisses", RexxInfo::getInterpretCacheMisses, 0);
 
     CompleteMethodDefinitions();
 
@@ -72,6 +72,8 @@ StringTable *PackageManager::packages = OREF_NULL;        // our loaded packages
 StringTable *PackageManager::packageRoutines = OREF_NULL;     // table of functions loaded from packages
 StringTable *PackageManager::registeredRoutines = OREF_NULL;
 StringTable *PackageManager::loadedRequires = OREF_NULL;
+StringTable *PackageManager::macroRoutines = OREF_NULL;
+size_t PackageManager::macroGeneration = 0;
 
 /**
  * Initialize the package manager global state.
@@ -82,6 +84,7 @@ void PackageManager::initialize()
     packageRoutines = new_string_table();
     registeredRoutines = new_string_table();
     loadedRequires = new_string_table();
+    macroRoutines = new_string_table();
     // load the internal library first
     loadInternalPackage(GlobalNames::REXX, rexxPackage);
     loadLibrary(GlobalNames::REXXUTIL); // load the rexxutil package automatically
@@ -133,6 +136,7 @@ void PackageManager::restore()
     packageRoutines = (StringTable *)imagePackageRoutines->copy();
     registeredRoutines = (StringTable *)imageRegisteredRoutines->copy();
     loadedRequires = (StringTable *)imageLoadedRequires->copy();
+    macroRoutines = new_string_table();
 
     for (HashContents::TableIterator iterator = packages->iterator(); iterator.isAvailable(); iterator.next())
     {
@@ -162,6 +166,7 @@ void PackageManager::live(size_t liveMark)
     memory_mark(packageRoutines);
     memory_mark(registeredRoutines);
     memory_mark(loadedRequires);
+    memory_mark(macroRoutines);
 }
 
 /**
@@ -173,6 +178,7 @@ void PackageManager::liveGeneral(MarkReason reason)
     memory_mark_general(packageRoutines);
     memory_mark_general(registeredRoutines);
     memory_mark_general(loadedRequires);
+    memory_mark_general(macroRoutines);
 }
 
 
@@ -637,6 +643,7 @@ void PackageManager::unload()
     packageRoutines = (StringTable *)imagePackageRoutines->copy();
     registeredRoutines = (StringTable *)imageRegisteredRoutines->copy();
     loadedRequires = (StringTable *)imageLoadedRequires->copy();
+    macroRoutines = new_string_table();
 }
 
 
@@ -766,6 +773,64 @@ PackageClass *PackageManager::loadRequires(Activity *activity, RexxString *short
 }
 
 
+/**
+ * Check the macrospace for a function.  The answer includes the
+ * macrospace generation it was taken from, which is used to validate
+ * the restored routines we keep in macroRoutines.
+ *
+ * @param name       The target function name.
+ * @param position   The returned search order position.
+ * @param generation The returned macrospace generation.
+ *
+ * @return true if the function exists in the macrospace.
+ */
+bool PackageManager::queryMacroSpace(RexxString *name, unsigned short &position, size_t &generation)
+{
+    position = 0;
+    generation = 0;
+    return RexxQueryMacroGeneration(name->getStringData(), &position, &generation) == 0;
+}
+
+
+/**
+ * Get the routine for a macrospace function.  Restoring the
+ * image is far more expensive than running a small macro, so
+ * restored routines are kept until the macrospace generation
+ * changes.
+ *
+ * @param name       The function name.
+ * @param generation The generation returned by the query that located
+ *                   the function.
+ *
+ * @return The restored routine, or OREF_NULL if the image could not be
+ *         retrieved.
+ */
+RoutineClass *PackageManager::getMacroSpaceRoutine(RexxString *name, size_t generation)
+{
+    // any change anywhere in the macrospace invalidates everything we hold
+    if (generation != macroGeneration)
+    {
+        macroRoutines->empty();
+        macroGeneration = generation;
+    }
+
+    RoutineClass *routine = (RoutineClass *)macroRoutines->get(name);
+    if (routine != OREF_NULL)
+    {
+        return routine;
+    }
+
+    routine = RexxActivation::getMacroCode(name);
+    // getMacroCode releases the kernel lock while talking to rxapi, so only
+    // keep this if nobody has moved us to a different generation meanwhile.
+    if (routine != OREF_NULL && generation == macroGeneration)
+    {
+        macroRoutines->put(routine, name);
+    }
+    return routine;
+}
+
+
 /**
  * Retrieve a ::REQUIRES file from the macrospace.
  *
@@ -871,6 +936,46 @@ PackageClass *PackageManager::loadRequires(Activity *activity, RexxString *name,
 }
 
 
+/**
+ * Register a package that was compiled into a bundled image.
+ * The package is cached under the name of the file it was
+ * compiled from, so a later file-based ::REQUIRES of the same
+ * file resolves to it as well.
+ *
+ * @param activity The current activity.
+ * @param name     The name used on the ::REQUIRES directive.
+ * @param bundled  The package from the image.
+ * @param package  The returned package object.
+ *
+ * @return The package to use for the requires.
+ */
+PackageClass *PackageManager::loadRequires(Activity *activity, RexxString *name, PackageClass *bundled, Protected<PackageClass> &package)
+{
+    package = (PackageClass *)OREF_NULL;
+
+    SecurityManager *manager = activity->getEffectiveSecurityManager();
+    RexxObject *securityManager = OREF_NULL;
+    // the security manager gets the same say it would for the file
+    if (manager->checkRequiresAccess(name, securityManager) == OREF_NULL)
+    {
+        return OREF_NULL;
+    }
+
+    RexxString *fullName = bundled->getProgramName();
+    package = checkRequiresCache(fullName, package);
+    if (!package.isNull())
+    {
+        return package;
+    }
+
+    // make sure we're not stuck in a circular reference
+    activity->checkRequires(fullName);
+    package = bundled;
+    addToRequiresCache(fullName, package);
+    return package;
+}
+
+
 /**
  * Check for a package already in the requires cache.
  *
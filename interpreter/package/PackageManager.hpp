@@ -91,10 +91,13 @@ public:
         RexxObject **arguments, size_t argcount, ProtectedObject &result);
 
     static PackageClass *loadRequires(Activity *activity, RexxString *shortName, RexxString *resolvedName, Protected<PackageClass> &package);
+    static bool          queryMacroSpace(RexxString *name, unsigned short &position, size_t &generation);
+    static RoutineClass *getMacroSpaceRoutine(RexxString *name, size_t generation);
     static PackageClass *getMacroSpaceRequires(Activity *activity, RexxString *name, Protected<PackageClass> &package, RexxObject *securityManager);
     static PackageClass *getRequiresFile(Activity *activity, RexxString *name, RexxObject *securityManager, Protected<PackageClass> &result);
     static PackageClass *loadRequires(Activity *activity, RexxString *name, ArrayClass *data, Protected<PackageClass> &result);
     static PackageClass *loadRequires(Activity *activity, RexxString *name, const char *data, size_t length, Protected<PackageClass> &result);
+    static PackageClass *loadRequires(Activity *activity, RexxString *name, PackageClass *bundled, Protected<PackageClass> &result);
 
 protected:
 
@@ -120,6 +123,8 @@ protected:
     static StringTable    *packageRoutines;     // table of functions loaded from packages
     static StringTable    *registeredRoutines;  // table of functions resolved by older registration mechanisms
     static StringTable    *loadedRequires;      // table of previously loaded requires files
+    static StringTable    *macroRoutines;       // restored macrospace routines, valid for macroGeneration
+    static size_t          macroGeneration;     // the macrospace generation macroRoutines was built from
 
     static RexxPackageEntry *rexxPackage;       // internal generated REXX package
 };
@@ -1111,6 +1111,22 @@ void LanguageParser::optionsDirective()
                     break;
                 }
 
+                // ::OPTIONS OPTIMIZE
+                case SUBDIRECTIVE_OPTIMIZE:
+                {
+                    // this option is just the keyword...turn on the expression optimizer
+                    package->enableOptimize();
+                    break;
+                }
+
+                // ::OPTIONS NOOPTIMIZE
+                case SUBDIRECTIVE_NOOPTIMIZE:
+                {
+                    // this option is just the keyword...turn off the expression optimizer
+                    package->disableOptimize();
+                    break;
+                }
+
                 // invalid keyword
                 default:
                     syntaxError(Error_Invalid_subkeyword_options, token);
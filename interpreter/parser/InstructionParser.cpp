@@ -558,6 +558,8 @@ RexxInstruction *LanguageParser::addressNew()
     RexxInternalObject *dynamicAddress = OREF_NULL;
     RexxString *environment = OREF_NULL;
     RexxInternalObject *command = OREF_NULL;
+    RexxVariableBase *outputTarget = OREF_NULL;
+    RexxVariableBase *errorTarget = OREF_NULL;
     RexxToken *token = nextReal();
 
     // have something to process?  Having nothing is not an error, it
@@ -591,21 +593,132 @@ RexxInstruction *LanguageParser::addressNew()
                 token = nextReal();
                 if (!token->isEndOfClause())
                 {
-                    // back up and create the expression
+                    // back up and create the expression.  The command
+                    // can be followed by WITH OUTPUT/ERROR capture options,
+                    // but WITH only ends the command when the options
+                    // are really there.  Otherwise it is an ordinary symbol.
                     previousToken();
-                    command = parseExpression(TERM_EOC);
+                    if (hasAddressWith())
+                    {
+                        command = parseExpression(TERM_EOC | TERM_WITH | TERM_KEYWORD);
+                    }
+                    else
+                    {
+                        command = parseExpression(TERM_EOC);
+                    }
+                    token = nextToken();
+                    if (token->subKeyword() == SUBKEY_WITH)
+                    {
+                        // the capture options only make sense with a command
+                        if (command == OREF_NULL)
+                        {
+                            syntaxError(Error_Invalid_expression_general, token);
+                        }
+                        parseAddressWith(outputTarget, errorTarget);
+                    }
                 }
             }
         }
     }
 
     RexxInstruction *newObject = new_instruction(ADDRESS, Address);
-    ::new ((void *)newObject) RexxInstructionAddress(dynamicAddress, environment, command);
+    ::new ((void *)newObject) RexxInstructionAddress(dynamicAddress, environment, command, outputTarget, errorTarget);
     return newObject;
 }
 
 
 
+/**
+ * Check whether the rest of an ADDRESS clause contains the
+ * WITH OUTPUT or WITH ERROR capture options.  A WITH symbol
+ * followed by anything else is part of the command expression.
+ * The clause position is left unchanged.
+ *
+ * @return true if a WITH keyword starts the capture options.
+ */
+bool LanguageParser::hasAddressWith()
+{
+    size_t mark = markPosition();
+    bool found = false;
+
+    RexxToken *token = nextReal();
+    while (!token->isEndOfClause())
+    {
+        if (token->subKeyword() == SUBKEY_WITH)
+        {
+            token = nextReal();
+            InstructionSubKeyword option = token->subKeyword();
+            if (option == SUBKEY_OUTPUT || option == SUBKEY_ERROR)
+            {
+                found = true;
+                break;
+            }
+            // this could be another WITH, so check it again
+            continue;
+        }
+        token = nextReal();
+    }
+    resetPosition(mark);
+    return found;
+}
+
+
+/**
+ * Parse the WITH options of an ADDRESS env command instruction.
+ * The options are OUTPUT var and ERROR var, in any order, each
+ * specified at most once.
+ *
+ * @param outputTarget
+ *               Returns the variable receiving the command stdout.
+ * @param errorTarget
+ *               Returns the variable receiving the command stderr.
+ */
+void LanguageParser::parseAddressWith(RexxVariableBase *&outputTarget, RexxVariableBase *&errorTarget)
+{
+    RexxToken *token = nextReal();
+    if (token->isEndOfClause())
+    {
+        syntaxError(Error_Symbol_expected_after_keyword, new_string("WITH"));
+    }
+
+    while (!token->isEndOfClause())
+    {
+        switch (token->subKeyword())
+        {
+            // WITH OUTPUT var
+            case SUBKEY_OUTPUT:
+            {
+                // only allowed once
+                if (outputTarget != OREF_NULL)
+                {
+                    syntaxError(Error_Invalid_subkeyword_following, new_string("WITH"), token->value());
+                }
+                outputTarget = requiredVariable(nextReal(), "OUTPUT");
+                break;
+            }
+
+            // WITH ERROR var
+            case SUBKEY_ERROR:
+            {
+                // only allowed once
+                if (errorTarget != OREF_NULL)
+                {
+                    syntaxError(Error_Invalid_subkeyword_following, new_string("WITH"), token->value());
+                }
+                errorTarget = requiredVariable(nextReal(), "ERROR");
+                break;
+            }
+
+            // something unknown
+            default:
+                syntaxError(Error_Invalid_subkeyword_following, new_string("WITH"), token->value());
+                break;
+        }
+        token = nextReal();
+    }
+}
+
+
 /**
  * Create a new variable assignment instruction.
  *
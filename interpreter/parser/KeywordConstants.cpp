@@ -116,6 +116,7 @@ KeywordEntry RexxToken::subKeywords[] =
     KeywordEntry("DESCRIPTION", SUBKEY_DESCRIPTION),
     KeywordEntry("DIGITS",      SUBKEY_DIGITS),
     KeywordEntry("ENGINEERING", SUBKEY_ENGINEERING),
+    KeywordEntry("ERROR",       SUBKEY_ERROR),
     KeywordEntry("EXIT",        SUBKEY_EXIT),
     KeywordEntry("EXPOSE",      SUBKEY_EXPOSE),
     KeywordEntry("FALSE",       SUBKEY_FALSE),
@@ -131,6 +132,7 @@ KeywordEntry RexxToken::subKeywords[] =
     KeywordEntry("NAME",        SUBKEY_NAME),
     KeywordEntry("OFF",         SUBKEY_OFF),
     KeywordEntry("ON",          SUBKEY_ON),
+    KeywordEntry("OUTPUT",      SUBKEY_OUTPUT),
     KeywordEntry("OVER",        SUBKEY_OVER),
     KeywordEntry("RETURN",      SUBKEY_RETURN),
     KeywordEntry("SCIENTIFIC",  SUBKEY_SCIENTIFIC),
@@ -368,8 +370,10 @@ KeywordEntry RexxToken::subDirectives[] =
     KeywordEntry("METHOD",      SUBDIRECTIVE_METHOD),
     KeywordEntry("MIXINCLASS",  SUBDIRECTIVE_MIXINCLASS),
     KeywordEntry("NAMESPACE",   SUBDIRECTIVE_NAMESPACE),
+    KeywordEntry("NOOPTIMIZE",  SUBDIRECTIVE_NOOPTIMIZE),
     KeywordEntry("NOPROLOG",    SUBDIRECTIVE_NOPROLOG),
     KeywordEntry("NOVALUE",     SUBDIRECTIVE_NOVALUE),
+    KeywordEntry("OPTIMIZE",    SUBDIRECTIVE_OPTIMIZE),
     KeywordEntry("PACKAGE",     SUBDIRECTIVE_PACKAGE),
     KeywordEntry("PRIVATE",     SUBDIRECTIVE_PRIVATE),
     KeywordEntry("PROLOG",      SUBDIRECTIVE_PROLOG),
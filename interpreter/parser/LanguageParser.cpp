@@ -76,6 +76,8 @@
 #include "TraceSetting.hpp"
 #include "ExpressionQualifiedFunction.hpp"
 #include "ExpressionClassResolver.hpp"
+#include "AssignmentInstruction.hpp"
+#include "IdentityTableClass.hpp"
 
 
 /**
@@ -405,9 +407,11 @@ void LanguageParser::live(size_t liveMark)
     memory_mark(holdStack);
     memory_mark(variables);
     memory_mark(literals);
+    memory_mark(codeSections);
     memory_mark(dotVariables);
     memory_mark(labels);
     memory_mark(strings);
+    memory_mark(symbolTable);
     memory_mark(guardVariables);
     memory_mark(exposedVariables);
     memory_mark(localVariables);
@@ -451,9 +455,11 @@ void LanguageParser::liveGeneral(MarkReason reason)
     memory_mark_general(holdStack);
     memory_mark_general(variables);
     memory_mark_general(literals);
+    memory_mark_general(codeSections);
     memory_mark_general(dotVariables);
     memory_mark_general(labels);
     memory_mark_general(strings);
+    memory_mark_general(symbolTable);
     memory_mark_general(guardVariables);
     memory_mark_general(exposedVariables);
     memory_mark_general(localVariables);
@@ -672,6 +678,7 @@ void LanguageParser::initializeForParsing()
     terms = new_queue();          // expression term stack
     subTerms = new_queue();       // temporary stack for holding lists of terms
     operators = new_queue();      // the operator queue
+    codeSections = new_array();   // the translated code blocks, for the optimizer
     literals = new_string_table();   // table of literal values
     dotVariables = new_string_table();   // table of dot variables
 
@@ -684,6 +691,10 @@ void LanguageParser::initializeForParsing()
         strings = new_string_table();
     }
 
+    // symbol names are interned directly from the source text
+    symbolTable = new_array(SYMBOL_TABLE_SIZE);
+    symbolCount = 0;
+
     // create the singleton clause object for parsing
     clause = new RexxClause();
 }
@@ -1017,6 +1028,118 @@ void LanguageParser::translate()
         // resolve any class dependencies
         resolveDependencies();
     }
+
+    // the ::OPTIONS are only known once everything has been translated, so
+    // the optimizer runs as a pass over all of the code sections
+    if (package->isOptimizeEnabled())
+    {
+        optimizeExpressions();
+    }
+}
+
+
+/**
+ * A mark handler used to walk the parse tree of the translated
+ * code.  Only instructions, expression terms, parse triggers and
+ * the arrays they hold are followed, so the walk never leaves
+ * the code.
+ */
+class CodeWalkMarkHandler : public MarkHandler
+{
+public:
+    CodeWalkMarkHandler(IdentityTable *v, QueueClass *p) : visited(v), pending(p) { }
+
+    virtual void mark(RexxInternalObject **field, RexxInternalObject *object)
+    {
+        if (isCodeNode(object->getObjectTypeNumber()))
+        {
+            // instructions can be reached more than once (the END of a DO,
+            // for example), so only new nodes get queued.
+            if (!visited->hasIndex(object))
+            {
+                visited->put(object, object);
+                pending->push(object);
+            }
+        }
+    }
+
+    static bool isCodeNode(size_t type)
+    {
+        switch (type)
+        {
+            case T_Array:
+            case T_ParseTrigger:
+            case T_ClassResolver:
+            case T_QualifiedFunction:
+                return true;
+
+            default:
+                return type >= T_VariableTerm && type <= T_DoWithForWhileInstruction;
+        }
+    }
+
+    IdentityTable *visited;      // the nodes we've already found
+    QueueClass    *pending;      // nodes with references still to be walked
+};
+
+
+/**
+ * Run the expression optimizer over the operators and
+ * assignments of all code sections in the package.  The parse
+ * tree is walked from each code section, which finds each node
+ * before its operands.  Processing the nodes in reverse order
+ * optimizes the operands of an operator before the operator
+ * itself.  Constants are folded using the package numeric
+ * settings.
+ */
+void LanguageParser::optimizeExpressions()
+{
+    Protected<IdentityTable> visited = new_identity_table();
+    Protected<QueueClass> pending = new_queue();
+    Protected<ArrayClass> nodes = new_array();
+
+    CodeWalkMarkHandler walker(visited, pending);
+
+    size_t count = codeSections->items();
+    for (size_t i = 1; i <= count; i++)
+    {
+        RexxInternalObject *first = ((RexxCode *)codeSections->get(i))->getFirstInstruction();
+        if (first != OREF_NULL)
+        {
+            walker.mark(&first, first);
+        }
+        while (!pending->isEmpty())
+        {
+            RexxInternalObject *node = pending->pull();
+            if (isOfClass(BinaryOperatorTerm, node) || isOfClass(UnaryOperatorTerm, node) ||
+                isOfClass(AssignmentInstruction, node))
+            {
+                nodes->append(node);
+            }
+            memoryObject.markReferences(node, &walker, LIVEMARK);
+        }
+    }
+
+    // folding a constant can raise an error, so the settings are
+    // restored however we leave
+    NumericSettingsBlock settings(&package->packageSettings.numericSettings);
+
+    for (size_t i = nodes->items(); i > 0; i--)
+    {
+        RexxInternalObject *node = nodes->get(i);
+        if (isOfClass(BinaryOperatorTerm, node))
+        {
+            ((RexxBinaryOperator *)node)->optimize();
+        }
+        else if (isOfClass(UnaryOperatorTerm, node))
+        {
+            ((RexxUnaryOperator *)node)->optimize();
+        }
+        else
+        {
+            ((RexxInstructionAssignment *)node)->optimize();
+        }
+    }
 }
 
 
@@ -1491,6 +1614,8 @@ RexxCode *LanguageParser::translateBlock()
     // now create a code object that is attached to the package.
     // this will have all of the information needed to execute this code.
     RexxCode *code = new RexxCode(package, blockLocation, firstInstruction, labels, maxStack, variableIndex);
+    // the optimizer needs to find all of the code once translation is finished
+    codeSections->append(code);
 
     // we don't automatically create the labels when we translate the block because
     // they might have been provided by an interpret.  So always clear them out at the
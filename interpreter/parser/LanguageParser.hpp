@@ -176,10 +176,13 @@ class LanguageParser: public RexxInternalObject
     void        localVariable(RexxString *);
     void        autoExpose();
     RexxString *commonString(RexxString *);
+    RexxString *internSymbol(size_t start, size_t length);
+    void        expandSymbolTable();
     RexxInternalObject *addText(RexxToken *);
     RexxVariableBase *addVariable(RexxToken *);
     RexxVariableBase *requiredVariable(RexxToken *, const char *);
     void        addClause(RexxInstruction *);
+    void        optimizeExpressions();
     void        addLabel(RexxInstruction *, RexxString *);
     RexxInstruction *findLabel(RexxString *);
     void        setGuard();
@@ -241,6 +244,8 @@ class LanguageParser: public RexxInternalObject
     size_t      processVariableList(InstructionKeyword);
 
     RexxInstruction *addressNew();
+    bool hasAddressWith();
+    void parseAddressWith(RexxVariableBase *&outputTarget, RexxVariableBase *&errorTarget);
     RexxInstruction *assignmentNew(RexxToken *);
     RexxInstruction *assignmentOpNew(RexxToken *, RexxToken *);
     RexxInstruction *callOnNew(InstructionSubKeyword type);
@@ -418,6 +423,14 @@ class LanguageParser: public RexxInternalObject
         return characterTable[ch & 0xff];
     }
 
+    static inline unsigned int upperSymbolChar(unsigned int ch)
+    {
+        // symbol characters translate to uppercase, anything else (the sign
+        // of an exponent) is used as is.
+        int tran = translateChar(ch);
+        return tran != 0 ? tran : ch;
+    }
+
     // static methods for creating/processing different Rexx executables.
 
     static MethodClass *createMethod(RexxString *name, ArrayClass *source, PackageClass *sourceContext);
@@ -450,6 +463,8 @@ protected:
 
     // size of our parsing holdstack used for short-term protection.
     static const size_t HOLDSIZE = 30;
+    // initial size of the symbol intern table (must be a power of 2)
+    static const size_t SYMBOL_TABLE_SIZE = 64;
 
     RexxString *name;                    // the name of the code we're translating (frequently a file name)
     ProgramSource *source;               // the source we're translating.
@@ -468,10 +483,13 @@ protected:
     StringTable     *literals;           // root of associated literal list
     StringTable     *dotVariables;       // root of associated dot variable values
     StringTable     *strings;            // common pool of created strings
+    ArrayClass      *symbolTable;        // interned symbol names, hashed by their source characters
+    size_t           symbolCount;        // number of symbols in the intern table
     QueueClass      *control;            // queue of control structures
     QueueClass      *terms;              // stack of expression terms
     QueueClass      *subTerms;           // stack for arguments lists, et al.
     QueueClass      *operators;          // stack of expression terms
+    ArrayClass      *codeSections;       // code blocks translated, in order of creation
     ClassDirective  *activeClass;        // currently active ::CLASS directive
     StringTable     *classDependencies;  // directory of named ::class directives
     StringTable     *unattachedMethods;  // methods not associated with any class
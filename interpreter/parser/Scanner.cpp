@@ -233,6 +233,20 @@ void LanguageParser::scanComment()
             continue;
         }
 
+        // only '*' and '/' matter inside a comment, so skip everything else
+        // in one go.
+        const char *scan = current + lineOffset;
+        const char *end = current + currentLength;
+        while (scan < end && *scan != '*' && *scan != '/')
+        {
+            scan++;
+        }
+        lineOffset = scan - current;
+        if (!moreChars())
+        {
+            continue;
+        }
+
         // get the current char and step the position.
         unsigned int inch = nextChar();
         // at the end delimiter
@@ -1249,226 +1263,247 @@ RexxToken *LanguageParser::scanSymbol()
     startLocation(location);
 
     unsigned int inch = getChar();       // ok, get the current character to start this off
-    // ok, loop through the token until we've consumed it all.
-    for (;;)
+
+    // most symbols start with a letter and can't be numbers, so there's no need
+    // to run the numeric state machine.  Just run to the end of the symbol characters.
+    if (translateChar(inch) != 0 && inch != '.' && (inch < '0' || inch > '9'))
     {
-        // keep a count of periods...we use this to determine stem/compound and numeric values
-        if (inch == '.')
+        state = EXP_EXCLUDED;
+        const unsigned char *scan = (const unsigned char *)current + lineOffset;
+        const unsigned char *end = (const unsigned char *)current + currentLength;
+        while (scan < end && translateChar(*scan) != 0)
         {
-            dotCount++;
+            if (*scan == '.')
+            {
+                dotCount++;
+            }
+            scan++;
         }
-
-        // finite state machine to establish numeric constant (with possible
-        // included sign in exponential form)
-
-        switch (state)
+        lineOffset = scan - (const unsigned char *)current;
+    }
+    else
+    {
+        // ok, loop through the token until we've consumed it all.
+        for (;;)
         {
-            // this is our beginning state...we know nothing about this symbol yet.
+            // keep a count of periods...we use this to determine stem/compound and numeric values
+            if (inch == '.')
+            {
+                dotCount++;
+            }
 
-            case EXP_START:
+            // finite state machine to establish numeric constant (with possible
+            // included sign in exponential form)
+
+            switch (state)
             {
-                // have a digit at the start?  Potential number, so
-                // we're looking for digits here.
-                if (inch >= '0' && inch <= '9')
-                {
-                    state = EXP_DIGIT;
-                }
-                // if this is a dot, then we've got a starting decimal
-                // point.  This could be a number or an environment symbol
-                else if (inch == '.')
+                // this is our beginning state...we know nothing about this symbol yet.
+
+                case EXP_START:
                 {
-                    state = EXP_SPOINT;
+                    // have a digit at the start?  Potential number, so
+                    // we're looking for digits here.
+                    if (inch >= '0' && inch <= '9')
+                    {
+                        state = EXP_DIGIT;
+                    }
+                    // if this is a dot, then we've got a starting decimal
+                    // point.  This could be a number or an environment symbol
+                    else if (inch == '.')
+                    {
+                        state = EXP_SPOINT;
+                    }
+                    // a non-numeric character.  A number is not possible.
+                    else
+                    {
+                        state = EXP_EXCLUDED;
+                    }
+                    break;
                 }
-                // a non-numeric character.  A number is not possible.
-                else
+
+                // we're scanning digits, still potentially a number.
+                case EXP_DIGIT:
                 {
-                    state = EXP_EXCLUDED;
+                    // is this a period?  Since we're scanning digits, this
+                    // is must be the first period and is a decimal point.
+                    // switch to scanning the part after the decimal.
+                    if (inch=='.')
+                    {
+                        state = EXP_POINT;
+                    }
+                    // So far, the form is "digitsE"...this can still be a number,
+                    // but know we're looking for an exponent.
+                    else if (inch=='E' || inch == 'e')
+                    {
+                        state = EXP_E;
+                    }
+                    // other non-digit?  We're no longer scanning a number.
+                    else if (inch < '0' || inch > '9')
+                    {
+                        state = EXP_EXCLUDED;
+                    }
+                    // if we encounter a digit, the state is unchanged
+                    break;
                 }
-                break;
-            }
 
-            // we're scanning digits, still potentially a number.
-            case EXP_DIGIT:
-            {
-                // is this a period?  Since we're scanning digits, this
-                // is must be the first period and is a decimal point.
-                // switch to scanning the part after the decimal.
-                if (inch=='.')
+                // we're scanning from a leading decimal point.  How we
+                // go from here depends on the next character.
+                case EXP_SPOINT:
                 {
-                    state = EXP_POINT;
+                    // not a digit immediately after the period, we're
+                    // scanning a normal symbol from here.
+                    if (inch < '0' || inch > '9')
+                    {
+                        state = EXP_EXCLUDED;  /* not a number                      */
+                    }
+                    // second character is a digit, so we're scanning the
+                    // part after the decimal.
+                    else
+                    {
+                        state = EXP_POINT;
+                    }
+                    break;
                 }
-                // So far, the form is "digitsE"...this can still be a number,
-                // but know we're looking for an exponent.
-                else if (inch=='E' || inch == 'e')
+
+                // scanning after a decimal point.  From here, we could hit
+                // the 'E' for exponential notation.
+                case EXP_POINT:
                 {
-                    state = EXP_E;
+                    // potential exponential, switch scan to the exponent part.
+                    if (inch == 'E' || inch == 'e')
+                    {
+                        state = EXP_E;
+                    }
+                    // non-digit other than an 'E'?, no longer a valid numeric.
+                    else if (inch < '0' || inch > '9')
+                    {
+                        state = EXP_EXCLUDED;
+                    }
+                    // if we find a digit, the state is unchanged.
+                    break;
                 }
-                // other non-digit?  We're no longer scanning a number.
-                else if (inch < '0' || inch > '9')
+
+                // we have a valid number up to an 'E'...now we can have digits or
+                // a sign for the exponent.  The digit will be handled here, but
+                // the +/- is either a symbol terminator or part of the symbol.
+                // we check that at the end-of-symbol processing
+                case EXP_E:
                 {
-                    state = EXP_EXCLUDED;
+                    // switching to process the exponent digits
+                    if (inch >= '0' && inch <= '9')
+                    {
+                        state = EXP_EDIGIT;
+                    }
+                    // we handle the sign situation below.
+                    break;
                 }
-                // if we encounter a digit, the state is unchanged
-                break;
-            }
 
-            // we're scanning from a leading decimal point.  How we
-            // go from here depends on the next character.
-            case EXP_SPOINT:
-            {
-                // not a digit immediately after the period, we're
-                // scanning a normal symbol from here.
-                if (inch < '0' || inch > '9')
+                // we're scanning a potential numeric value, and we've just
+                // had the sign, so we're looking for digits after that.   If there
+                // are no digits, then the sign actually terminated the symbol, so
+                // we need to back up.
+                case EXP_ESIGN:
                 {
-                    state = EXP_EXCLUDED;  /* not a number                      */
+                    // found a digit here?  switching into exponent scan mode.
+                    if (inch >= '0' && inch <= '9')
+                    {
+                        state = EXP_EDIGIT;
+                    }
+                    else
+                    {
+                        // non-digit cannot be a number.
+                        state = EXP_EXCLUDED;
+                    }
+                    break;
                 }
-                // second character is a digit, so we're scanning the
-                // part after the decimal.
-                else
+
+                // scanning for exponent digits.  No longer numeric if we find a non-digit.
+                case EXP_EDIGIT:
                 {
-                    state = EXP_POINT;
+                    if (inch < '0' || inch > '9')
+                    {
+                        state = EXP_EXCLUDED;
+                    }
+                    break;                   /* go get the next character         */
                 }
-                break;
+
+                // once EXP_EXCLUDED is reached the state doesn't change.  We're
+                // just consuming symbol characters from here.
             }
 
-            // scanning after a decimal point.  From here, we could hit
-            // the 'E' for exponential notation.
-            case EXP_POINT:
+            // handled all of the states, now handle the termination checks.
+            stepPosition();
+
+            // did we step past an exponential sign but found an invalid exponent?
+            if (eoffset != 0 && state == EXP_EXCLUDED)
             {
-                // potential exponential, switch scan to the exponent part.
-                if (inch == 'E' || inch == 'e')
-                {
-                    state = EXP_E;
-                }
-                // non-digit other than an 'E'?, no longer a valid numeric.
-                else if (inch < '0' || inch > '9')
-                {
-                    state = EXP_EXCLUDED;
-                }
-                // if we find a digit, the state is unchanged.
-                break;
+                // we need to back up the scan pointer to the sign position and
+                // stop...this is the end of the symbol.
+                lineOffset = eoffset;
+                break;                     /* and we're finished with this      */
             }
 
-            // we have a valid number up to an 'E'...now we can have digits or
-            // a sign for the exponent.  The digit will be handled here, but
-            // the +/- is either a symbol terminator or part of the symbol.
-            // we check that at the end-of-symbol processing
-            case EXP_E:
+            // have we reached the end of the line?  Also done.
+            if (!moreChars())
             {
-                // switching to process the exponent digits
-                if (inch >= '0' && inch <= '9')
-                {
-                    state = EXP_EDIGIT;
-                }
-                // we handle the sign situation below.
                 break;
             }
 
-            // we're scanning a potential numeric value, and we've just
-            // had the sign, so we're looking for digits after that.   If there
-            // are no digits, then the sign actually terminated the symbol, so
-            // we need to back up.
-            case EXP_ESIGN:
+            // get the next character and validate as a symbol character.
+            inch = getChar();
+            // if this was a good symbol character, run around the loop again and
+            // see how this impacts the state machine
+            if (translateChar(inch) != 0)
             {
-                // found a digit here?  switching into exponent scan mode.
-                if (inch >= '0' && inch <= '9')
-                {
-                    state = EXP_EDIGIT;
-                }
-                else
-                {
-                    // non-digit cannot be a number.
-                    state = EXP_EXCLUDED;
-                }
-                break;
+                continue;
             }
 
-            // scanning for exponent digits.  No longer numeric if we find a non-digit.
-            case EXP_EDIGIT:
+            // we have a non-symbol character abutting the symbol characters.  If
+            // we just scanned the 'E' (or 'e') in a potential exponent number,
+            // a '+' or '-' is potentially part of the symbol value.
+            if (state == EXP_E && (inch == '+' || inch == '-'))
             {
-                if (inch < '0' || inch > '9')
+                // the sign might be at the end of the line.  If there
+                // are no characters after that, no point in switching states.
+                if (!haveNextChar())
                 {
+                    // this is not a number and we've found the end position
                     state = EXP_EXCLUDED;
+                    break;
                 }
-                break;                   /* go get the next character         */
-            }
-
-            // once EXP_EXCLUDED is reached the state doesn't change.  We're
-            // just consuming symbol characters from here.
-        }
 
-        // handled all of the states, now handle the termination checks.
-        stepPosition();
-
-        // did we step past an exponential sign but found an invalid exponent?
-        if (eoffset != 0 && state == EXP_EXCLUDED)
-        {
-            // we need to back up the scan pointer to the sign position and
-            // stop...this is the end of the symbol.
-            lineOffset = eoffset;
-            break;                     /* and we're finished with this      */
-        }
-
-        // have we reached the end of the line?  Also done.
-        if (!moreChars())
-        {
-            break;
-        }
-
-        // get the next character and validate as a symbol character.
-        inch = getChar();
-        // if this was a good symbol character, run around the loop again and
-        // see how this impacts the state machine
-        if (translateChar(inch) != 0)
-        {
-            continue;
-        }
+                // this only works if there are only digits after this point.
+                // we need to remember this position in case we have to back up.
+                eoffset = lineOffset;
+                // step past the sign and switch the scanning state to look for
+                // the exponent digits after a sign.
+                stepPosition();
+                state = EXP_ESIGN;
+
+                // everything is all set up so we can back up.  Now get the next
+                // character and see how things go from here.
+                inch = getChar();
+                // if this was a good symbol character, run around the loop again and
+                // see how this impacts the state machine
+                if (translateChar(inch) != 0)
+                {
+                    continue;
+                }
 
-        // we have a non-symbol character abutting the symbol characters.  If
-        // we just scanned the 'E' (or 'e') in a potential exponent number,
-        // a '+' or '-' is potentially part of the symbol value.
-        if (state == EXP_E && (inch == '+' || inch == '-'))
-        {
-            // the sign might be at the end of the line.  If there
-            // are no characters after that, no point in switching states.
-            if (!haveNextChar())
-            {
-                // this is not a number and we've found the end position
+                // this is not a number...mark it so and also back up to before
+                // the sign position.
                 state = EXP_EXCLUDED;
+                // we need to back up the scan pointer to the sign position and
+                // stop...this is the end of the symbol.
+                lineOffset = eoffset;
                 break;
             }
-
-            // this only works if there are only digits after this point.
-            // we need to remember this position in case we have to back up.
-            eoffset = lineOffset;
-            // step past the sign and switch the scanning state to look for
-            // the exponent digits after a sign.
-            stepPosition();
-            state = EXP_ESIGN;
-
-            // everything is all set up so we can back up.  Now get the next
-            // character and see how things go from here.
-            inch = getChar();
-            // if this was a good symbol character, run around the loop again and
-            // see how this impacts the state machine
-            if (translateChar(inch) != 0)
+            else
             {
-                continue;
+                // We've reached a non-symbol character.  State remains in whatever
+                // the last state was.
+                break;
             }
-
-            // this is not a number...mark it so and also back up to before
-            // the sign position.
-            state = EXP_EXCLUDED;
-            // we need to back up the scan pointer to the sign position and
-            // stop...this is the end of the symbol.
-            lineOffset = eoffset;
-            break;
-        }
-        else
-        {
-            // We've reached a non-symbol character.  State remains in whatever
-            // the last state was.
-            break;
         }
     }
 
@@ -1478,35 +1513,12 @@ RexxToken *LanguageParser::scanSymbol()
 
     // lineOffset is now one character past the end of the symbol.
     size_t length = lineOffset - start;
-    // we're going to need to copy this into a string object.
-    RexxString *value = raw_string(length);
+    // get the uppercase name.  This only creates a new string the first
+    // time we see a symbol.
+    RexxString *value = internSymbol(start, length);
 
     // we also can tag numeric types.
     TokenSubclass numeric = SUBTYPE_NONE;
-
-    // ok, copy each character over, translating to uppercase.
-    for (size_t i = 0; i < length; i++)
-    {
-        inch = getChar(start + i);
-        unsigned int tran = translateChar(inch);
-        // if this translates ok, then this is a normal symbol
-        // character.
-        if (tran != 0)
-        {
-            value->putChar(i, tran);
-        }
-        else
-        {
-            // this is an exponent sign.  Use the original
-            value->putChar(i, inch);
-        }
-    }
-
-    // mark the value as being all uppercase.
-    value->setUpperOnly();
-    // get the common string value so we don't keep around multiple copies
-    // of variable names.
-    value = commonString(value);
     // record the current position in the clause
     clause->setEnd(lineNumber, lineOffset);
 
@@ -1597,6 +1609,118 @@ RexxToken *LanguageParser::scanSymbol()
 }
 
 
+/**
+ * Hash the uppercase form of a symbol name.
+ *
+ * @param name   The symbol characters (either source or already uppercase).
+ * @param length The symbol length.
+ *
+ * @return The hash value.
+ */
+static inline size_t hashSymbol(const unsigned char *name, size_t length)
+{
+    // FNV-1a over the uppercase characters
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ LanguageParser::upperSymbolChar(name[i])) * 16777619u;
+    }
+    return hash;
+}
+
+
+/**
+ * Get the string value for a symbol in the current line.  Names
+ * are interned in a table keyed by the source characters, so a
+ * symbol we've already seen is found without creating a new
+ * string object.
+ *
+ * @param start  The symbol start offset in the current line.
+ * @param length The symbol length.
+ *
+ * @return The uppercase symbol name string.
+ */
+RexxString *LanguageParser::internSymbol(size_t start, size_t length)
+{
+    const unsigned char *name = (const unsigned char *)current + start;
+    size_t mask = symbolTable->size() - 1;
+    size_t slot = hashSymbol(name, length) & mask;
+
+    // linear probe until we find the name or an empty slot
+    for (;;)
+    {
+        RexxString *entry = (RexxString *)symbolTable->get(slot + 1);
+        if (entry == OREF_NULL)
+        {
+            break;
+        }
+        if (entry->getLength() == length)
+        {
+            const char *data = entry->getStringData();
+            size_t i = 0;
+            while (i < length && (unsigned char)data[i] == upperSymbolChar(name[i]))
+            {
+                i++;
+            }
+            if (i == length)
+            {
+                return entry;
+            }
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // first time for this one, so build the uppercase name.
+    RexxString *value = raw_string(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        value->putChar(i, upperSymbolChar(name[i]));
+    }
+
+    // mark the value as being all uppercase.
+    value->setUpperOnly();
+    // get the common string value so we share this with any other
+    // strings the parser has created with the same value.
+    value = commonString(value);
+
+    symbolTable->put(value, slot + 1);
+    // keep the table no more than half full
+    if (++symbolCount * 2 > symbolTable->size())
+    {
+        expandSymbolTable();
+    }
+    return value;
+}
+
+
+/**
+ * Double the size of the symbol intern table, rehashing all of
+ * the existing names.
+ */
+void LanguageParser::expandSymbolTable()
+{
+    ArrayClass *oldTable = symbolTable;
+    size_t oldSize = oldTable->size();
+    ArrayClass *newTable = new_array(oldSize * 2);
+    size_t mask = newTable->size() - 1;
+
+    for (size_t i = 1; i <= oldSize; i++)
+    {
+        RexxString *entry = (RexxString *)oldTable->get(i);
+        if (entry != OREF_NULL)
+        {
+            size_t slot = hashSymbol((const unsigned char *)entry->getStringData(), entry->getLength()) & mask;
+            while (newTable->get(slot + 1) != OREF_NULL)
+            {
+                slot = (slot + 1) & mask;
+            }
+            newTable->put(entry, slot + 1);
+        }
+    }
+    symbolTable = newTable;
+}
+
+
 /**
  * Scan off a literal string (including hex or binary literals),
  * and return as a literal token.
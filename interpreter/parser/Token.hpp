@@ -310,7 +310,9 @@ typedef enum
     SUBKEY_STRICT,
     SUBKEY_TRUE,
     SUBKEY_FALSE,
-    SUBKEY_CASE
+    SUBKEY_CASE,
+    SUBKEY_OUTPUT,
+    SUBKEY_ERROR
 } InstructionSubKeyword;
 
 
@@ -383,6 +385,8 @@ typedef enum
     SUBDIRECTIVE_ROUTINE,
     SUBDIRECTIVE_CONSTANT,
     SUBDIRECTIVE_DELEGATE,
+    SUBDIRECTIVE_OPTIMIZE,
+    SUBDIRECTIVE_NOOPTIMIZE,
 } DirectiveSubKeyword;
 
 
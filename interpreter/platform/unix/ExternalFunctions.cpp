@@ -350,7 +350,13 @@ bool SystemInterpreter::invokeExternalFunction(
   RexxString     * calltype,           /* Type of call                      */
   ProtectedObject &result)
 {
-    if (activation->callMacroSpaceFunction(target, arguments, argcount, calltype, RXMACRO_SEARCH_BEFORE, result))
+    // a single macrospace query answers both the pre-order and post-order searches
+    unsigned short macroPosition;
+    size_t macroGeneration;
+    bool inMacroSpace = PackageManager::queryMacroSpace(target, macroPosition, macroGeneration);
+
+    if (inMacroSpace && macroPosition != RXMACRO_SEARCH_AFTER &&
+        activation->callMacroSpaceFunction(target, arguments, argcount, calltype, macroGeneration, result))
     {
         return true;
     }
@@ -366,7 +372,8 @@ bool SystemInterpreter::invokeExternalFunction(
     }
     /* function.  If still not found,    */
     /* then raise an error               */
-    if (activation->callMacroSpaceFunction(target, arguments, argcount, calltype, RXMACRO_SEARCH_AFTER, result))
+    if (inMacroSpace && macroPosition == RXMACRO_SEARCH_AFTER &&
+        activation->callMacroSpaceFunction(target, arguments, argcount, calltype, macroGeneration, result))
     {
         return true;
     }
@@ -90,6 +90,24 @@ public:
         sched_yield();
     }
 
+    // a hint to the processor that we're in a spin-wait loop
+    static inline void relax()
+    {
+#if defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    // a monotonic clock in microseconds
+    static inline uint64_t getMicroseconds()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    }
+
 protected:
     pthread_t     threadId;         // the thread identifier
 };
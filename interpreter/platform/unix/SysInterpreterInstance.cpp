@@ -67,6 +67,19 @@ void SysInterpreterInstance::initialize(InterpreterInstance *i, RexxOption *opti
         }
     }
 
+    // RXSTARTWORKERS bounds the threads used to run started messages.
+    // A worker only gives up its place while it waits on a GUARD or a
+    // message result.  A started message that blocks inside native code
+    // (a command, an exit, or an external function or method waiting on
+    // another started message) keeps its worker, so enough such
+    // messages can stall everything still queued behind them.
+    const char *startWorkersBuf = getenv("RXSTARTWORKERS");
+    if (startWorkersBuf != NULL)
+    {
+        long workers = atol(startWorkersBuf);
+        instance->startWorkers = workers > 0 ? (size_t)workers : 0;
+    }
+
     // add our default search extension as both upper and lower case
     addSearchExtension(".REX");
     addSearchExtension(".rex");
@@ -42,11 +42,19 @@
 /*                                                                            */
 /******************************************************************************/
 
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
 #include <string.h>
 #include <sys/wait.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
 
 #include "RexxCore.h"
 #include "StringClass.hpp"
@@ -55,6 +63,7 @@
 #include "SystemInterpreter.hpp"
 #include "InterpreterInstance.hpp"
 #include "SysInterpreterInstance.hpp"
+#include "CommandHandler.hpp"
 
 #include "RexxInternalApis.h"
 #include <sys/types.h>
@@ -63,6 +72,7 @@
 
 #define CMDBUFSIZE 1024                     /* Max size of executable cmd     */
 #define MAX_COMMAND_ARGS 400
+#define CAPTURE_CHUNK 65536                 /* pipe read size for captured output */
 
 #if defined(AIX)
 #define CMDDEFNAME "/bin/ksh"               /* Korn shell is default for AIX */
@@ -516,15 +526,14 @@ bool sys_process_cd(RexxExitContext *context, const char * cmd, RexxObjectPtr rc
 
 /*********************************************************************/
 /* This function breaks a command up into whitespace-delimited pieces*/
-/* to create the pointer array for the execvp call.  It is only used */
-/* to support the "COMMAND" command environment, which does not use  */
-/* a shell to invoke its commands.                                   */
+/* to create the pointer array for the posix_spawnp call.  It is used*/
+/* for the "COMMAND" command environment, which does not use a shell */
+/* to invoke its commands, and for shell commands simple enough to   */
+/* run without one.  The command buffer is modified in place.        */
 /*********************************************************************/
 
-bool scan_cmd(const char *parm_cmd, char **argPtr)
+bool scan_cmd(char *cmd, char **argPtr)
 {
-    char *cmd = strdup(parm_cmd);        /* Allocate for copy          */
-
     char *end = cmd + strlen(cmd);       /* Find the end of the command*/
 
     /* This loop scans our copy of the command, setting pointers in    */
@@ -571,6 +580,274 @@ bool scan_cmd(const char *parm_cmd, char **argPtr)
     return true;
 }
 
+/*********************************************************************/
+/* Characters that only a shell knows how to deal with.  A command   */
+/* without any of these is just a program name and blank delimited   */
+/* arguments, so it can be started directly.                         */
+/*********************************************************************/
+#define SHELL_METACHARS "|&;<>()$`\\\"'*?[]#~{}!\n"
+
+
+/**
+ * Test whether a command needs to be passed through a shell.
+ *
+ * @param cmd    The command string.
+ *
+ * @return true if the command uses any shell syntax.
+ */
+static bool needsShell(const char *cmd)
+{
+    if (strpbrk(cmd, SHELL_METACHARS) != NULL)
+    {
+        return true;
+    }
+    // a leading "name=value" word is a shell variable assignment
+    cmd += strspn(cmd, " \t");
+    const char *equal = strchr(cmd, '=');
+    return equal != NULL && equal < cmd + strcspn(cmd, " \t");
+}
+
+
+/**
+ * Map an address environment name to the shell that
+ * interprets its commands.
+ *
+ * @param envName The address environment name.
+ *
+ * @return The shell path, or NULL for the "cmd" environment, which
+ *         never uses a shell.
+ */
+static const char *shellPath(const char *envName)
+{
+    if (Utilities::strCaselessCompare("ksh", envName) == 0)
+    {
+        return "/bin/ksh";
+    }
+    else if (Utilities::strCaselessCompare("bsh", envName) == 0)
+    {
+        return "/bin/bsh";
+    }
+    else if (Utilities::strCaselessCompare("csh", envName) == 0)
+    {
+        return "/bin/csh";
+    }
+    else if (Utilities::strCaselessCompare("bash", envName) == 0)
+    {
+        return "/bin/bash";
+    }
+    else if (Utilities::strCaselessCompare("cmd", envName) == 0)
+    {
+        return NULL;
+    }
+    return "/bin/sh";
+}
+
+
+/**
+ * Create a close-on-exec pipe for capturing a command output
+ * stream.  The child only sees the write end through the dup2
+ * file action, which clears the close-on-exec flag.  pipe2()
+ * sets the flag atomically, so a command spawned at the same
+ * time from another activity can't inherit the pipe and hold
+ * it open.
+ *
+ * @param fds    The returned pipe descriptors.
+ *
+ * @return true if the pipe was created.
+ */
+static bool capturePipe(int fds[2])
+{
+#ifdef HAVE_PIPE2
+    return pipe2(fds, O_CLOEXEC) == 0;
+#else
+    if (pipe(fds) != 0)
+    {
+        return false;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#endif
+}
+
+
+/**
+ * Drain the capture pipes of a running command until the
+ * command closes them.  Both pipes are read together so that a
+ * command filling one of them cannot block us.
+ *
+ * @param capture The capture buffers.
+ * @param outFd   The stdout pipe read end (or -1).
+ * @param errFd   The stderr pipe read end (or -1).
+ */
+static void drainCapturePipes(CommandIOCapture *capture, int outFd, int errFd)
+{
+    char buffer[CAPTURE_CHUNK];
+    struct pollfd fds[2];
+
+    while (outFd != -1 || errFd != -1)
+    {
+        nfds_t count = 0;
+        if (outFd != -1)
+        {
+            fds[count].fd = outFd;
+            fds[count].events = POLLIN;
+            count++;
+        }
+        if (errFd != -1)
+        {
+            fds[count].fd = errFd;
+            fds[count].events = POLLIN;
+            count++;
+        }
+
+        if (poll(fds, count, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        for (nfds_t i = 0; i < count; i++)
+        {
+            if (fds[i].revents == 0)
+            {
+                continue;
+            }
+            ssize_t len = read(fds[i].fd, buffer, sizeof(buffer));
+            if (len < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            bool isOutput = fds[i].fd == outFd;
+            // end of data (or a broken pipe) closes this stream
+            if (len <= 0)
+            {
+                close(fds[i].fd);
+                if (isOutput)
+                {
+                    outFd = -1;
+                }
+                else
+                {
+                    errFd = -1;
+                }
+                continue;
+            }
+            (isOutput ? capture->output : capture->error).append(buffer, (size_t)len);
+        }
+    }
+
+    // close anything left open after a poll failure
+    if (outFd != -1)
+    {
+        close(outFd);
+    }
+    if (errFd != -1)
+    {
+        close(errFd);
+    }
+}
+
+
+/**
+ * Run a command as a child process and wait for it to complete.
+ * This uses posix_spawn rather than a full fork() of the
+ * interpreter process, which is expensive for a large process
+ * even with copy-on-write.
+ *
+ * @param program The program to run.  This is searched for on the PATH.
+ * @param args    The NULL terminated argument vector.
+ * @param capture Optional output capture buffers.
+ * @param errCode The returned command return code.
+ *
+ * @return false if the program could not be started.
+ */
+static bool spawnCommand(const char *program, char **args, CommandIOCapture *capture, int &errCode)
+{
+    int outPipe[2] = { -1, -1 };
+    int errPipe[2] = { -1, -1 };
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+#ifdef POSIX_SPAWN_USEVFORK
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_USEVFORK);
+#endif
+
+    if (capture != NULL && capture->output.active && capturePipe(outPipe))
+    {
+        posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+    }
+    if (capture != NULL && capture->error.active && capturePipe(errPipe))
+    {
+        posix_spawn_file_actions_adddup2(&actions, errPipe[1], STDERR_FILENO);
+    }
+
+    pid_t pid;
+    int spawnRc = posix_spawnp(&pid, program, &actions, &attributes, args, getEnvironment());
+
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attributes);
+
+    // the write ends belong to the child now
+    if (outPipe[1] != -1)
+    {
+        close(outPipe[1]);
+    }
+    if (errPipe[1] != -1)
+    {
+        close(errPipe[1]);
+    }
+
+    if (spawnRc != 0)
+    {
+        if (outPipe[0] != -1)
+        {
+            close(outPipe[0]);
+        }
+        if (errPipe[0] != -1)
+        {
+            close(errPipe[0]);
+        }
+        return false;
+    }
+
+    if (outPipe[0] != -1 || errPipe[0] != -1)
+    {
+        drainCapturePipes(capture, outPipe[0], errPipe[0]);
+    }
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+        {
+            errCode = UNKNOWN_COMMAND;
+            return true;
+        }
+    }
+
+    if (WIFEXITED(status))               /* If cmd process ended normal       */
+    {
+        errCode = WEXITSTATUS(status);   /* Give 'em the exit code            */
+    }
+    else                                 /* Else process died ugly, so        */
+    {
+        errCode = -(WTERMSIG(status));
+        if (errCode == 1)                /* If process was stopped            */
+        {
+            errCode = -1;                /* Give 'em a -1.                    */
+        }
+    }
+    return true;
+}
+
+
+
 /******************************************************************************/
 /* Name:       sys_command                                                    */
 /*                                                                            */
@@ -580,8 +857,9 @@ bool scan_cmd(const char *parm_cmd, char **argPtr)
 /* Returned:   rc - Return Code                                               */
 /*                                                                            */
 /* Notes:      Handles processing of a system command.                        */
-/*             Uses the 'fork' and 'exec' system calls to create a new process*/
-/*             and invoke the shell indicated by the local_env_type argument. */
+/*             Uses posix_spawn to create a new process running the shell     */
+/*             indicated by the address environment, or the program itself   */
+/*             when the command uses no shell syntax.                         */
 /*             This is modeled after command handling done in Classic REXX.   */
 /******************************************************************************/
 RexxObjectPtr RexxEntry systemCommandHandler(RexxExitContext *context, RexxStringObject address, RexxStringObject command)
@@ -689,78 +967,43 @@ RexxObjectPtr RexxEntry systemCommandHandler(RexxExitContext *context, RexxStrin
         envName = SYSINITIALADDRESS;
     }
 
-    int errCode = 0;
-#ifdef LINUX
+    // the ADDRESS instruction may have asked for the output to be captured
+    CommandIOCapture *capture = contextToActivity(context)->getCommandCapture();
 
-    if (Utilities::strCaselessCompare("bash", envName) == 0)
+    int errCode = 0;
+    const char *shell = shellPath(envName);
+    // the shells only get involved if the command actually needs one.
+    bool started = false;
+    if (shell == NULL || !needsShell(cmd))
     {
-        errCode = system( cmd );
-        if ( errCode >= 256 )
+        char *cmdCopy = strdup(cmd);
+        char *args[MAX_COMMAND_ARGS + 1];     /* Array for argument parsing */
+        if (cmdCopy != NULL && scan_cmd(cmdCopy, args) && args[0] != NULL)
         {
-            errCode = errCode / 256;
+            started = spawnCommand(args[0], args, capture, errCode);
+        }
+        free(cmdCopy);
+        // the cmd environment reports a program it can't start as an error,
+        // as it always did
+        if (!started && shell == NULL)
+        {
+            errCode = 1;
+            started = true;
         }
     }
-    else
-#endif
-    {
-        int pid = fork();
-        int status;
 
-        if (pid != 0)                         /* spawn a child process to run the  */
+    // if this needs a shell or wasn't found as a program (it might be a shell
+    // builtin), pass this to the shell, which also gives the standard messages.
+    if (!started)
+    {
+        // the program name is the last part of the shell path
+        const char *shellArgs[] = { strrchr(shell, '/') + 1, "-c", cmd, NULL };
+        if (!spawnCommand(shell, (char **)shellArgs, capture, errCode))
         {
-            waitpid ( pid, &status, 0);          /* command and wait for it to finish */
-            if (WIFEXITED(status))               /* If cmd process ended normal       */
-            {
-                                                 /* Give 'em the exit code            */
-                errCode = WEXITSTATUS(status);
-            }
-            else                              /* Else process died ugly, so        */
-            {
-                errCode = -(WTERMSIG(status));
-                if (errCode == 1)                    /* If process was stopped            */
-                {
-                    errCode = -1;                   /* Give 'em a -1.                    */
-                }
-            }
-        }
-        else
-        {                                /* run the command in the child      */
-            if (Utilities::strCaselessCompare("sh", envName) == 0)
-            {
-                execl("/bin/sh", "sh", "-c", cmd, NULL);
-            }
-            else if (Utilities::strCaselessCompare("ksh", envName) == 0)
-            {
-                execl("/bin/ksh", "ksh", "-c", cmd, NULL);
-            }
-            else if (Utilities::strCaselessCompare("bsh", envName) == 0)
-            {
-                execl("/bin/bsh", "bsh", "-c", cmd, NULL);
-            }
-            else if (Utilities::strCaselessCompare("csh", envName) == 0)
-            {
-                execl("/bin/csh", "csh", "-c", cmd, NULL);
-            }
-            else if (Utilities::strCaselessCompare("bash", envName) == 0)
-            {
-                execl("/bin/bash", "bash", "-c", cmd, NULL);
-            }
-            else if (Utilities::strCaselessCompare("cmd", envName) == 0)
-            {
-                char * args[MAX_COMMAND_ARGS+1];      /* Array for argument parsing */
-                if (!scan_cmd(cmd, args))             /* Parse cmd into arguments  */
-                {
-                    exit(1);
-                }
-                execvp(args[0], args);           /* Invoke command directly   */
-                exit(1);                         /* we couldn't run the       */
-            }
-            else
-            {
-                execl("/bin/sh", "sh", "-c", cmd, NULL);
-            }
+            errCode = UNKNOWN_COMMAND;
         }
     }
+
     // unknown command code?
     if (errCode == UNKNOWN_COMMAND)
     {
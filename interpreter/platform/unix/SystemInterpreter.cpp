@@ -42,6 +42,8 @@
 #include "SystemInterpreter.hpp"
 #include "Interpreter.hpp"
 #include "GlobalNames.hpp"
+#include "ActivityManager.hpp"
+#include "Utilities.hpp"
 
 sigset_t SystemInterpreter::oldmask;
 sigset_t SystemInterpreter::newmask;
@@ -50,6 +52,20 @@ class InterpreterInstance;
 
 void SystemInterpreter::processStartup()
 {
+    // RXTIMESLICE is how many milliseconds a thread keeps the kernel lock
+    // while others are waiting, RXLOCKFAIR=OFF lets new requests jump the queue
+    const char *option = getenv("RXTIMESLICE");
+    if (option != NULL)
+    {
+        long slice = atol(option);
+        ActivityManager::setTimeSlice(slice > 0 ? (uint64_t)slice * 1000 : 0);
+    }
+    option = getenv("RXLOCKFAIR");
+    if (option != NULL && !Utilities::strCaselessCompare(option, "OFF"))
+    {
+        ActivityManager::setFairKernelLock(false);
+    }
+
     // now do the platform independent startup
     Interpreter::processStartup();
 }
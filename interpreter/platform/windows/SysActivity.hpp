@@ -71,6 +71,18 @@ public:
         Sleep(1);
     }
 
+    // a hint to the processor that we're in a spin-wait loop
+    static inline void relax()
+    {
+        YieldProcessor();
+    }
+
+    // a monotonic clock in microseconds
+    static inline uint64_t getMicroseconds()
+    {
+        return (uint64_t)GetTickCount64() * 1000;
+    }
+
 protected:
     thread_id_t   threadId;         // the thread identifier
     HANDLE        hThread;          // handle to thread (needed for some operations)
@@ -110,6 +110,19 @@ void SysInterpreterInstance::initialize(InterpreterInstance *i, RexxOption *opti
         }
     }
 
+    // RXSTARTWORKERS bounds the threads used to run started messages.
+    // A worker only gives up its place while it waits on a GUARD or a
+    // message result.  A started message that blocks inside native code
+    // (a command, an exit, or an external function or method waiting on
+    // another started message) keeps its worker, so enough such
+    // messages can stall everything still queued behind them.
+    TCHAR startWorkersBuf[16];
+    if (GetEnvironmentVariable("RXSTARTWORKERS", startWorkersBuf, 16))
+    {
+        long workers = atol(startWorkersBuf);
+        instance->startWorkers = workers > 0 ? (size_t)workers : 0;
+    }
+
     // Because of using the stand-alone runtime library or when using different compilers,
     // the std-streams of the calling program and the REXX.DLL might be located at different
     // addresses and therefore _file might be -1. If so, std-streams are reassigned to the
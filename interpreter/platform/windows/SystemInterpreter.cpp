@@ -49,6 +49,8 @@
 #include "RexxCore.h"
 #include "SystemInterpreter.hpp"
 #include "Interpreter.hpp"
+#include "ActivityManager.hpp"
+#include "Utilities.hpp"
 
 ULONG SystemInterpreter::exceptionHostProcessId = 0;
 HANDLE SystemInterpreter::exceptionHostProcess = NULL;
@@ -69,6 +71,12 @@ HINSTANCE SystemInterpreter::moduleHandle = 0;      // handle to the interpeter
 void SystemInterpreter::processStartup(HINSTANCE mod)
 {
     moduleHandle = mod;
+    // RXLOCKFAIR=OFF lets new kernel lock requests jump the queue
+    TCHAR option[8];
+    if (GetEnvironmentVariable("RXLOCKFAIR", option, 8) && !Utilities::strCaselessCompare(option, "OFF"))
+    {
+        ActivityManager::setFairKernelLock(false);
+    }
     // startup timeslice processing
     startTimeSlice();
     // now do the platform independent startup
@@ -51,6 +51,7 @@
 #include "PackageClass.hpp"
 #include "WeakReferenceClass.hpp"
 #include "RoutineClass.hpp"
+#include "MessageClass.hpp"
 
 
 /**
@@ -99,6 +100,7 @@ void InterpreterInstance::live(size_t liveMark)
     memory_mark(localEnvironment);
     memory_mark(commandHandlers);
     memory_mark(requiresFiles);
+    memory_mark(pendingStarts);
 }
 
 
@@ -120,6 +122,7 @@ void InterpreterInstance::liveGeneral(MarkReason reason)
     memory_mark_general(localEnvironment);
     memory_mark_general(commandHandlers);
     memory_mark_general(requiresFiles);
+    memory_mark_general(pendingStarts);
 }
 
 
@@ -138,6 +141,9 @@ void InterpreterInstance::initialize(Activity *activity, RexxOption *options)
     allActivities = new_queue();
     searchExtensions = new_array();       // this will be filled in during options processing
     requiresFiles = new_string_table();   // our list of loaded requires packages
+    pendingStarts = new_queue();          // only used when the start scheduler is bounded
+    startWorkers = 0;                     // a thread per start unless the platform says otherwise
+    runningStartWorkers = 0;
     // this gets added to the entire active list.
     allActivities->append(activity);
     // create a default wrapper for this security manager
@@ -307,6 +313,99 @@ Activity *InterpreterInstance::spawnActivity(Activity *parent)
 }
 
 
+/**
+ * Obtain an activity to run a started message on.  Normally
+ * every start gets a fresh activity (and thread).  If the
+ * instance has a bounded start scheduler, the message is
+ * handed to a new worker only while fewer than startWorkers
+ * are running; otherwise it is queued and picked up by the
+ * next worker that finishes or parks.
+ *
+ * @param parent  The activity issuing the start.
+ * @param message The message being started.
+ *
+ * @return The activity to run the message on, or OREF_NULL if the
+ *         message has been queued.
+ */
+Activity *InterpreterInstance::scheduleStart(Activity *parent, MessageClass *message)
+{
+    if (startWorkers == 0)
+    {
+        return spawnActivity(parent);
+    }
+
+    if (runningStartWorkers >= startWorkers)
+    {
+        pendingStarts->append(message);
+        return OREF_NULL;
+    }
+
+    Activity *worker = spawnActivity(parent);
+    worker->setStartWorker(true);
+    runningStartWorkers++;
+    return worker;
+}
+
+
+/**
+ * Called by a start worker when it finishes a message.  Returns
+ * the next queued message for the worker to run, or OREF_NULL if
+ * the worker should retire.  A worker that was unparked while the
+ * pool was full retires here so the pool shrinks back to its
+ * bound.
+ *
+ * @param worker The worker activity.
+ *
+ * @return The next message to run, or OREF_NULL.
+ */
+MessageClass *InterpreterInstance::nextStart(Activity *worker)
+{
+    if (runningStartWorkers <= startWorkers && !pendingStarts->isEmpty())
+    {
+        return (MessageClass *)pendingStarts->pull();
+    }
+
+    runningStartWorkers--;
+    worker->setStartWorker(false);
+    return OREF_NULL;
+}
+
+
+/**
+ * A start worker is about to block on a GUARD or message result
+ * wait.  It no longer counts against the bound, so if there is
+ * queued work, hand the next message to a new worker.  This keeps
+ * a message that waits on a queued message from deadlocking the
+ * pool.  Blocking inside native code does not park the worker:
+ * the interpreter cannot tell a native call that waits from one
+ * that is just slow, and parking on every native call would let
+ * the pool grow without bound.
+ *
+ * @param worker The worker that is blocking.
+ */
+void InterpreterInstance::parkStartWorker(Activity *worker)
+{
+    runningStartWorkers--;
+    if (runningStartWorkers < startWorkers && !pendingStarts->isEmpty())
+    {
+        MessageClass *message = (MessageClass *)pendingStarts->pull();
+        Activity *newWorker = spawnActivity(worker);
+        newWorker->setStartWorker(true);
+        runningStartWorkers++;
+        message->dispatchStart(newWorker);
+    }
+}
+
+
+/**
+ * A parked start worker has been woken up and is running again.
+ */
+void InterpreterInstance::unparkStartWorker()
+{
+    runningStartWorkers++;
+}
+
+
 /**
  * Return a spawned activity back to the activity pool.  This
  * will disassociate the activity from the interpreter instance
@@ -944,6 +1043,50 @@ PackageClass *InterpreterInstance::loadRequires(Activity *activity, RexxString *
 }
 
 
+/**
+ * Load a ::requires package that was compiled into a bundled
+ * image into this interpreter instance.
+ *
+ * @param activity  The current activity we're loading on.
+ * @param shortName The original short name of this package.
+ * @param bundled   The package from the image.
+ *
+ * @return The loaded package class.
+ */
+PackageClass *InterpreterInstance::loadRequires(Activity *activity, RexxString *shortName, PackageClass *bundled)
+{
+    // if we've already loaded this in this instance, just return it.
+    Protected<PackageClass> package = getRequiresFile(activity, shortName);
+    if (!package.isNull())
+    {
+        return package;
+    }
+
+    // the bundled package remembers the file it was compiled from
+    RexxString *fullName = bundled->getProgramName();
+    package = getRequiresFile(activity, fullName);
+    if (!package.isNull())
+    {
+        addRequiresFile(shortName, OREF_NULL, package);
+        return package;
+    }
+
+    Protected<PackageClass> p;
+    package = PackageManager::loadRequires(activity, shortName, bundled, p);
+    if (package.isNull())
+    {
+        reportException(Error_Routine_not_found_requires, shortName);
+    }
+
+    // make sure we lock this package until we finish running the requires.
+    GuardLock lock(activity, package, ThePackageClass);
+    addRequiresFile(shortName, fullName, package);
+    // for any requires file loaded to this instance, we run the prolog within the instance.
+    package->runProlog(activity);
+    return package;
+}
+
+
 /**
  * Load a ::requires file into this interpreter instance.
  *
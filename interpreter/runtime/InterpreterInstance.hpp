@@ -52,6 +52,7 @@ class DirectoryClass;
 class CommandHandler;
 class PackageClass;
 class RoutineClass;
+class MessageClass;
 
 class InterpreterInstance : public RexxInternalObject
 {
@@ -86,6 +87,10 @@ public:
     bool detachThread();
     bool detachThread(Activity *activity);
     Activity *spawnActivity(Activity *parent);
+    Activity *scheduleStart(Activity *parent, MessageClass *message);
+    MessageClass *nextStart(Activity *worker);
+    void parkStartWorker(Activity *worker);
+    void unparkStartWorker();
     void exitCurrentThread();
     Activity *findActivity(thread_id_t threadId);
     Activity *findActivity();
@@ -117,6 +122,7 @@ public:
     PackageClass *loadRequires(Activity *activity, RexxString *shortName, ArrayClass *source);
     PackageClass *loadRequires(Activity *activity, RexxString *shortName, RexxString *fullName);
     PackageClass *loadRequires(Activity *activity, RexxString *shortName, const char *data, size_t length);
+    PackageClass *loadRequires(Activity *activity, RexxString *shortName, PackageClass *bundled);
     void          addRequiresFile(RexxString *shortName, RexxString *fullName, PackageClass *package);
     inline void   setupProgram(RexxActivation *activation)
     {
@@ -141,6 +147,9 @@ protected:
     DirectoryClass      *localEnvironment;   // the current local environment
     StringTable         *commandHandlers;    // our list of command environment handlers
     StringTable         *requiresFiles;      // our list of requires files used by this instance
+    QueueClass          *pendingStarts;      // started messages waiting for a free start worker
+    size_t               startWorkers;       // maximum running start workers (0 is a thread per start)
+    size_t               runningStartWorkers; // start workers currently running (not parked)
 
     bool terminating;                        // shutdown indicator
     bool terminated;                         // last thread cleared indicator
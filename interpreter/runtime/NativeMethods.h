@@ -83,6 +83,10 @@
    INTERNAL_METHOD(rexx_pull_queue)
    INTERNAL_METHOD(rexx_linein_queue)
    INTERNAL_METHOD(rexx_clear_queue)
+   INTERNAL_METHOD(serialize_pack)
+   INTERNAL_METHOD(serialize_unpack)
+   INTERNAL_METHOD(serialize_save)
+   INTERNAL_METHOD(serialize_restore)
    INTERNAL_METHOD(file_separator)
    INTERNAL_METHOD(file_path_separator)
    INTERNAL_METHOD(file_case_sensitive)
@@ -143,6 +143,7 @@ public:
     static wholenumber_t fuzz()   { return settings->getFuzz(); }
     static bool   form()   { return settings->getForm(); }
     static void   setCurrentSettings(const NumericSettings *s) { settings = s; }
+    static const NumericSettings *getCurrentSettings() { return settings; }
     static const NumericSettings *setDefaultSettings() { settings = &defaultSettings; return settings; }
     static const NumericSettings *getDefaultSettings() { return &defaultSettings; }
     static inline wholenumber_t abs(wholenumber_t n) { return n < 0 ? -n : n; }
@@ -185,6 +186,30 @@ protected:
 };
 
 
+/**
+ * A class that switches the current numeric settings inside a
+ * block and restores the previous settings once the
+ * NumericSettingsBlock object goes out of scope, including
+ * during exception unwind.
+ */
+class NumericSettingsBlock
+{
+public:
+    NumericSettingsBlock(const NumericSettings *s)
+    {
+        savedSettings = Numerics::getCurrentSettings();
+        Numerics::setCurrentSettings(s);
+    }
+
+    ~NumericSettingsBlock()
+    {
+        Numerics::setCurrentSettings(savedSettings);
+    }
+protected:
+    const NumericSettings *savedSettings;
+};
+
+
 inline wholenumber_t number_digits() { return Numerics::digits(); }
 inline wholenumber_t number_fuzz()   { return Numerics::fuzz(); }
 inline bool   number_form()   { return Numerics::form(); }
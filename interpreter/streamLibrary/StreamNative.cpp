@@ -396,16 +396,31 @@ void StreamInfo::eof()
  */
 void StreamInfo::eof(RexxObjectPtr result)
 {
-    /* place this in an eof state        */
-    state = StreamEof;
-    /* raise this as a notready condition*/
-    context->RaiseCondition("NOTREADY", context->String(stream_name), self, result);
+    raiseEof(result);
 
     // if a result object was given, the caller's not expecting control back, so
     // throw an exception to unwind.
     throw this;
 }
 
+
+/**
+ * Place the stream in an eof state and raise the NotReady
+ * condition, returning to the caller.  The condition is
+ * delivered to the caller's traps when the method returns, so
+ * read operations that have nothing left to clean up can use
+ * this to avoid unwinding with a C++ exception.
+ *
+ * @param result  A result object returned with the NotReady condition.
+ */
+void StreamInfo::raiseEof(RexxObjectPtr result)
+{
+    /* place this in an eof state        */
+    state = StreamEof;
+    /* raise this as a notready condition*/
+    context->RaiseCondition("NOTREADY", context->String(stream_name), self, result);
+}
+
 /**
  * Raise the appropriate not ready condition, checking first for an eof
  * condition.
@@ -741,6 +756,7 @@ void StreamInfo::resetFields()
     lineReadCharPosition = 1;
     lineWriteCharPosition = 1;
     nobuffer = false;
+    async = false;
     last_op_was_read = true;
     transient = false;
     record_based = false;
@@ -1321,6 +1337,14 @@ RexxStringObject StreamInfo::readVariableLine()
         size_t bytesRead = 0;
         if (!fileInfo.gets(readPosition, bufferSize - currentLength, bytesRead))
         {
+            // nothing read at all and we're at the end of the stream.  This is the
+            // usual way a read loop finishes, so just raise the NOTREADY and return
+            // rather than unwinding.
+            if (currentLength == 0 && fileInfo.atEof())
+            {
+                raiseEof(defaultResult);
+                return context->NullString();
+            }
             checkEof();
         }
         // update the size of the line now
@@ -1494,7 +1518,7 @@ RexxStringObject StreamInfo::charin(bool _setPosition, int64_t position, size_t
     // notready condition
     if (bytesRead < read_length)
     {
-        eof(res);
+        raiseEof(res);
     }
     return res;
 }
@@ -2227,6 +2251,7 @@ const char *StreamInfo::streamOpen(const char *options)
             ParseAction(MEB, read_write),
             ParseAction(MEB, write_only),
             ParseAction(MEB, append),
+            ParseAction(MEB, async),
             ParseAction(ME, oflag, RX_O_TRUNC),
             ParseAction(SetBool, read_only, true),
             ParseAction(BitOr, oflag, RX_O_RDONLY),
@@ -2264,9 +2289,16 @@ const char *StreamInfo::streamOpen(const char *options)
             ParseAction()
         };
         ParseAction OpenActionnobuffer[] = {
+            ParseAction(MEB, async),
             ParseAction(SetBool, nobuffer, true),
             ParseAction()
         };
+        ParseAction OpenActionasync[] = {
+            ParseAction(MEB, read_only),
+            ParseAction(MEB, nobuffer),
+            ParseAction(SetBool, async, true),
+            ParseAction()
+        };
         ParseAction OpenActionbinary[] = {
             ParseAction(MEB, record_based, true),
             ParseAction(SetBool, record_based, true),
@@ -2327,6 +2359,7 @@ const char *StreamInfo::streamOpen(const char *options)
             TokenDefinition("APPEND",2,    OpenActionappend),
             TokenDefinition("REPLACE",3,   OpenActionreplace),
             TokenDefinition("NOBUFFER",3,  OpenActionnobuffer),
+            TokenDefinition("ASYNC",2,     OpenActionasync),
             TokenDefinition("BINARY",2,    OpenActionbinary),
             TokenDefinition("RECLENGTH",3, OpenActionreclength),
             TokenDefinition("SHARED",6,    OpenActionshared),
@@ -2495,6 +2528,12 @@ const char *StreamInfo::streamOpen(const char *options)
         lineWritePosition = 0;
         lineWriteCharPosition = 0;
     }
+    // hand the output off to a background writer if requested.  If this
+    // isn't possible, the writes are just done synchronously.
+    if (async)
+    {
+        fileInfo.setWriteBehind(true);
+    }
     /* this is now ready                 */
     state = StreamReady;
     /* go process the stream type        */
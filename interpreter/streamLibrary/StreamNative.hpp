@@ -99,6 +99,7 @@ public:
     void  raiseException(int err, RexxObjectPtr sub1, RexxObjectPtr sub2);
     void  eof(RexxObjectPtr);
     void  eof();
+    void  raiseEof(RexxObjectPtr);
     void  checkEof();
     void  checkStreamType();
     void  close();
@@ -191,6 +192,7 @@ protected:
    bool read_write;
    bool append;
    bool nobuffer;
+   bool async;                         // write-behind output
    bool stdstream;                     // true if a standard I/O stream
    bool last_op_was_read;              // still needed?
    bool opened_as_handle;              // given a handle directly
@@ -51,6 +51,7 @@ int REXXENTRY RexxResolveExit(const char *, REXXPFN *);
 int REXXENTRY RexxResolveRoutine(const char *, REXXPFN *);
 
 RexxReturnCode REXXENTRY RexxResolveMacroFunction (const char *, PRXSTRING );
+RexxReturnCode REXXENTRY RexxQueryMacroGeneration(const char *, unsigned short *, size_t *);
 void REXXENTRY RexxCreateInterpreterImage();
 
 RexxReturnCode REXXENTRY RexxLoadSubcom(const char *, const char *);
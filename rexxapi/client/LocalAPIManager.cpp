@@ -62,6 +62,13 @@ LocalAPIManager *LocalAPIManager::getInstance()
         // to the process-specific initialization now.
         singleInstance->initProcess();
     }
+    // if this process was forked from the one that set up the API state, the
+    // connection pool and session belong to the parent.  Start over fresh.
+    else if (singleInstance->session != SysProcess::getPid())
+    {
+        singleInstance->resetAfterFork();
+        singleInstance->initProcess();
+    }
     else {
         // if we shut everything down at interpreter termination, reestablish the connections.
         if (singleInstance->restartRequired)
@@ -85,6 +92,13 @@ void LocalAPIManager::shutdownInstance()
     Lock lock(messageLock);                     // make sure we single thread this
     if (singleInstance != NULL)
     {
+        // a forked child that never used the API has nothing of its own to
+        // shut down, and the connections belong to the parent.
+        if (singleInstance->session != SysProcess::getPid())
+        {
+            singleInstance->resetAfterFork();
+            return;
+        }
         // shutdown any connections with the server
         singleInstance->shutdownConnections();
         // mark that we need a restart
@@ -169,6 +183,28 @@ void LocalAPIManager::shutdownConnections()
 }
 
 
+/**
+ * Drop the process state after we find ourselves running in a
+ * child process forked from the one that initialized the API.
+ * The pooled connections are copies of the parent's sockets, so
+ * we just close our handles without telling the server.  The
+ * next use reinitializes using this process's identity.
+ */
+void LocalAPIManager::resetAfterFork()
+{
+    while (!connections.empty())
+    {
+        SysClientStream *connection = connections.front();
+        connections.pop_front();
+        connection->close();
+        delete connection;
+    }
+    connectionEstablished = false;
+    // the session queue is the parent's, we need one of our own
+    queueManager.resetAfterFork();
+}
+
+
 /**
  * Perform process-specific client API initialization.
  */
@@ -73,6 +73,7 @@ public:
     void initProcess();
     void terminateProcess();
     void shutdownConnections();
+    void resetAfterFork();
 
     inline SessionID getSession() { return session; }
     inline void getUserID(char *buffer) { strcpy(buffer, userid); }
@@ -519,10 +519,29 @@ RexxReturnCode LocalMacroSpaceManager::removeMacro(const char *name)
  * @param pos
  */
 RexxReturnCode LocalMacroSpaceManager::queryMacro(const char *name, size_t *pos)
+{
+    size_t generation;
+    return queryMacro(name, pos, &generation);
+}
+
+
+/**
+ * Query the existence of a macro, also returning the macrospace
+ * generation the answer was taken from.  The generation changes
+ * whenever any macro is added, removed, or reordered, so callers
+ * can use it to validate anything they have cached from an
+ * earlier query.
+ *
+ * @param name       The name of the target macro.
+ * @param pos        The returned search order position.
+ * @param generation The returned macrospace generation.
+ */
+RexxReturnCode LocalMacroSpaceManager::queryMacro(const char *name, size_t *pos, size_t *generation)
 {
     ClientMessage message(MacroSpaceManager, QUERY_MACRO, name);
     message.send();
     *pos = message.parameter1;
+    *generation = message.parameter3;
     return mapReturnResult(message);
 }
 
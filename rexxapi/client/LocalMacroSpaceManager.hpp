@@ -173,6 +173,7 @@ public:
     RexxReturnCode loadMacroSpace(const char *target, const char **nameList, size_t nameCount);
     RexxReturnCode saveMacroSpace(const char *target);
     RexxReturnCode queryMacro(const char *target, size_t *pos);
+    RexxReturnCode queryMacro(const char *target, size_t *pos, size_t *generation);
     RexxReturnCode reorderMacro(const char *target, size_t pos);
     RexxReturnCode getMacro(const char *target, RXSTRING &image);
     RexxReturnCode saveMacroSpace(const char *target, const char **names, size_t count);
@@ -136,6 +136,19 @@ void LocalQueueManager::terminateProcess()
 }
 
 
+/**
+ * Forget the session queue inherited from the parent in a
+ * forked child.  The parent still owns that queue, so we don't
+ * delete it.  The child will nest or create a queue when it is
+ * reinitialized, just as a freshly started process would.
+ */
+void LocalQueueManager::resetAfterFork()
+{
+    sessionQueue = 0;
+    createdSessionQueue = false;
+}
+
+
 /**
  * Create the session queue for this process.
  *
@@ -458,6 +471,108 @@ RexxReturnCode LocalQueueManager::pullFromQueue(const char *name, RXSTRING &data
 }
 
 
+/**
+ * Add a batch of items to a queue with a single server request.
+ * The items are sent as a sequence of size_t lengths, each followed
+ * by the item data.
+ *
+ * @param name     The queue name, or NULL for the session queue.
+ * @param lines    The items to add.
+ * @param count    The number of items.
+ * @param lifoFifo The lifo/fifo flag, applied to each item in turn.
+ */
+RexxReturnCode LocalQueueManager::addLinesToQueue(const char *name, CONSTRXSTRING *lines, size_t count, size_t lifoFifo)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        length += sizeof(size_t) + lines[i].strlength;
+    }
+
+    ManagedRxstring batch(length);
+    char *cursor = batch.strptr;
+    for (size_t i = 0; i < count; i++)
+    {
+        memcpy(cursor, &lines[i].strlength, sizeof(size_t));
+        cursor += sizeof(size_t);
+        memcpy(cursor, lines[i].strptr, lines[i].strlength);
+        cursor += lines[i].strlength;
+    }
+
+    ClientMessage message(QueueManager, ADD_LINES_TO_NAMED_QUEUE);
+    if (name != NULL)
+    {
+        strcpy(message.nameArg, name);
+    }
+    else
+    {
+        message.operation = ADD_LINES_TO_SESSION_QUEUE;
+        message.parameter3 = sessionQueue;
+    }
+    message.parameter1 = count;
+    message.parameter2 = lifoFifo;
+    message.setMessageData(batch.strptr, length);
+    message.send();
+    return mapReturnResult(message);
+}
+
+
+/**
+ * Pull a block of items from a queue with a single server
+ * request.  This never waits, an empty queue returns
+ * RXQUEUE_EMPTY.  Each returned item is allocated with
+ * RexxAllocateMemory() and must be released by the caller.
+ *
+ * @param name     The queue name, or NULL for the session queue.
+ * @param lines    The array that receives the items.
+ * @param maxLines The size of the lines array.
+ * @param count    The returned number of items.
+ */
+RexxReturnCode LocalQueueManager::pullLinesFromQueue(const char *name, RXSTRING *lines, size_t maxLines, size_t *count)
+{
+    *count = 0;
+    ClientMessage message(QueueManager, PULL_LINES_FROM_NAMED_QUEUE);
+    if (name != NULL)
+    {
+        strcpy(message.nameArg, name);
+    }
+    else
+    {
+        message.operation = PULL_LINES_FROM_SESSION_QUEUE;
+        message.parameter3 = sessionQueue;
+    }
+    message.parameter1 = maxLines;
+    message.send();
+    if (message.result == QUEUE_ITEM_PULLED)
+    {
+        const char *cursor = (const char *)message.getMessageData();
+        size_t returned = (size_t)message.parameter1;
+        for (size_t i = 0; i < returned && i < maxLines; i++)
+        {
+            size_t itemLength;
+            memcpy(&itemLength, cursor, sizeof(size_t));
+            cursor += sizeof(size_t);
+            // always allocate something, so a null string is distinguishable from nothing
+            lines[i].strptr = (char *)RexxAllocateMemory(itemLength + 1);
+            if (lines[i].strptr == NULL)
+            {
+                for (size_t j = 0; j < i; j++)
+                {
+                    RexxFreeMemory(lines[j].strptr);
+                }
+                throw new ServiceException(MEMORY_ERROR, "LocalQueueManager::pullLinesFromQueue() Failure allocating memory");
+            }
+            memcpy(lines[i].strptr, cursor, itemLength);
+            lines[i].strptr[itemLength] = '\0';
+            lines[i].strlength = itemLength;
+            cursor += itemLength;
+        }
+        *count = returned < maxLines ? returned : maxLines;
+    }
+    return mapReturnResult(message);
+}
+
+
 /**
  * Bump the usage count of a session queue when it is
  * inherited from a parent process.
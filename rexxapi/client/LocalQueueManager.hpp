@@ -65,6 +65,7 @@ public:
     bool validateQueueName(const char *username);
     void initializeLocal(LocalAPIManager *a);
     virtual void terminateProcess();
+    void resetAfterFork();
     QueueHandle initializeSessionQueue(SessionID s);
     QueueHandle createSessionQueue(SessionID session);
     RexxReturnCode createNamedQueue(const char *name, size_t size, char *createdName, size_t *dup);
@@ -79,6 +80,8 @@ public:
     RexxReturnCode addToNamedQueue(const char *name, CONSTRXSTRING &data, size_t lifoFifo);
     RexxReturnCode addToSessionQueue(CONSTRXSTRING &data, size_t lifoFifo);
     RexxReturnCode pullFromQueue(const char *name, RXSTRING &data, size_t waitFlag, RexxQueueTime *timeStamp);
+    RexxReturnCode addLinesToQueue(const char *name, CONSTRXSTRING *lines, size_t count, size_t lifoFifo);
+    RexxReturnCode pullLinesFromQueue(const char *name, RXSTRING *lines, size_t maxLines, size_t *count);
     QueueHandle nestSessionQueue(SessionID s, QueueHandle q);
     virtual RexxReturnCode processServiceException(ServiceException *e);
     RexxReturnCode mapReturnResult(ServiceMessage &m);
@@ -230,6 +230,40 @@ RexxReturnCode RexxEntry RexxQueryMacro(
 }
 
 
+/*********************************************************************/
+/*                                                                   */
+/*  Function Name:      RexxQueryMacroGeneration                     */
+/*                                                                   */
+/*  Description:        search for a function in the workspace,      */
+/*                      also returning the macrospace generation     */
+/*                                                                   */
+/*  Entry Point:        RexxQueryMacroGeneration                     */
+/*                                                                   */
+/*  Input:              name - name of function to look for          */
+/*                      pos  - pointer to storage for return of pos  */
+/*                      generation - storage for the generation      */
+/*                                                                   */
+/*  Output:             return code                                  */
+/*                                                                   */
+/*********************************************************************/
+
+RexxReturnCode RexxEntry RexxQueryMacroGeneration(
+    const char     *name,                /* name to search for         */
+    unsigned short *pos,                 /* pointer for return of pos  */
+    size_t         *generation)          /* macrospace generation      */
+{
+    ENTER_REXX_API(MacroSpaceManager)
+    {
+        size_t order = 0;
+
+        RexxReturnCode ret = lam->macroSpaceManager.queryMacro(name, &order, generation);
+        *pos = (unsigned short)order;
+        return ret;
+    }
+    EXIT_REXX_API();
+}
+
+
 /*********************************************************************/
 /*                                                                   */
 /*  Function Name:      RxRecorderMacro                              */
@@ -343,6 +343,93 @@ RexxReturnCode RexxEntry RexxPullFromQueue(
     EXIT_REXX_API();
 }
 
+/*********************************************************************/
+/*                                                                   */
+/*  Function:         RexxAddQueueLines()                            */
+/*                                                                   */
+/*  Description:      Add a batch of entries to a queue.             */
+/*                                                                   */
+/*  Function:         Send all of the entries to the queue data      */
+/*                    manager in a single request.  The result is    */
+/*                    the same as calling RexxAddQueue() for each    */
+/*                    entry in order.                                */
+/*                                                                   */
+/*  Input:            external queue name, array of entries, count   */
+/*                    of entries, LIFO/FIFO flag.                    */
+/*                                                                   */
+/*  Effects:          Entries added to queue.                        */
+/*                                                                   */
+/*********************************************************************/
+RexxReturnCode RexxEntry RexxAddQueueLines(
+  const char *name,
+  PCONSTRXSTRING lines,
+  size_t count,
+  size_t flag)
+{
+    ENTER_REXX_API(QueueManager)
+    {
+                                             /* first check the flag       */
+        if (flag != RXQUEUE_FIFO && flag != RXQUEUE_LIFO)
+        {
+            return RXQUEUE_BADWAITFLAG;
+        }
+        if (count == 0)
+        {
+            return RXQUEUE_OK;
+        }
+        // NULL for the name is the signal to use the session queue.
+        if (lam->queueManager.isSessionQueue(name))
+        {
+            name = NULL;
+        }
+        return lam->queueManager.addLinesToQueue(name, lines, count, flag);
+    }
+    EXIT_REXX_API();
+}
+
+/*********************************************************************/
+/*                                                                   */
+/*  Function:         RexxPullQueueLines()                           */
+/*                                                                   */
+/*  Description:      Pull a block of entries from a queue.          */
+/*                                                                   */
+/*  Function:         Remove up to maxLines entries from the front   */
+/*                    of the queue in a single request.  This never  */
+/*                    waits for data; an empty queue returns         */
+/*                    RXQUEUE_EMPTY.                                 */
+/*                                                                   */
+/*  Notes:            Caller is responsible for freeing the returned */
+/*                    memory for each entry.                         */
+/*                                                                   */
+/*  Input:            external queue name, array for the entries,    */
+/*                    size of the array.                             */
+/*                                                                   */
+/*  Output:           queue entries, count of entries returned.      */
+/*                                                                   */
+/*********************************************************************/
+RexxReturnCode RexxEntry RexxPullQueueLines(
+  const char *name,
+  PRXSTRING lines,
+  size_t maxLines,
+  size_t *count)
+{
+    ENTER_REXX_API(QueueManager)
+    {
+        *count = 0;
+        if (maxLines == 0)
+        {
+            return RXQUEUE_OK;
+        }
+        // NULL for the name is the signal to use the session queue.
+        if (lam->queueManager.isSessionQueue(name))
+        {
+            name = NULL;
+        }
+        return lam->queueManager.pullLinesFromQueue(name, lines, maxLines, count);
+    }
+    EXIT_REXX_API();
+}
+
 /*********************************************************************/
 /*                                                                   */
 /*  Function:        Indicated a process is terminating and should   */
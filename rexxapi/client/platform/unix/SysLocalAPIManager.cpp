@@ -77,12 +77,11 @@ void SysLocalAPIManager::startServerProcess()
 		close(i);
 	}
 
-    // now start rxapi
-    if (execvp(apiExeName, NULL) == -1) {
-        throw new ServiceException(API_FAILURE, "Unable to start API server");
-    }
-
-	return;
+    // now start rxapi.  If that fails, we must not return, otherwise we end up
+    // with a second copy of the calling program running.  The parent will report
+    // the failure when it is unable to connect.
+    execvp(apiExeName, NULL);
+    _exit(-1);
 }
 
 
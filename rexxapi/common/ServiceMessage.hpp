@@ -121,6 +121,10 @@ typedef enum
     CLEAR_NAMED_QUEUE,
     OPEN_NAMED_QUEUE,
     QUERY_NAMED_QUEUE,
+    ADD_LINES_TO_NAMED_QUEUE,
+    ADD_LINES_TO_SESSION_QUEUE,
+    PULL_LINES_FROM_NAMED_QUEUE,
+    PULL_LINES_FROM_SESSION_QUEUE,
 
     // registration manager operations
     REGISTER_LIBRARY,
@@ -198,7 +202,7 @@ typedef enum
 
     OWNER_ONLY,
     DROP_ANY,
-    REXXAPI_VERSION = 100                 // current Rexx api version.
+    REXXAPI_VERSION = 101                 // current Rexx api version.
 }  ServiceMessageParameters;
 
 
@@ -38,6 +38,7 @@
 
 #include "MacroSpaceManager.hpp"
 #include "Utilities.hpp"
+#include <time.h>
 
 /**
  * Create a macro item entry.
@@ -116,6 +117,21 @@ MacroItem *MacroTable::locate(const char *name)
     return NULL;
 }
 
+/**
+ * Create the server macrospace.  Clients cache restored macros
+ * by generation, and those caches outlive a restart of the
+ * server.  The generation therefore starts from the clock rather
+ * than zero, so a new server does not hand out generations that
+ * an earlier one already used.
+ */
+ServerMacroSpaceManager::ServerMacroSpaceManager() : lock(), macros()
+{
+    lock.create();
+    // leave room for about a million changes per second of downtime
+    generation = (size_t)time(NULL) << 20;
+}
+
+
 /**
  * locate and remove a named macro space
  *
@@ -164,6 +180,7 @@ void ServerMacroSpaceManager::addMacro(ServiceMessage &message)
     {
         item->update((const char *)message.getMessageData(), message.getMessageDataLength(), message.parameter2);
     }
+    generation++;
     // we're keeping the storage here, so detach it from the message.
     message.clearMessageData();
     message.setResult(MACRO_ADDED);
@@ -181,6 +198,7 @@ void ServerMacroSpaceManager::deleteMacro(ServiceMessage &message)
     if (item != NULL)
     {
         macros.remove(message.nameArg);
+        generation++;
         message.setResult(MACRO_REMOVED);
     }
     else
@@ -194,6 +212,7 @@ void ServerMacroSpaceManager::deleteMacro(ServiceMessage &message)
 void ServerMacroSpaceManager::clear(ServiceMessage &message)
 {
     macros.clear();
+    generation++;
     message.setResult(MACRO_SPACE_CLEARED);
 }
 
@@ -208,6 +227,7 @@ void ServerMacroSpaceManager::queryMacro(ServiceMessage &message)
     // already exists?
     if (item != NULL)
     {
+        message.parameter1 = item->searchPosition;
         message.setResult((ServiceReturn)item->searchPosition);
     }
     else
@@ -229,6 +249,7 @@ void ServerMacroSpaceManager::reorderMacro(ServiceMessage &message)
     if (item != NULL)
     {
         item->searchPosition = message.parameter1;
+        generation++;
         message.setResult(MACRO_ORDER_CHANGED);
     }
     else
@@ -405,6 +426,9 @@ void ServerMacroSpaceManager::dispatch(ServiceMessage &message)
             message.setExceptionInfo(SERVER_FAILURE, "Invalid macro space manager operation");
             break;
     }
+    // every reply carries the current generation so clients can validate
+    // anything they have cached from earlier replies.
+    message.parameter3 = generation;
 }
 
 void ServerMacroSpaceManager::cleanupProcessResources(SessionID session)
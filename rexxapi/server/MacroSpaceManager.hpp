@@ -157,7 +157,7 @@ public:
     };
 
 
-    ServerMacroSpaceManager() : lock(), macros() { lock.create(); }
+    ServerMacroSpaceManager();
 
     void terminateServer();
     void addMacro(ServiceMessage &message);
@@ -181,6 +181,7 @@ public:
 protected:
     SysMutex     lock;                 // our subsystem lock
     MacroTable   macros;               // all of the manaaged macros.
+    size_t       generation;           // bumped on every change to the macrospace contents
 };
 
 #endif
@@ -120,6 +120,63 @@ void DataQueue::add(ServiceMessage &message)
 }
 
 
+/**
+ * Process a batched queue add operation.  The message data holds
+ * a sequence of lines, each one a size_t length followed by the
+ * line data.
+ *
+ * @param message The service message for the add operation.
+ */
+void DataQueue::addLines(ServiceMessage &message)
+{
+    const char *cursor = (const char *)message.getMessageData();
+    const char *end = cursor + message.getMessageDataLength();
+    size_t count = (size_t)message.parameter1;
+    size_t order = (size_t)message.parameter2;
+    size_t added = 0;
+
+    while (added < count && (size_t)(end - cursor) >= sizeof(size_t))
+    {
+        size_t itemLength;
+        memcpy(&itemLength, cursor, sizeof(size_t));
+        cursor += sizeof(size_t);
+        // a truncated batch is not something the client sends, stop here
+        if (itemLength > (size_t)(end - cursor))
+        {
+            break;
+        }
+        // each item owns its own copy, the message buffer is released
+        // once this request completes.
+        char *itemData = NULL;
+        if (itemLength > 0)
+        {
+            itemData = (char *)ServiceMessage::allocateResultMemory(itemLength);
+            if (itemData == NULL)
+            {
+                message.setExceptionInfo(MEMORY_ERROR, "DataQueue::addLines() Failure allocating queue item");
+                return;
+            }
+            memcpy(itemData, cursor, itemLength);
+            cursor += itemLength;
+        }
+        QueueItem *item = new QueueItem(itemData, itemLength);
+        if (order == QUEUE_LIFO)
+        {
+            addLifo(item);
+        }
+        else
+        {
+            addFifo(item);
+        }
+        added++;
+    }
+    // the items have their own copies, so don't send the batch back
+    message.freeMessageData();
+    message.parameter1 = added;
+    message.setResult(QUEUE_ITEM_ADDED);
+}
+
+
 /**
  * Add an item to a queue in LIFO order.
  *
@@ -227,6 +284,65 @@ bool DataQueue::pullData(ServerQueueManager *manager, ServiceMessage &message)
 }
 
 
+/**
+ * Pull a block of items from the front of the queue without
+ * waiting.  The items are returned in the same length-prefixed
+ * layout used by addLines().  The caller must hold the manager
+ * lock.
+ *
+ * parameter1 -- the most items to return (replaced by the returned count)
+ *
+ * @param message The message being processed.
+ */
+void DataQueue::pullLines(ServiceMessage &message)
+{
+    size_t maxItems = (size_t)message.parameter1;
+
+    // first size up what we're returning.  We always hand back at least
+    // one item, but otherwise keep a single reply to a reasonable size.
+    size_t count = 0;
+    size_t length = 0;
+    for (QueueItem *item = firstItem; item != NULL && count < maxItems; item = item->next)
+    {
+        if (count > 0 && length + sizeof(size_t) + item->size > MaxPullLinesData)
+        {
+            break;
+        }
+        length += sizeof(size_t) + item->size;
+        count++;
+    }
+
+    if (count == 0)
+    {
+        message.parameter1 = 0;
+        message.setResult(QUEUE_EMPTY);
+        return;
+    }
+
+    char *cursor = (char *)message.allocateMessageData(length);
+    if (cursor == NULL)
+    {
+        message.setExceptionInfo(MEMORY_ERROR, "DataQueue::pullLines() Failure allocating result buffer");
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        QueueItem *item = getFirst();
+        memcpy(cursor, &item->size, sizeof(size_t));
+        cursor += sizeof(size_t);
+        if (item->size > 0)
+        {
+            memcpy(cursor, item->elementData, item->size);
+            cursor += item->size;
+        }
+        delete item;
+    }
+    message.parameter1 = count;
+    message.setResult(QUEUE_ITEM_PULLED);
+}
+
+
 /**
  * Pull an item from the front of the queue.
  *
@@ -527,6 +643,67 @@ void ServerQueueManager::pullFromNamedQueue(ServiceMessage &message)
     }
 }
 
+// Add a batch of items to the session queue.  The message arguments have the
+// following meanings:
+//
+// parameter1 -- count of items in the batch.
+// parameter2 -- lifo/fifo flag
+// parameter3 -- handle of the session queue
+void ServerQueueManager::addLinesToSessionQueue(ServiceMessage &message)
+{
+    DataQueue *queue = getSessionQueue((SessionID)message.parameter3);
+    queue->addLines(message);
+}
+
+// Add a batch of items to a named queue.  The message arguments have the
+// following meanings:
+//
+// parameter1 -- count of items in the batch.
+// parameter2 -- lifo/fifo flag
+// nameArg    -- ASCII-Z name of the queue
+void ServerQueueManager::addLinesToNamedQueue(ServiceMessage &message)
+{
+    DataQueue *queue = namedQueues.locate(message.nameArg);
+    if (queue == NULL)
+    {
+        message.freeMessageData();
+        message.setResult(QUEUE_DOES_NOT_EXIST);
+    }
+    else
+    {
+        queue->addLines(message);
+    }
+}
+
+// Pull a block of items from a session queue without waiting.  The message
+// arguments have the following meanings:
+//
+// parameter1 -- the most items to return
+// parameter3 -- session queue handle
+void ServerQueueManager::pullLinesFromSessionQueue(ServiceMessage &message)
+{
+    DataQueue *queue = getSessionQueue((SessionID)message.parameter3);
+    queue->pullLines(message);
+}
+
+// Pull a block of items from a named queue without waiting.  The message
+// arguments have the following meanings:
+//
+// parameter1 -- the most items to return
+// nameArg    -- ASCII-Z name of the queue
+void ServerQueueManager::pullLinesFromNamedQueue(ServiceMessage &message)
+{
+    DataQueue *queue = namedQueues.locate(message.nameArg);
+    if (queue == NULL)
+    {
+        message.setResult(QUEUE_DOES_NOT_EXIST);
+    }
+    else
+    {
+        queue->pullLines(message);
+    }
+}
+
 // locate a session queue from session id.  This will create it, if necessary
 //
 // parameter1 -- caller's session id (replaced by queue handle on return);
@@ -920,6 +1097,18 @@ void ServerQueueManager::dispatch(ServiceMessage &message)
             case ADD_TO_SESSION_QUEUE:
                 addToSessionQueue(message);
                 break;
+            case ADD_LINES_TO_NAMED_QUEUE:
+                addLinesToNamedQueue(message);
+                break;
+            case ADD_LINES_TO_SESSION_QUEUE:
+                addLinesToSessionQueue(message);
+                break;
+            case PULL_LINES_FROM_NAMED_QUEUE:
+                pullLinesFromNamedQueue(message);
+                break;
+            case PULL_LINES_FROM_SESSION_QUEUE:
+                pullLinesFromSessionQueue(message);
+                break;
             default:
                 message.setExceptionInfo(SERVER_FAILURE, "Invalid queue manager operation");
                 break;
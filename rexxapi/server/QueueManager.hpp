@@ -91,6 +91,11 @@ class DataQueue
 {
     friend class QueueTable;
 public:
+    enum
+    {
+        MaxPullLinesData = 1024 * 1024   // upper bound on the data returned by one pullLines()
+    };
+
     DataQueue()
     {
         init();      // do common initilization
@@ -116,6 +121,7 @@ public:
     }
 
     void add(ServiceMessage &message);
+    void addLines(ServiceMessage &message);
     void addLifo(QueueItem *item);
     void addFifo(QueueItem *item);
     void clear();
@@ -153,6 +159,7 @@ public:
 
     void pull(ServerQueueManager *manager, ServiceMessage &message);
     bool pullData(ServerQueueManager *manager, ServiceMessage &message);
+    void pullLines(ServiceMessage &message);
 
     inline void addReference() { references++; }
     inline size_t removeReference() { return --references; }
@@ -248,6 +255,10 @@ public:
     void addToNamedQueue(ServiceMessage &message);
     void pullFromSessionQueue(ServiceMessage &message);
     void pullFromNamedQueue(ServiceMessage &message);
+    void addLinesToSessionQueue(ServiceMessage &message);
+    void addLinesToNamedQueue(ServiceMessage &message);
+    void pullLinesFromSessionQueue(ServiceMessage &message);
+    void pullLinesFromNamedQueue(ServiceMessage &message);
     void createSessionQueue(ServiceMessage &message);
     DataQueue *getSessionQueue(SessionID session);
     void createSessionQueue(SessionID session);
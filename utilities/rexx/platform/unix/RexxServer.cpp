@@ -0,0 +1,630 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/* Copyright (c) 2005-2026 Rexx Language Association. All rights reserved.    */
+/*                                                                            */
+/* This program and the accompanying materials are made available under       */
+/* the terms of the Common Public License v1.0 which accompanies this         */
+/* distribution. A copy is also available at the following address:           */
+/* http://www.oorexx.org/license.html                                         */
+/*                                                                            */
+/* Redistribution and use in source and binary forms, with or                 */
+/* without modification, are permitted provided that the following            */
+/* conditions are met:                                                        */
+/*                                                                            */
+/* Redistributions of source code must retain the above copyright             */
+/* notice, this list of conditions and the following disclaimer.              */
+/* Redistributions in binary form must reproduce the above copyright          */
+/* notice, this list of conditions and the following disclaimer in            */
+/* the documentation and/or other materials provided with the distribution.   */
+/*                                                                            */
+/* Neither the name of Rexx Language Association nor the names                */
+/* of its contributors may be used to endorse or promote products             */
+/* derived from this software without specific prior written permission.      */
+/*                                                                            */
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS        */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT          */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS          */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT   */
+/* OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,      */
+/* SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   */
+/* TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,        */
+/* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY     */
+/* OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING    */
+/* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS         */
+/* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.               */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/******************************************************************************/
+/*                                                                            */
+/*   Resident interpreter server for the unix rexx command                    */
+/*                                                                            */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "RexxServer.hpp"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+extern char **environ;
+
+// marks a launch request in the format this version understands
+const uint32_t RequestMagic = 0x52584C31;      // "RXL1"
+// the most argument and environment data we'll accept in one request
+const uint32_t MaxRequestData = 16 * 1024 * 1024;
+
+// the stdin, stdout, and stderr handles are passed to the server
+#define STDIO_COUNT 3
+
+/**
+ * The fixed part of a launch request.  This is followed by
+ * "length" bytes of null terminated strings:  the working
+ * directory, "argCount" program arguments, then "envCount"
+ * environment entries.  The client's stdio handles travel with
+ * the header as ancillary data.  The reply is the program
+ * return code as an int32_t.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t argCount;
+    uint32_t envCount;
+    uint32_t length;
+} RequestHeader;
+
+
+/**
+ * Fill in a unix domain socket address.
+ *
+ * @param path   The socket file name.
+ * @param addr   The address to fill in.
+ *
+ * @return false if the name is too long to be a socket name.
+ */
+static bool setSocketAddress(const char *path, struct sockaddr_un &addr)
+{
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        return false;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    return true;
+}
+
+
+/**
+ * Write a block of data, riding out partial writes.
+ *
+ * @param sock   The socket to write to.
+ * @param data   The data to write.
+ * @param length The length of the data.
+ *
+ * @return true if everything was written.
+ */
+static bool writeAll(int sock, const void *data, size_t length)
+{
+    const char *cursor = (const char *)data;
+    while (length > 0)
+    {
+        ssize_t written = send(sock, cursor, length, MSG_NOSIGNAL);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        cursor += written;
+        length -= written;
+    }
+    return true;
+}
+
+
+/**
+ * Read a block of data, riding out partial reads.
+ *
+ * @param sock   The socket to read from.
+ * @param data   The buffer for the data.
+ * @param length The length to read.
+ *
+ * @return true if all of the data arrived.
+ */
+static bool readAll(int sock, void *data, size_t length)
+{
+    char *cursor = (char *)data;
+    while (length > 0)
+    {
+        ssize_t bytesRead = recv(sock, cursor, length, 0);
+        if (bytesRead < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytesRead <= 0)
+        {
+            return false;
+        }
+        cursor += bytesRead;
+        length -= bytesRead;
+    }
+    return true;
+}
+
+
+/**
+ * Send the request header along with our stdio handles.
+ *
+ * @param sock   The connection to the server.
+ * @param header The request header.
+ *
+ * @return true if the header was sent.
+ */
+static bool sendHeader(int sock, RequestHeader &header)
+{
+    int fds[STDIO_COUNT] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    union
+    {
+        struct cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(fds))];
+    } control;
+    struct iovec iov;
+    struct msghdr msg;
+
+    memset(&control, 0, sizeof(control));
+    memset(&msg, 0, sizeof(msg));
+    iov.iov_base = &header;
+    iov.iov_len = sizeof(header);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    ssize_t sent;
+    do
+    {
+        sent = sendmsg(sock, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    if (sent < 0)
+    {
+        return false;
+    }
+    // the handles went with the first byte, anything left is plain data
+    return writeAll(sock, (char *)&header + sent, sizeof(header) - sent);
+}
+
+
+/**
+ * Receive a request header and the client's stdio handles.
+ *
+ * @param sock   The client connection.
+ * @param header The returned header.
+ * @param fds    The returned stdio handles.
+ *
+ * @return true if we received a complete header and all of the handles.
+ */
+static bool receiveHeader(int sock, RequestHeader &header, int *fds)
+{
+    union
+    {
+        struct cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(int) * STDIO_COUNT)];
+    } control;
+    struct iovec iov;
+    struct msghdr msg;
+
+    memset(&control, 0, sizeof(control));
+    memset(&msg, 0, sizeof(msg));
+    iov.iov_base = &header;
+    iov.iov_len = sizeof(header);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+
+    ssize_t received;
+    do
+    {
+        received = recvmsg(sock, &msg, 0);
+    } while (received < 0 && errno == EINTR);
+    if (received <= 0)
+    {
+        return false;
+    }
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg == NULL || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+        cmsg->cmsg_len != CMSG_LEN(sizeof(int) * STDIO_COUNT))
+    {
+        return false;
+    }
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * STDIO_COUNT);
+    return readAll(sock, (char *)&header + received, sizeof(header) - received);
+}
+
+
+/**
+ * Check that a connection comes from our own user.  The socket
+ * is created accessible only to the owner, but where the system
+ * lets us ask, we make sure.
+ *
+ * @param sock   The client connection.
+ *
+ * @return true if the client is allowed to run programs here.
+ */
+static bool trustedClient(int sock)
+{
+#if defined(SO_PEERCRED)
+    struct ucred credentials;
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0)
+    {
+        return false;
+    }
+    return credentials.uid == geteuid();
+#else
+    return true;
+#endif
+}
+
+
+/**
+ * Forward a program launch to a resident server, if one has
+ * been configured with the REXX_SERVER environment variable and
+ * is accepting connections.  The server runs the program with our
+ * arguments, environment, current directory, and stdio handles.
+ *
+ * @param argc   The command line argument count.
+ * @param argv   The command line arguments.
+ * @param rc     The returned program return code.
+ *
+ * @return true if the server ran the program, false if we need to run
+ *         it ourselves.
+ */
+bool forwardToServer(int argc, char **argv, int &rc)
+{
+    const char *path = getenv(REXX_SERVER_ENV);
+    struct sockaddr_un addr;
+    char cwd[PATH_MAX];
+
+    if (path == NULL || *path == '\0' || !setSocketAddress(path, addr) || getcwd(cwd, sizeof(cwd)) == NULL)
+    {
+        return false;
+    }
+
+    // size up the request data
+    size_t length = strlen(cwd) + 1;
+    for (int i = 0; i < argc; i++)
+    {
+        length += strlen(argv[i]) + 1;
+    }
+    size_t envCount = 0;
+    for (char **env = environ; *env != NULL; env++)
+    {
+        length += strlen(*env) + 1;
+        envCount++;
+    }
+    if (length > MaxRequestData)
+    {
+        return false;
+    }
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0)
+    {
+        return false;
+    }
+    // no server listening is not an error, we just run the program the slow way
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        close(sock);
+        return false;
+    }
+
+    char *data = (char *)malloc(length);
+    if (data == NULL)
+    {
+        close(sock);
+        return false;
+    }
+    char *cursor = data;
+    strcpy(cursor, cwd);
+    cursor += strlen(cursor) + 1;
+    for (int i = 0; i < argc; i++)
+    {
+        strcpy(cursor, argv[i]);
+        cursor += strlen(cursor) + 1;
+    }
+    for (char **env = environ; *env != NULL; env++)
+    {
+        strcpy(cursor, *env);
+        cursor += strlen(cursor) + 1;
+    }
+
+    RequestHeader header;
+    header.magic = RequestMagic;
+    header.argCount = (uint32_t)argc;
+    header.envCount = (uint32_t)envCount;
+    header.length = (uint32_t)length;
+
+    // if the server won't take the request, nothing has run yet, so we can still do it here
+    if (!sendHeader(sock, header) || !writeAll(sock, data, length))
+    {
+        free(data);
+        close(sock);
+        return false;
+    }
+    free(data);
+
+    int32_t reply;
+    // the program is running now, so a dropped connection can't be retried
+    if (!readAll(sock, &reply, sizeof(reply)))
+    {
+        fprintf(stderr, "rexx: lost connection to server %s\n", path);
+        reply = -1;
+    }
+    close(sock);
+    rc = (int)reply;
+    return true;
+}
+
+
+// set when the server is asked to shut down
+static volatile sig_atomic_t stopRequested = 0;
+
+/**
+ * Signal handler for SIGTERM/SIGINT while the server is idle in
+ * accept().  The interpreter's own handlers only halt running
+ * activities, and the server has none, so they would leave it
+ * running forever.
+ *
+ * @param sig    The signal number.
+ */
+static void stopServer(int sig)
+{
+    stopRequested = 1;
+}
+
+
+/**
+ * Run a single launch request in a forked copy of the server.
+ * We take on the client's stdio handles, working directory, and
+ * environment, run the program on the already initialized
+ * interpreter instance, and send back the return code.
+ *
+ * @param sock    The client connection.
+ * @param pgmInst The interpreter instance.
+ * @param pgmThrdInst
+ *                The instance thread context.
+ *
+ * @return The program return code.
+ */
+static int serveRequest(int sock, RexxInstance *pgmInst, RexxThreadContext *pgmThrdInst)
+{
+    RequestHeader header;
+    int fds[STDIO_COUNT];
+
+    if (!receiveHeader(sock, header, fds))
+    {
+        return -1;
+    }
+    if (header.magic != RequestMagic || header.argCount == 0 || header.length > MaxRequestData ||
+        header.argCount > MaxRequestData || header.envCount > MaxRequestData)
+    {
+        return -1;
+    }
+
+    // the null guard at the end keeps a malformed request from running off the end
+    char *data = (char *)malloc(header.length + 1);
+    size_t stringCount = 1 + header.argCount + header.envCount;
+    char **strings = (char **)malloc((stringCount + 1) * sizeof(char *));
+    if (data == NULL || strings == NULL || !readAll(sock, data, header.length))
+    {
+        return -1;
+    }
+    data[header.length] = '\0';
+
+    char *cursor = data;
+    char *end = data + header.length;
+    for (size_t i = 0; i < stringCount; i++)
+    {
+        if (cursor >= end)
+        {
+            return -1;
+        }
+        strings[i] = cursor;
+        cursor += strlen(cursor) + 1;
+    }
+    strings[stringCount] = NULL;
+
+    for (int i = 0; i < STDIO_COUNT; i++)
+    {
+        if (fds[i] != i)
+        {
+            dup2(fds[i], i);
+            close(fds[i]);
+        }
+    }
+    if (chdir(strings[0]) != 0)
+    {
+        fprintf(stderr, "rexx: unable to change to directory %s\n", strings[0]);
+        return -1;
+    }
+    // the environment strings live in our request buffer for the rest of the process
+    environ = strings + 1 + header.argCount;
+
+    int32_t rc = runProgram((int)header.argCount, strings + 1, pgmInst, pgmThrdInst);
+
+    fflush(NULL);
+    writeAll(sock, &rc, sizeof(rc));
+    return rc;
+}
+
+
+/**
+ * Run as a resident server.  We create an interpreter instance,
+ * load any requested packages into it, then listen on a unix
+ * domain socket for launch requests from "rexx" commands run
+ * with REXX_SERVER pointing at the socket.  Each request is run
+ * in a forked copy of the warm instance, so programs start
+ * without the cost of interpreter startup and never see each
+ * other's state.
+ *
+ * @param argc   The command line argument count.
+ * @param argv   The command line arguments ("rexx -server socket [package ...]").
+ *
+ * @return A return code if we're unable to run the server.
+ */
+int runServer(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Syntax is \"rexx -server socket [package ...]\"\n");
+        return -1;
+    }
+
+    const char *path = argv[2];
+    struct sockaddr_un addr;
+    if (!setSocketAddress(path, addr))
+    {
+        fprintf(stderr, "rexx: server socket name is too long: %s\n", path);
+        return -1;
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+    {
+        fprintf(stderr, "rexx: unable to create server socket: %s\n", strerror(errno));
+        return -1;
+    }
+    // a socket file left behind by a dead server can be replaced, a live one cannot
+    if (connect(listener, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+    {
+        fprintf(stderr, "rexx: a server is already listening on %s\n", path);
+        close(listener);
+        return -1;
+    }
+    close(listener);
+    unlink(path);
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    // only our own user gets to run programs through the server
+    mode_t oldMask = umask(077);
+    int bound = listener < 0 ? -1 : bind(listener, (struct sockaddr *)&addr, sizeof(addr));
+    umask(oldMask);
+    if (bound != 0 || listen(listener, SOMAXCONN) != 0)
+    {
+        fprintf(stderr, "rexx: unable to listen on %s: %s\n", path, strerror(errno));
+        if (listener >= 0)
+        {
+            close(listener);
+        }
+        return -1;
+    }
+
+    RexxInstance *pgmInst;
+    RexxThreadContext *pgmThrdInst;
+    if (!RexxCreateInterpreter(&pgmInst, &pgmThrdInst, NULL))
+    {
+        fprintf(stderr, "rexx: unable to create an interpreter instance\n");
+        close(listener);
+        unlink(path);
+        return -1;
+    }
+
+    // packages loaded now are resolved from the instance for ::requires in every program
+    for (int i = 3; i < argc; i++)
+    {
+        if (pgmThrdInst->LoadPackage(argv[i]) == NULLOBJECT)
+        {
+            int rc = (int)pgmThrdInst->DisplayCondition();
+            pgmInst->Terminate();
+            close(listener);
+            unlink(path);
+            return rc != 0 ? -rc : -1;
+        }
+    }
+
+    // the forked children reap themselves, and a client going away mid-reply
+    // should not take the server with it
+    signal(SIGCHLD, SIG_IGN);
+    void (*oldPipeHandler)(int) = signal(SIGPIPE, SIG_IGN);
+    // no SA_RESTART, so a stop request breaks us out of accept()
+    struct sigaction stopAction;
+    struct sigaction oldTermAction;
+    struct sigaction oldIntAction;
+    memset(&stopAction, 0, sizeof(stopAction));
+    stopAction.sa_handler = stopServer;
+    sigemptyset(&stopAction.sa_mask);
+    sigaction(SIGTERM, &stopAction, &oldTermAction);
+    sigaction(SIGINT, &stopAction, &oldIntAction);
+    // nothing buffered here may be written a second time by a child
+    fflush(NULL);
+
+    while (!stopRequested)
+    {
+        int client = accept(listener, NULL, NULL);
+        if (client < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            fprintf(stderr, "rexx: server stopped: %s\n", strerror(errno));
+            break;
+        }
+        if (!trustedClient(client))
+        {
+            close(client);
+            continue;
+        }
+
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(listener);
+            signal(SIGCHLD, SIG_DFL);
+            signal(SIGPIPE, oldPipeHandler);
+            // programs get the interpreter's usual halt handling back
+            sigaction(SIGTERM, &oldTermAction, NULL);
+            sigaction(SIGINT, &oldIntAction, NULL);
+            int rc = serveRequest(client, pgmInst, pgmThrdInst);
+            // exit() would run the server's atexit handlers and stdio
+            // cleanup a second time in this copy, so flush our own
+            // output and leave directly
+            fflush(NULL);
+            _exit(rc);
+        }
+        if (pid < 0)
+        {
+            fprintf(stderr, "rexx: unable to start a server process: %s\n", strerror(errno));
+        }
+        close(client);
+    }
+
+    pgmInst->Terminate();
+    close(listener);
+    unlink(path);
+    return stopRequested ? 0 : -1;
+}
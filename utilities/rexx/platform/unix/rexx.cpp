@@ -45,6 +45,7 @@
 #include <string.h>
 
 #include "oorexxapi.h"
+#include "RexxServer.hpp"
 
 #if defined(AIX)
 #define SYSINITIALADDRESS "ksh"
@@ -54,7 +55,20 @@
 #define SYSINITIALADDRESS "bash"
 #endif
 
-int main (int argc, char **argv) {
+/**
+ * Run a program using the rexx command line conventions.
+ *
+ * @param argc    The count of command line arguments.
+ * @param argv    The command line arguments.
+ * @param pgmInst An already created interpreter instance to run the
+ *                program on, or NULL to create a new one.
+ * @param pgmThrdInst
+ *                The thread context that goes with pgmInst.
+ *
+ * @return The program return code.
+ */
+int runProgram(int argc, char **argv, RexxInstance *pgmInst, RexxThreadContext *pgmThrdInst)
+{
     int   i;                             /* loop counter                      */
     int   rc = 0;                        /* actually running program RC       */
     const char *program_name = NULL;     /* name to run                       */
@@ -68,8 +82,6 @@ int main (int argc, char **argv) {
     bool real_argument = true;           /* running from command line string? */
     RXSTRING instore[2];
 
-    RexxInstance        *pgmInst;
-    RexxThreadContext   *pgmThrdInst;
     RexxArrayObject      rxargs, rxcargs;
     RexxDirectoryObject  dir;
     RexxObjectPtr        result;
@@ -120,6 +132,7 @@ int main (int argc, char **argv) {
         fprintf(stderr,"\n");
         fprintf(stderr,"Syntax is \"rexx filename [arguments]\"\n");
         fprintf(stderr,"or        \"rexx -e program_string [arguments]\"\n");
+        fprintf(stderr,"or        \"rexx -server socket [package ...]\"\n");
         fprintf(stderr,"or        \"rexx -v\".\n");
         return -1;
     }
@@ -141,7 +154,11 @@ int main (int argc, char **argv) {
                        NULL);            /* REXX program output    */
     }
     else {
-        RexxCreateInterpreter(&pgmInst, &pgmThrdInst, NULL);
+        // the server hands us a warm instance, otherwise we need our own
+        if (pgmInst == NULL)
+        {
+            RexxCreateInterpreter(&pgmInst, &pgmThrdInst, NULL);
+        }
         // configure the traditional single argument string
         if (argCount > 0) {
             rxargs = pgmThrdInst->NewArray(1);
@@ -187,3 +204,20 @@ int main (int argc, char **argv) {
 
 }
 
+
+int main (int argc, char **argv) {
+    int rc = 0;
+
+    // "rexx -server socket [package...]" runs as a resident server
+    if (argc > 1 && strcmp(argv[1], "-server") == 0)
+    {
+        return runServer(argc, argv);
+    }
+    // if a server has been configured and is listening, let it run this for us
+    if (forwardToServer(argc, argv, rc))
+    {
+        return rc;
+    }
+    return runProgram(argc, argv, NULL, NULL);
+}
+
@@ -132,16 +132,37 @@ void DisplayError(int msgid)           /* simplified catalog access@MAE004M */
 int main (int argc, char **argv)
 {
     bool silent = false;
-    int silentp;
+    bool bundle = false;
+    bool badOption = false;
+    const char *fileNames[2] = { NULL, NULL };
+    int nameCount = 0;
     char *ptr;
-    /* check for /s option               */
-    for (silentp = 1; silentp < argc; silentp++)
+    /* sort out the options and names    */
+    for (int i = 1; i < argc; i++)
     {
-        if (argv[silentp][0] == '-' &&
-            (argv[silentp][1] == 's' || argv[silentp][1] == 'S'))
+        if (argv[i][0] == '-')
         {
-            silent = true;
-            break;
+            if ((argv[i][1] == 's' || argv[i][1] == 'S') && argv[i][2] == '\0')
+            {
+                silent = true;
+            }
+            /* -b bundles the ::requires files   */
+            else if ((argv[i][1] == 'b' || argv[i][1] == 'B') && argv[i][2] == '\0')
+            {
+                bundle = true;
+            }
+            else
+            {
+                badOption = true;
+            }
+        }
+        else if (nameCount < 2)
+        {
+            fileNames[nameCount++] = argv[i];
+        }
+        else
+        {
+            badOption = true;
         }
     }
     if (!silent)                       /* display version and copyright     */
@@ -152,10 +173,8 @@ int main (int argc, char **argv)
         RexxFreeMemory(ptr);
     }
     /* Check validity of arguments       */
-    if (argc < 2 || argc > 4 ||          /* # args exceeding bounds           */
-        (silent && argc==2) ||             /* -s is the first argument          */
-        (silent && (silentp + 1 < argc)) ||  /* -s is not the last argument       */
-        (!silent && argc==4))           /* 3 arguments, but no /s            */
+    if (nameCount == 0 || badOption ||   /* no program or unknown arguments   */
+        (bundle && nameCount < 2))       /* nothing to bundle into            */
     {
         if (argc > 2)
         {
@@ -165,19 +184,22 @@ int main (int argc, char **argv)
         DisplayError((int) Error_REXXC_SynCheckInfo_msg);
         exit(-1);                          /* terminate with an error           */
     }                                    /* end additions                     */
-    /* modified control logic            */
-    if ((argc==4 && silent) || (argc==3 && !silent))
+    if (nameCount == 2)
     {
-        if (strcmp(argv[1], argv[2]) == 0)
+        if (strcmp(fileNames[0], fileNames[1]) == 0)
         {
             DisplayError((int)Error_REXXC_outDifferent_msg);
             exit(-2);                        /* terminate with an error           */
         }
         /* translate and save the output     */
-        return RexxTranslateProgram(argv[1], argv[2], NULL);
+        if (bundle)
+        {
+            return RexxTranslateBundledProgram(fileNames[0], fileNames[1], NULL);
+        }
+        return RexxTranslateProgram(fileNames[0], fileNames[1], NULL);
     }
     else                                 /* just doing syntax check           */
     {
-        return RexxTranslateProgram(argv[1], NULL, NULL);
+        return RexxTranslateProgram(fileNames[0], NULL, NULL);
     }
 }
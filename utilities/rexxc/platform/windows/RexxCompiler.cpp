@@ -67,7 +67,11 @@ void DisplayError(HINSTANCE hDll, int err_no)
 int SysCall main(int argc, char **argv)
 {
   char fn[2][BUFFERLEN];
+  const char *names[2] = { NULL, NULL };
+  int  nameCount = 0;
   int  silent = 0;
+  int  bundle = 0;
+  int  badOption = 0;
   int  j = 0;
 
   HINSTANCE hDll=NULL;
@@ -76,8 +80,15 @@ int SysCall main(int argc, char **argv)
 
   for (j=1; j<argc; j++)
   {
-      if (((argv[j][0] == '/') || (argv[j][0] == '-'))
-      && ((argv[j][1] == 's') || (argv[j][1] == 'S'))) silent = j;
+      if ((argv[j][0] == '/') || (argv[j][0] == '-'))
+      {
+          if (((argv[j][1] == 's') || (argv[j][1] == 'S')) && argv[j][2] == '\0') silent = j;
+          /* /b bundles the ::requires files */
+          else if (((argv[j][1] == 'b') || (argv[j][1] == 'B')) && argv[j][2] == '\0') bundle = j;
+          else badOption = j;
+      }
+      else if (nameCount < 2) names[nameCount++] = argv[j];
+      else badOption = j;
   }
   if (!silent)
   {
@@ -89,11 +100,9 @@ int SysCall main(int argc, char **argv)
       }
   }
 
-  /* check arguments: at least 1 argument, max. 2, /s must be last */
-  if ((argc < 2) || (argc > 4) ||           /* invalid no. of args */
-      (silent && (argc == 2)) ||            /* only /s             */
-      (silent && (silent+1 != argc)) ||     /* /s not last arg     */
-      (!silent && (argc == 4)))             /* 3 args, no /s       */
+  /* check arguments: at least 1 name, max. 2, /b needs an output name */
+  if ((nameCount == 0) || badOption ||      /* no program, bad args */
+      (bundle && (nameCount < 2)))          /* nothing to bundle to */
   {
       if (argc > 2) {
       DisplayError(hDll, Error_REXXC_cmd_parm_incorrect);
@@ -104,11 +113,11 @@ int SysCall main(int argc, char **argv)
       exit(-1);
   }
 
-  strcpy(fn[0], argv[1]);
-  if (argc >= 3) strcpy(fn[1], argv[2]);
+  strcpy(fn[0], names[0]);
+  if (nameCount == 2) strcpy(fn[1], names[1]);
 
-  if ( ((argc>3) || ((argc==3) && !silent)) &&
-       (strcmp(strupr(fn[0]), strupr(fn[1])) == 0))
+  if ((nameCount == 2) &&
+      (strcmp(strupr(fn[0]), strupr(fn[1])) == 0))
   {
       DisplayError(hDll, Error_REXXC_outDifferent);
       if (hDll) FreeLibrary(hDll);
@@ -117,9 +126,11 @@ int SysCall main(int argc, char **argv)
 
   if (hDll) FreeLibrary(hDll);
 
-  if ((argc == 2) || ((argc==3) && silent) )  /* just doing a syntax check? */
+  if (nameCount == 1)                  /* just doing a syntax check?        */
                                        /* go perform the translation        */
-    return RexxTranslateProgram(argv[1], NULL, NULL);
+    return RexxTranslateProgram(names[0], NULL, NULL);
+  else if (bundle)                     /* translate with the ::requires     */
+    return RexxTranslateBundledProgram(names[0], names[1], NULL);
   else                                 /* translate and save the output     */
-    return RexxTranslateProgram(argv[1], argv[2], NULL);
+    return RexxTranslateProgram(names[0], names[1], NULL);
 }
@@ -44,7 +44,7 @@
 /*                    stream and the queueing services provided with */
 /*                    with REXX-SAA/PL                               */
 /*                                                                   */
-/*  Usage:            RXQUEUE [ [ [/FIFO] [/LIFO] [/CLEAR] ]         */
+/*  Usage:            RXQUEUE [ [ [/FIFO] [/LIFO] [/CLEAR] [/DRAIN] ]*/
 /*                    [queuename] ]                                  */
 /*                                                                   */
 /*********************************************************************/
@@ -68,10 +68,15 @@
 #include "RexxMessageNumbers.h"
 
 #define RXQUEUE_CLEAR    -2    /* used for queue mode CLEAR flag     */
+#define RXQUEUE_DRAIN    -3    /* used for queue mode DRAIN flag     */
 #define BAD_MESSAGE      -6    /* Exit RC for message not found.     */
 
 #define MSG_BUF_SIZE    256    /* Error message buffer size          */
 #define LINEBUFSIZE   65472    /* Arbitrary but matches current docs */
+#define READBUFSIZE   65536    /* size of a stdin block read         */
+#define BATCHLINES      512    /* most lines sent in one queue add   */
+#define BATCHDATASIZE (256 * 1024) /* most line data in one queue add */
+#define PULLLINES       512    /* most lines pulled in one request   */
 
 #define REXXMESSAGEFILE    "rexx.cat"
 
@@ -83,10 +88,17 @@ char  line[LINEBUFSIZE];       /* buffer for data to add to queue    */
 char  work[256];               /* buffer for queue name, if default  */
 int   queuemode=-1;            /* mode for access to queue           */
 
+char  inbuf[READBUFSIZE];      /* block read from stdin              */
+char  batchdata[BATCHDATASIZE];/* line data waiting to be queued     */
+CONSTRXSTRING batchlines[BATCHLINES]; /* lines waiting to be queued  */
+size_t batchcount = 0;         /* number of lines in the batch       */
+size_t batchused = 0;          /* bytes of batchdata in use          */
+
 void  options_error(int type, const char *queuename ) ;
 
-                               /* function to read stdin             */
-size_t get_line(char *, size_t, size_t *);
+                               /* functions to move lines            */
+void  queue_lines(const char *quename);
+void  drain_queue(const char *quename);
 
 
 int main(
@@ -97,8 +109,6 @@ int main(
     int       rc;                /* return code from API calls         */
     size_t    entries;           /* number of entries in queue         */
     const char *quename=NULL;    /* initialize queuename to NULL       */
-    size_t    linelen ;          /* input line length                  */
-    CONSTRXSTRING  queuedata;    /* data added to the queue            */
     char *t;                     /* argument pointer                   */
 
 
@@ -136,6 +146,11 @@ int main(
             {
                 queuemode=RXQUEUE_CLEAR;/*   set queue for CLEAR, otherwise  */
             }
+            else if ( !strcasecmp(t,"/DRAIN") &&  /* if DRAIN flag and       */
+                      queuemode==-1)  /*   no queuemode selected yet, then  */
+            {
+                queuemode=RXQUEUE_DRAIN;/*   set queue for DRAIN, otherwise  */
+            }
             else
             {
                 options_error(      /*  there was an error in invokation */
@@ -186,32 +201,22 @@ int main(
 
 /*********************************************************************/
 /*  Get all input data and write each line to the proper queue       */
-/*  (not CLEAR):                                                     */
+/*  (not CLEAR or DRAIN):                                            */
 /*********************************************************************/
 
-    if (queuemode != RXQUEUE_CLEAR)
-    {     /* if not CLEAR operation...  */
-        while (!get_line( line,             /* while more data passed in: */
-                          sizeof( line ),
-                          &linelen))
-        {                                  /* express in RXSTRING form   */
-            MAKERXSTRING(queuedata, line, linelen);
-            if ((rc=RexxAddQueue(              /*   write info to the queue  */
-                                               quename,       /*     queue to write into    */
-                                               &queuedata,    /*information to add to queue */
-                                               queuemode)))   /* size of information to add */
-            {
-                                                              /* FIFO || LIFO mode          */
-                options_error( rc,             /* generate error if API fails*/
-                               quename ) ;
-            }
-        }
-    }
-    else
+    if (queuemode == RXQUEUE_CLEAR)
     {
         // clearing is easy
         RexxClearQueue(quename);
     }
+    else if (queuemode == RXQUEUE_DRAIN)
+    {
+        drain_queue(quename);
+    }
+    else
+    {
+        queue_lines(quename);
+    }
     exit(0);
 }
 
@@ -367,113 +372,213 @@ void options_error( int   type,        /* Error type.                */
 
 
 /*********************************************************************/
-/* Function:           Read a line from stdin into a buffer          */
-/*                                                                   */
-/* Description:        Read a line from stdin using DosRead into     */
-/*                     the supplied buffer.  If the line is longer   */
-/*                     than the buffer, then it will be truncated    */
-/*                     and the remainder of the line thrown away.    */
+/* Function:           Send the pending batch of lines to the queue. */
 /*                                                                   */
-/* Inputs:             Buffer and size of buffer.                    */
+/* Description:        All of the lines collected since the last     */
+/*                     flush are added with a single queue request.  */
 /*                                                                   */
-/* Outputs:            Success/failure flage,                        */
-/*                     plus number of bytes read.                    */
+/* Inputs:             Queue name.                                   */
 /*                                                                   */
-/* Side effects:       Logical line read from stdin.                 */
+/* Outputs:            Nothing.  Exits via options_error on failure. */
 /*                                                                   */
 /*********************************************************************/
 
-size_t      get_line( char  *buffer,   /* Read buffer                */
-                      size_t bufsize,  /* Buffer size                */
-                      size_t *linelen) /* length of line             */
+void flush_lines(const char *quename)
 {
-    static char savechar = '\0';         /* cached character           */
-    static bool eof = false;             /* not hit eof yet            */
-    size_t actual;                       /* actual bytes read          */
-    char  newchar;                       /* character read             */
-    size_t length;                       /* length read                */
+    int rc;                              /* return code from API       */
 
-    if (eof)                             /* already hit end?           */
+    if (batchcount == 0)                 /* nothing pending?           */
     {
-        return true;                       /* all done                   */
+        return;
     }
+    if ((rc = RexxAddQueueLines(quename, batchlines, batchcount, queuemode)))
+    {
+        options_error(rc, quename);      /* generate error if API fails*/
+    }
+    batchcount = 0;
+    batchused = 0;
+}
 
-    length = 0;                          /* nothing read yet           */
-    if (savechar)
-    {                      /* have a saved character     */
-        *buffer++ = savechar;              /* save this                  */
-        length++;                          /* add to count               */
-        savechar = '\0';                   /* zap for next time          */
+
+/*********************************************************************/
+/* Function:           Add a line to the pending batch.              */
+/*                                                                   */
+/* Description:        Copy a line into the batch buffer, flushing   */
+/*                     the batch first if it is full.                */
+/*                                                                   */
+/* Inputs:             Queue name, line data and length.             */
+/*                                                                   */
+/*********************************************************************/
+
+void add_line(const char *quename, const char *data, size_t length)
+{
+    if (batchcount == BATCHLINES || batchused + length > BATCHDATASIZE)
+    {
+        flush_lines(quename);
     }
-    /* read first character       */
-    actual =  fread(&newchar, 1, 1, stdin);
-    while (!ferror(stdin))
-    {             /* while no error             */
-        if (!actual)
-        {                     /* EOF?                       */
-            *linelen = length;               /* set length                 */
-            if (!length)                     /* nothing read?              */
-            {
-                return true;                   /* raise end of file          */
-            }
-            else
-            {
-                eof = true;                    /* quick out next time        */
-                return false;                  /* have real line here        */
-            }
+    memcpy(batchdata + batchused, data, length);
+    MAKERXSTRING(batchlines[batchcount], batchdata + batchused, length);
+    batchused += length;
+    batchcount++;
+}
+
+
+/*********************************************************************/
+/* Function:           Locate the next line delimiter in a block.    */
+/*                                                                   */
+/* Description:        Lines end at a CR, an LF, or the 0x1a EOF     */
+/*                     character.  Each delimiter is located with    */
+/*                     memchr, and the positions are remembered      */
+/*                     until the scan moves past them, so a block is */
+/*                     only scanned once per delimiter no matter how */
+/*                     the line endings are mixed.                   */
+/*                                                                   */
+/* Inputs:             Scan position, end of block, cached delimiter */
+/*                     positions (NULL when none remain).            */
+/*                                                                   */
+/* Outputs:            The nearest delimiter, or NULL.               */
+/*                                                                   */
+/*********************************************************************/
+
+static const char delimiters[3] = { '\n', '\r', 0x1a };
+
+static const char *next_delimiter(const char *cursor, const char *end, const char **next)
+{
+    const char *nearest = NULL;
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (next[i] != NULL && next[i] < cursor)
+        {
+            next[i] = (const char *)memchr(cursor, delimiters[i], end - cursor);
         }
-        if (newchar == '\r')
-        {             /* end of line                */
-            *linelen = length;               /* passback length read       */
-                                             /* read next character        */
-            actual = fread(&newchar, 1, 1, stdin);
-            /* newline char?              */
-            if (!ferror(stdin) && actual && newchar != '\n')
-            {
-                savechar = newchar;            /* save this for next time    */
-            }
-            return false;                    /* should be ok this time     */
+        if (next[i] != NULL && (nearest == NULL || next[i] < nearest))
+        {
+            nearest = next[i];
+        }
+    }
+    return nearest;
+}
+
+
+/*********************************************************************/
+/* Function:           Copy stdin to a queue.                        */
+/*                                                                   */
+/* Description:        Read stdin in blocks, split the blocks into   */
+/*                     lines, and add the lines to the queue in      */
+/*                     batches.  A line longer than the line buffer  */
+/*                     is truncated and the remainder thrown away.   */
+/*                     A CR LF pair ends a single line, and the EOF  */
+/*                     character ends the input.                     */
+/*                                                                   */
+/* Inputs:             Queue name.                                   */
+/*                                                                   */
+/*********************************************************************/
+
+void queue_lines(const char *quename)
+{
+    size_t linelen = 0;                  /* partial line carried over  */
+    bool   skipnewline = false;          /* CR ended the last block    */
+    size_t actual;                       /* bytes in this block        */
+
+    while ((actual = fread(inbuf, 1, sizeof(inbuf), stdin)) > 0)
+    {
+        const char *cursor = inbuf;
+        const char *end = inbuf + actual;
+        const char *next[3];             /* next of each delimiter     */
+
+        for (int i = 0; i < 3; i++)
+        {
+            next[i] = (const char *)memchr(inbuf, delimiters[i], actual);
         }
-        else if (newchar == '\n')
-        {        /* end of line                */
-            *linelen = length;               /* passback length read       */
-            return false;                    /* should be ok this time     */
+
+        if (skipnewline && *cursor == '\n')
+        {
+            cursor++;                    /* LF of a split CR LF pair   */
         }
-        else if (newchar == 0x1a)
-        {        /* EOF character?             */
-            *linelen = length;               /* give length                */
-            eof = true;                      /* set flag for next time     */
-            if (length)                      /* if something read          */
+        skipnewline = false;
+
+        while (cursor < end)
+        {
+            const char *eol = next_delimiter(cursor, end, next);
+            size_t chunk = (eol != NULL ? eol : end) - cursor;
+
+            // a complete line within the block goes straight to the batch
+            if (eol != NULL && linelen == 0)
             {
-                return true;                   /* this is EOF now            */
+                add_line(quename, cursor, chunk < sizeof(line) ? chunk : sizeof(line));
             }
             else
             {
-                return false;               /* no error yet               */
+                // otherwise collect it until we see the end
+                size_t room = sizeof(line) - linelen;
+                memcpy(line + linelen, cursor, chunk < room ? chunk : room);
+                linelen += chunk < room ? chunk : room;
+                if (eol == NULL)
+                {
+                    break;               /* line continues next block  */
+                }
+                add_line(quename, line, linelen);
+                linelen = 0;
             }
-        }
-        else
-        {                             /* real character             */
-            if (length < bufsize)
-            {          /* room for this?             */
-                length++;                      /* remember it                */
-                *buffer++ = newchar;           /* copy over character        */
+
+            cursor = eol + 1;
+            if (*eol == 0x1a)            /* EOF character ends input   */
+            {
+                flush_lines(quename);
+                return;
+            }
+            if (*eol == '\r')
+            {
+                if (cursor == end)
+                {
+                    skipnewline = true;  /* LF may start the next block*/
+                }
+                else if (*cursor == '\n')
+                {
+                    cursor++;
+                }
             }
         }
-        /* read next character        */
-        actual = fread(&newchar, 1, 1, stdin);
     }
-    /* had an error               */
-    if (length)
-    {                        /* something read?            */
-        *linelen = length;                 /* return this                */
-        eof = true;                        /* can't read more            */
-        return false;                      /* but no error yet           */
-    }
-    else
+    if (linelen > 0)                     /* unterminated last line     */
     {
-        return true;                       /* treat this as an EOF       */
+        add_line(quename, line, linelen);
     }
+    flush_lines(quename);
 }
 
 
+/*********************************************************************/
+/* Function:           Copy a queue to stdout.                       */
+/*                                                                   */
+/* Description:        Pull the queue contents in blocks and write   */
+/*                     each entry to stdout as a line.  This stops   */
+/*                     when the queue is empty.                      */
+/*                                                                   */
+/* Inputs:             Queue name.                                   */
+/*                                                                   */
+/*********************************************************************/
+
+void drain_queue(const char *quename)
+{
+    RXSTRING lines[PULLLINES];           /* entries pulled             */
+    size_t   count;                      /* number pulled              */
+    int      rc;                         /* return code from API       */
+
+    setvbuf(stdout, NULL, _IOFBF, READBUFSIZE);
+    while ((rc = RexxPullQueueLines(quename, lines, PULLLINES, &count)) == RXQUEUE_OK)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            fwrite(lines[i].strptr, 1, lines[i].strlength, stdout);
+            fputc('\n', stdout);
+            RexxFreeMemory(lines[i].strptr);
+        }
+    }
+    fflush(stdout);
+    if (rc != RXQUEUE_EMPTY)
+    {
+        options_error(rc, quename);      /* generate error if API fails*/
+    }
+}